@@ -0,0 +1,84 @@
+/*
+ * CachingIncludeHandler.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_CACHING_INCLUDE_HANDLER_H
+#define XSC_CACHING_INCLUDE_HANDLER_H
+
+
+#include "IncludeHandler.h"
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/* ===== Public classes ===== */
+
+/**
+\brief Include handler which keeps the content of all included files in memory.
+\remarks This include handler caches the content of each included file, the resolved path of each include filename,
+and the include filenames that could not be found in any search path (negative lookups).
+Each cached file is validated by its modification time and size before it is served again,
+i.e. only the file status is queried instead of reading the file, and a modified file is read again.
+The cached content is passed to the compiler without copying it.
+\remarks This include handler can be shared by multiple threads and compiler sessions at the same time,
+e.g. as 'includeHandler' of all jobs for the 'CompileShadersParallel' function.
+The search paths must not be changed while another thread is including a file; changing them invalidates the entire cache.
+\see ShaderInput::includeHandler
+*/
+class XSC_EXPORT CachingIncludeHandler : public IncludeHandler
+{
+
+    public:
+
+        CachingIncludeHandler();
+        ~CachingIncludeHandler();
+
+        CachingIncludeHandler(const CachingIncludeHandler&) = delete;
+        CachingIncludeHandler& operator = (const CachingIncludeHandler&) = delete;
+
+        /**
+        \brief Returns an input stream for the cached content of the specified filename.
+        \remarks The file is only read if it is not cached yet, or if its modification time or size has changed.
+        \throws std::runtime_error If the file could not be found in any search path, which is cached as well.
+        \see IncludeHandler::Include
+        */
+        std::unique_ptr<std::istream> Include(const std::string& filename, bool useSearchPathsFirst) override;
+
+        //! Returns true, since this include handler can be used by multiple threads at the same time.
+        bool IsThreadSafe() const override;
+
+        /**
+        \brief Clears the entire cache.
+        \remarks Modified files are detected automatically, but files that have been added after a failed lookup are only found after the cache has been cleared.
+        */
+        void Clear();
+
+        //! Returns the number of includes that have been served from the cache without reading the file.
+        std::size_t NumCacheHits() const;
+
+        //! Returns the number of includes for which the file had to be read.
+        std::size_t NumCacheMisses() const;
+
+    private:
+
+        // PImple idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,95 @@
+/*
+ * CompilerSession.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_COMPILER_SESSION_H
+#define XSC_COMPILER_SESSION_H
+
+
+#include "Xsc.h"
+
+
+namespace Xsc
+{
+
+
+/* ===== Public classes ===== */
+
+/**
+\brief Compiler session class which compiles many shaders with the same default include handler.
+\remarks This is a thin wrapper around the global 'CompileShader' and 'CompileShaderBatch' functions.
+It reuses its compiler driver, but the setup of a compiler driver is cheap compared to a compilation,
+so a compiler session is not notably faster than the global functions.
+The default include handler of this session keeps the content of all included files (see CachingIncludeHandler).
+A compiler session must not be used by multiple threads at the same time.
+\see CompileShader
+*/
+class XSC_EXPORT CompilerSession
+{
+
+    public:
+
+        CompilerSession();
+        ~CompilerSession();
+
+        CompilerSession(const CompilerSession&) = delete;
+        CompilerSession& operator = (const CompilerSession&) = delete;
+
+        /**
+        \brief Cross compiles the shader code from the specified input stream into the specified output shader code.
+        \remarks This is equivalent to the global 'CompileShader' function,
+        except that the default include handler of this session is used if 'inputDesc.includeHandler' is null.
+        \see CompileShader
+        \see GetIncludeHandler
+        */
+        bool CompileShader(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Log*                        log             = nullptr,
+            Reflection::ReflectionData* reflectionData  = nullptr
+        );
+
+        /**
+        \brief Cross compiles several entry points from the same input shader code.
+        \remarks This is equivalent to the global 'CompileShaderBatch' function,
+        except that the default include handler of this session is used if 'inputDesc.includeHandler' is null.
+        \see CompileShaderBatch
+        \see GetIncludeHandler
+        */
+        bool CompileShaderBatch(
+            const ShaderInput&                  inputDesc,
+            const std::vector<ShaderBatchJob>&  jobs,
+            Log*                                log         = nullptr,
+            std::vector<bool>*                  jobResults  = nullptr
+        );
+
+        /**
+        \brief Returns the default include handler of this session.
+        \remarks The content of each included file is read only once and kept for all following compilations,
+        until the file has been modified on disk. Changing the search paths of this include handler invalidates its file cache.
+        */
+        IncludeHandler& GetIncludeHandler();
+
+        //! Clears the cache of all included files, e.g. after files have been added to the search paths.
+        void ClearIncludeCache();
+
+    private:
+
+        // PImple idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
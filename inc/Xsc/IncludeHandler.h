@@ -42,6 +42,14 @@ class XSC_EXPORT IncludeHandler
         */
         virtual std::unique_ptr<std::istream> Include(const std::string& filename, bool useSearchPathsFirst);
 
+        /**
+        \brief Returns true if the 'Include' function can be called by multiple threads at the same time.
+        \remarks If this is true and 'ShaderInput::prefetchIncludes' is enabled, the compiler loads included files on background threads while the shader is pre-processed.
+        The default implementation returns true only for this class itself, but false for all derived classes.
+        Override this function to return true, if a derived include handler is thread-safe.
+        */
+        virtual bool IsThreadSafe() const;
+
         //! Returns the list of search paths.
         std::vector<std::string>& GetSearchPaths();
 
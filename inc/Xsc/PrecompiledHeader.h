@@ -0,0 +1,89 @@
+/*
+ * PrecompiledHeader.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PRECOMPILED_HEADER_H
+#define XSC_PRECOMPILED_HEADER_H
+
+
+#include "Export.h"
+#include "Log.h"
+#include <string>
+
+
+namespace Xsc
+{
+
+
+struct ShaderInput;
+
+/**
+\brief Pre-processed header file, which replaces the inclusion of this header in subsequent compilations.
+\remarks A precompiled header stores the macro table and the pre-processed source code of a header file.
+When a shader includes this header, the stored macros and source code are used instead of pre-processing the header again.
+The precompiled header is only used, if the header file and all files it includes are unchanged,
+and if the macros, which are defined before the header is included, match the macros of its creation (e.g. the pre-defined macros).
+Otherwise, the header file is included as usual, and a pre-processor warning is emitted.
+A precompiled header can be used by multiple threads at the same time, once it has been created or loaded.
+\see ShaderInput::precompiledHeader
+*/
+class XSC_EXPORT PrecompiledHeader
+{
+
+    public:
+
+        PrecompiledHeader();
+        ~PrecompiledHeader();
+
+        PrecompiledHeader(const PrecompiledHeader&) = delete;
+        PrecompiledHeader& operator = (const PrecompiledHeader&) = delete;
+
+        /**
+        \brief Pre-processes the specified header file and stores the result in this precompiled header.
+        \param[in] inputDesc Specifies the header file. The member 'filename' must be the name, with which the header is included (e.g. "Common.hlsli").
+        The members 'sourceCode', 'shaderVersion', 'warnings', 'predefinedMacros', and 'includeHandler' are used, too.
+        \param[in] log Optional pointer to an output log. By default null.
+        \return True on success, otherwise this precompiled header is invalid.
+        */
+        bool Create(const ShaderInput& inputDesc, Log* log = nullptr);
+
+        /**
+        \brief Loads this precompiled header from the specified file.
+        \return True on success. Otherwise, the file could not be read or has an incompatible format, and this precompiled header is invalid.
+        */
+        bool Load(const std::string& filename);
+
+        /**
+        \brief Saves this precompiled header to the specified file.
+        \return True on success. Otherwise, the file could not be written or this precompiled header is invalid.
+        */
+        bool Save(const std::string& filename) const;
+
+        //! Returns true if this precompiled header has been created or loaded successfully.
+        bool IsValid() const;
+
+        //! Returns the name of the header file, which is replaced by this precompiled header.
+        const std::string& GetHeaderName() const;
+
+    private:
+
+        friend class Compiler;
+
+        // PImple idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
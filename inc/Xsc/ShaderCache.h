@@ -0,0 +1,120 @@
+/*
+ * ShaderCache.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SHADER_CACHE_H
+#define XSC_SHADER_CACHE_H
+
+
+#include "Export.h"
+#include <string>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/* ===== Public structures ===== */
+
+/**
+\brief Statistics of a shader cache.
+\see ShaderCache::GetStatistics
+*/
+struct ShaderCacheStatistics
+{
+    //! Number of compilations that were served from the cache.
+    std::size_t hits        = 0;
+
+    //! Number of compilations that were not found in the cache.
+    std::size_t misses      = 0;
+
+    //! Number of entries that have been written to the cache.
+    std::size_t stores      = 0;
+
+    //! Number of entries that have been removed from the cache to stay within its size limit.
+    std::size_t evictions   = 0;
+};
+
+
+/* ===== Public classes ===== */
+
+/**
+\brief Content-addressed on-disk cache for compiled shaders.
+\remarks Each entry is stored in its own file, named after the hash of the cache key.
+The cache key is made of the pre-processed source code and all options that affect the output,
+so a shader is only compiled again if its pre-processed source code or one of these options has changed.
+If the total size of all entries exceeds the size limit, the least recently used entries are removed.
+The index of all entries is written in batches and when the cache is destroyed. Entry files that are missing in the index
+(e.g. after a process was terminated) are adopted as least recently used entries when the cache is opened.
+A shader cache can be used by multiple threads at the same time, but not by multiple processes.
+\see ShaderInput::cache
+*/
+class XSC_EXPORT ShaderCache
+{
+
+    public:
+
+        /**
+        \brief Opens the shader cache in the specified directory.
+        \param[in] directory Specifies the cache directory. It is created if it does not exist yet.
+        \param[in] maxSize Specifies the maximal size (in bytes) of all cache entries. By default 64 MB.
+        */
+        ShaderCache(const std::string& directory, std::size_t maxSize = (64u << 20));
+
+        //! Writes the index of all cache entries back to the cache directory.
+        ~ShaderCache();
+
+        ShaderCache(const ShaderCache&) = delete;
+        ShaderCache& operator = (const ShaderCache&) = delete;
+
+        /**
+        \brief Loads the data of the cache entry with the specified key.
+        \param[in] key Specifies the full key of the cache entry.
+        \param[out] data Receives the data of the cache entry.
+        \return True if the entry was found, and its key matches. Otherwise, this counts as a cache miss.
+        */
+        bool Load(const std::string& key, std::string& data);
+
+        /**
+        \brief Stores the data of a cache entry with the specified key, and evicts the least recently used entries if the size limit is exceeded.
+        \param[in] key Specifies the full key of the cache entry.
+        \param[in] data Specifies the data of the cache entry.
+        */
+        void Store(const std::string& key, const std::string& data);
+
+        //! Removes all entries from this cache.
+        void Clear();
+
+        //! Returns the statistics of this cache since it was opened or the statistics were reset.
+        ShaderCacheStatistics GetStatistics() const;
+
+        //! Resets the statistics of this cache.
+        void ResetStatistics();
+
+        //! Returns the total size (in bytes) of all cache entries.
+        std::size_t GetSize() const;
+
+        //! Returns the cache directory.
+        const std::string& GetDirectory() const;
+
+    private:
+
+        // PImple idiom
+        struct OpaqueData;
+        OpaqueData* data_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
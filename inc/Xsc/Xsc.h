@@ -12,6 +12,9 @@
 #include "Export.h"
 #include "Log.h"
 #include "IncludeHandler.h"
+#include "CachingIncludeHandler.h"
+#include "ShaderCache.h"
+#include "PrecompiledHeader.h"
 #include "Targets.h"
 #include "Version.h"
 #include "Reflection.h"
@@ -22,6 +25,8 @@
 #include <istream>
 #include <ostream>
 #include <memory>
+#include <functional>
+#include <cstddef>
 
 
 /**
@@ -152,6 +157,12 @@ struct Options
     //! If true, the shader output may contain GLSL extensions, if the target shader version is too low. By default false.
     bool    allowExtensions         = false;
 
+    /**
+    \brief If true, all AST nodes and type denoters of a compilation are allocated in a memory arena instead of separate heap allocations. By default false.
+    \remarks The memory arena is released at once, when the syntax tree of the compilation is released.
+    */
+    bool    arenaAllocation         = false;
+
     /**
     \brief If true, binding slots for all buffer types will be generated sequentially, starting with index at 'autoBindingStartSlot'. By default false.
     \remarks This will also enable 'explicitBinding'.
@@ -164,6 +175,13 @@ struct Options
     //! If true, explicit binding slots are enabled. By default false.
     bool    explicitBinding         = false;
 
+    /**
+    \brief If true, HLSL function bodies are only parsed if the function can be reached from the entry point. By default false.
+    \remarks The tokens of all other function bodies are skipped, so these functions are never turned into AST nodes and are not validated.
+    This option is ignored if no entry point is specified or if 'preserveComments' or 'validateAll' is enabled.
+    */
+    bool    lazyFunctionBodies      = false;
+
     //! If true, code obfuscation is performed. By default false.
     bool    obfuscate               = false;
 
@@ -199,6 +217,12 @@ struct Options
     //! If true, array initializations will be unrolled. By default false.
     bool    unrollArrayInitializers = false;
 
+    /**
+    \brief If true, all functions are analyzed, even if they can not be reached from the entry point. By default false.
+    \remarks Otherwise, the bodies of unreachable functions are discarded before the context analysis, so errors within these functions are not reported.
+    */
+    bool    validateAll             = false;
+
     //! If true, the source code is only validated, but no output code will be generated. By default false.
     bool    validateOnly            = false;
 
@@ -255,6 +279,19 @@ struct NameMangling
     bool            renameBufferFields  = false;
 };
 
+/**
+\brief Pre-defined macro for the pre-processor.
+\see ShaderInput::predefinedMacros
+*/
+struct PredefinedMacro
+{
+    //! Specifies the macro identifier.
+    std::string ident;
+
+    //! Specifies the optional macro value. If this is empty, the macro is defined without a value.
+    std::string value;
+};
+
 /**
 \brief Shader input descriptor structure.
 \see CompileShader
@@ -264,7 +301,10 @@ struct ShaderInput
     //! Specifies the filename of the input shader code. This is an optional attribute, and only a hint to the compiler.
     std::string                     filename;
 
-    //! Specifies the input source code stream.
+    /**
+    \brief Specifies the input source code stream.
+    \remarks Use 'MakeMemoryInputStream' to compile the source code directly from a memory buffer.
+    */
     std::shared_ptr<std::istream>   sourceCode;
 
     //! Specifies the input shader version (e.g. InputShaderVersion::HLSL5 for "HLSL 5"). By default InputShaderVersion::HLSL5.
@@ -298,11 +338,44 @@ struct ShaderInput
     */
     unsigned int                    extensions          = 0;
 
+    /**
+    \brief List of macros which are defined before the input source code is pre-processed (like the '-D' compiler option).
+    \remarks The macros are defined in the specified order, so a macro value can refer to a previous macro.
+    \see PredefinedMacro
+    */
+    std::vector<PredefinedMacro>    predefinedMacros;
+
     /**
     \brief Optional pointer to the implementation of the "IncludeHandler" interface. By default null.
     \remarks If this is null, the default include handler will be used, which will include files with the STL input file streams.
     */
     IncludeHandler*                 includeHandler      = nullptr;
+
+    /**
+    \brief Specifies whether included files are loaded on background threads while the source code is pre-processed. By default false.
+    \remarks This is only used if the include handler is thread-safe (see IncludeHandler::IsThreadSafe).
+    Each compilation starts its own loader threads, and files inside of inactive '#if'-blocks may be loaded as well.
+    This is only beneficial for a single compilation with many included files on slow storage, but not for batches of many small compilations.
+    */
+    bool                            prefetchIncludes    = false;
+
+    /**
+    \brief Optional pointer to a shader cache. By default null.
+    \remarks If this is not null, the output code, reflection data, and reports are loaded from this cache,
+    when the pre-processed source code and all relevant input and output options match a previous compilation.
+    In this case, parsing, context analysis, and code generation are skipped entirely.
+    The cache is not used for the 'preprocessOnly' and 'showAST' options.
+    \see ShaderCache
+    */
+    ShaderCache*                    cache               = nullptr;
+
+    /**
+    \brief Optional pointer to a precompiled header. By default null.
+    \remarks If this is not null, the inclusion of the respective header file is replaced by the precompiled header,
+    as long as the precompiled header is up to date. The precompiled header must have the same input shader version.
+    \see PrecompiledHeader
+    */
+    const PrecompiledHeader*        precompiledHeader   = nullptr;
 };
 
 /**
@@ -334,6 +407,13 @@ struct UniformPacking
     std::string bufferName  = "xsp_buffer";
 };
 
+/**
+\brief Output callback which receives the output source code in consecutive chunks.
+\remarks The chunks are passed directly from the code generator, i.e. they are only valid during the callback.
+\see ShaderOutput::sourceCodeWriter
+*/
+using SourceCodeWriter = std::function<void(const char* data, std::size_t size)>;
+
 /**
 \brief Shader output descriptor structure.
 \see CompileShader
@@ -346,6 +426,13 @@ struct ShaderOutput
     //! Specifies the output source code stream. This will contain the output code. This must not be null when passed to the "CompileShader" function!
     std::ostream*               sourceCode          = nullptr;
 
+    /**
+    \brief Optional callback which receives the output source code instead of the output stream. By default null.
+    \remarks If this is specified, 'sourceCode' may be null, e.g. to append the output code to a caller-owned buffer without an intermediate stream.
+    If both are specified, the output code is written to the output stream.
+    */
+    SourceCodeWriter            sourceCodeWriter;
+
     //! Specifies the output shader version. By default OutputShaderVersion::GLSL (to auto-detect minimum required version).
     OutputShaderVersion         shaderVersion       = OutputShaderVersion::GLSL;
 
@@ -365,6 +452,105 @@ struct ShaderOutput
     NameMangling                nameMangling;
 };
 
+/**
+\brief Shader batch job descriptor structure for a single entry point of a shared input source.
+\see CompileShaderBatch
+*/
+struct ShaderBatchJob
+{
+    //! Specifies the HLSL shader entry point of this job. By default "main".
+    std::string                 entryPoint          = "main";
+
+    //! Specifies the secondary HLSL shader entry point of this job (see ShaderInput::secondaryEntryPoint).
+    std::string                 secondaryEntryPoint;
+
+    //! Specifies the target shader (Vertex, Fragment etc.) of this job. By default ShaderTarget::Undefined.
+    ShaderTarget                shaderTarget        = ShaderTarget::Undefined;
+
+    //! Specifies the output descriptor of this job. Its output stream must not be null unless 'options.validateOnly' is enabled.
+    ShaderOutput                outputDesc;
+
+    //! Optional pointer to a code reflection data structure for this job. By default null.
+    Reflection::ReflectionData* reflectionData      = nullptr;
+};
+
+/**
+\brief Compile job structure for the parallel shader compiler.
+\see CompileShadersParallel
+*/
+struct ShaderCompileJob
+{
+    //! Specifies the input shader code descriptor of this job.
+    ShaderInput                 inputDesc;
+
+    //! Specifies the output shader code descriptor of this job.
+    ShaderOutput                outputDesc;
+
+    //! Optional pointer to an output log for this job. By default null.
+    Log*                        log                 = nullptr;
+
+    //! Optional pointer to a code reflection data structure for this job. By default null.
+    Reflection::ReflectionData* reflectionData      = nullptr;
+};
+
+/**
+\brief Macro dimension of a shader permutation matrix.
+\see CompileShaderPermutations
+*/
+struct PermutationMacro
+{
+    //! Specifies the macro identifier.
+    std::string                 ident;
+
+    //! Specifies all values this macro is defined with (each value makes one variant). An empty value defines the macro without a value.
+    std::vector<std::string>    values;
+
+    //! Specifies whether one more variant is made where this macro is not defined. By default false.
+    bool                        undefinedVariant    = false;
+};
+
+/**
+\brief Single permutation of a shader permutation matrix.
+\see ShaderPermutationResult::permutations
+*/
+struct ShaderPermutation
+{
+    //! Macro definitions of this permutation as pairs of identifier and value. Macros which are not defined in this permutation are not listed.
+    std::vector<std::pair<std::string, std::string>>    macros;
+
+    //! Zero-based index into the list of output artifacts (see ShaderPermutationResult::outputs).
+    std::size_t                                         outputIndex = 0;
+};
+
+/**
+\brief Output artifact that is shared by all permutations with the same pre-processed source code.
+\see ShaderPermutationResult::outputs
+*/
+struct ShaderPermutationOutput
+{
+    //! Specifies whether the compilation of this artifact was successful.
+    bool                        result          = false;
+
+    //! Output shader code of this artifact.
+    std::string                 sourceCode;
+
+    //! Code reflection data of this artifact. The defined macros are taken from the first permutation of this artifact.
+    Reflection::ReflectionData  reflectionData;
+};
+
+/**
+\brief Result of the shader permutation compiler.
+\see CompileShaderPermutations
+*/
+struct ShaderPermutationResult
+{
+    //! List of all permutations of the macro matrix. Each permutation refers to its output artifact.
+    std::vector<ShaderPermutation>          permutations;
+
+    //! List of all unique output artifacts.
+    std::vector<ShaderPermutationOutput>    outputs;
+};
+
 /**
 \brief Descriptor structure for the shader disassembler.
 \see DisassembleShader
@@ -393,6 +579,15 @@ struct AssemblyDescriptor
 
 /* ===== Public functions ===== */
 
+/**
+\brief Returns an input stream which reads the shader code directly from the specified memory buffer.
+\param[in] data Pointer to the shader code. This buffer is not copied and must stay valid until the compilation is done.
+\param[in] size Specifies the size (in bytes) of the shader code.
+\remarks Use this for the 'ShaderInput::sourceCode' member to compile in-memory shader code without copying it.
+\see ShaderInput::sourceCode
+*/
+XSC_EXPORT std::shared_ptr<std::istream> MakeMemoryInputStream(const char* data, std::size_t size);
+
 /**
 \brief Cross compiles the shader code from the specified input stream into the specified output shader code.
 \param[in] inputDesc Input shader code descriptor.
@@ -400,7 +595,7 @@ struct AssemblyDescriptor
 \param[in] log Optional pointer to an output log. Inherit from the "Log" class interface. By default null.
 \param[out] reflectionData Optional pointer to a code reflection data structure. By default null.
 \return True if the code has been translated successfully.
-\throw std::invalid_argument If either the input or output streams are null.
+\throw std::invalid_argument If either the input stream, or both the output stream and the output callback are null.
 \see ShaderInput
 \see ShaderOutput
 \see Log
@@ -413,6 +608,70 @@ XSC_EXPORT bool CompileShader(
     Reflection::ReflectionData* reflectionData  = nullptr
 );
 
+/**
+\brief Cross compiles several entry points from the same input shader code, which is pre-processed only once for all jobs.
+\param[in] inputDesc Input shader code descriptor. The members 'entryPoint', 'secondaryEntryPoint', and 'shaderTarget' are ignored and taken from each job instead.
+\param[in] jobs Specifies the list of batch jobs. Each job has its own entry point, shader target, output descriptor, and optional reflection data.
+\param[in] log Optional pointer to an output log. Inherit from the "Log" class interface. By default null.
+\param[out] jobResults Optional pointer to a list which receives the result of each job. By default null.
+\return True if all jobs have been translated successfully.
+\throw std::invalid_argument If either the input or any of the output streams are null.
+\remarks Jobs with the 'preprocessOnly' option receive the shared pre-processed code (including line marks).
+The source is also parsed only once for all jobs with the same name mangling and 'rowMajorAlignment' option, and each job compiles its own copy of the syntax tree.
+\see ShaderBatchJob
+\see CompileShader
+*/
+XSC_EXPORT bool CompileShaderBatch(
+    const ShaderInput&                  inputDesc,
+    const std::vector<ShaderBatchJob>&  jobs,
+    Log*                                log         = nullptr,
+    std::vector<bool>*                  jobResults  = nullptr
+);
+
+/**
+\brief Cross compiles the input shader code for each permutation of the specified macro matrix.
+\param[in] inputDesc Input shader code descriptor.
+\param[in] outputDesc Output shader code descriptor. The output stream is ignored, since the output code is written to the artifacts of the result.
+\param[in] macroMatrix Specifies the macro dimensions. The permutations are made of the cartesian product of all macro variants.
+\param[out] permutationResult Receives all permutations and their unique output artifacts.
+\param[in] log Optional pointer to an output log. Inherit from the "Log" class interface. By default null.
+\return True if all permutations have been translated successfully.
+\throw std::invalid_argument If the input stream is null, or if a macro dimension has no variants.
+\remarks Each permutation is pre-processed, and all included files are loaded only once for all permutations.
+All permutations with the same pre-processed source code share the same output artifact,
+and only one of them is parsed, analyzed, and translated.
+\see PermutationMacro
+\see ShaderPermutationResult
+*/
+XSC_EXPORT bool CompileShaderPermutations(
+    const ShaderInput&                      inputDesc,
+    const ShaderOutput&                     outputDesc,
+    const std::vector<PermutationMacro>&    macroMatrix,
+    ShaderPermutationResult&                permutationResult,
+    Log*                                    log                 = nullptr
+);
+
+/**
+\brief Cross compiles several independent shaders on multiple threads.
+\param[in] jobs Specifies the list of compile jobs. Each job has its own input and output descriptors, log, and optional reflection data.
+\param[in] numThreads Specifies the number of worker threads. If this is 0, the number of hardware threads is used. By default 0.
+\param[out] jobResults Optional pointer to a list which receives the result of each job. By default null.
+\return True if all jobs have been translated successfully.
+\throw std::invalid_argument If either the input or any of the output streams are null.
+\remarks The jobs are distributed over a work-stealing thread pool, and the calling thread is one of the workers.
+Each worker thread uses its own compiler driver, and only the static keyword and intrinsic tables are shared between them.
+The results are the same as calling 'CompileShader' for each job in order.
+All streams, logs, and reflection data structures of the jobs must be distinct, unless they are thread-safe,
+and so must be the include handlers.
+\see ShaderCompileJob
+\see CompileShader
+*/
+XSC_EXPORT bool CompileShadersParallel(
+    const std::vector<ShaderCompileJob>&    jobs,
+    unsigned int                            numThreads  = 0,
+    std::vector<bool>*                      jobResults  = nullptr
+);
+
 /**
 \brief Disassembles the SPIR-V binary code into a human readable code.
 \param[in,out] streamIn Specifies the input stream of the SPIR-V binary code.
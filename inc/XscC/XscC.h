@@ -182,6 +182,16 @@ struct XscNameMangling
     XscBoolean  renameBufferFields;
 };
 
+//! Pre-defined macro for the pre-processor.
+struct XscPredefinedMacro
+{
+    //! Specifies the macro identifier.
+    const char* ident;
+
+    //! Specifies the optional macro value. If this is NULL or empty, the macro is defined without a value.
+    const char* value;
+};
+
 //! Shader input descriptor structure.
 struct XscShaderInput
 {
@@ -224,6 +234,12 @@ struct XscShaderInput
 
     //! Include handler member which contains a function pointer to handle '#include'-directives.
     struct XscIncludeHandler        includeHandler;
+
+    //! Optional list of macros which are defined before the input source code is pre-processed. By default NULL.
+    const struct XscPredefinedMacro* predefinedMacros;
+
+    //! Number of elements the 'predefinedMacros' member points to. By default 0.
+    size_t                          predefinedMacrosCount;
 };
 
 //! Vertex shader semantic (or rather attribute) layout structure.
@@ -291,6 +307,42 @@ XSC_EXPORT int XscCompileShader(
     struct XscReflectionData*       reflectionData
 );
 
+/**
+\brief Opaque compiler session object, which compiles many shaders with the same default include handler.
+\see XscCreateCompilerSession
+*/
+struct XscCompilerSession;
+
+/**
+\brief Creates a new compiler session.
+\return Pointer to the new compiler session, or NULL on failure. This must be released with "XscReleaseCompilerSession".
+\see XscReleaseCompilerSession
+*/
+XSC_EXPORT struct XscCompilerSession* XscCreateCompilerSession(void);
+
+//! Releases the specified compiler session. If 'session' is NULL, this function has no effect.
+XSC_EXPORT void XscReleaseCompilerSession(struct XscCompilerSession* session);
+
+/**
+\brief Cross compiles the shader code like "XscCompileShader", but with the specified compiler session.
+\param[in] session Specifies the compiler session. This must not be NULL.
+\remarks If the 'handleIncludePfn' member of the input include handler is NULL,
+the default include handler of the session reads the included files from disk (using the 'searchPaths' member),
+and keeps their content for all following compilations with this session.
+The returned pointers in the output descriptor and the XscReflectionData structure are only valid until this function is called the next time with the same session.
+\see XscCompileShader
+*/
+XSC_EXPORT int XscCompileShaderWithSession(
+    struct XscCompilerSession*      session,
+    const struct XscShaderInput*    inputDesc,
+    const struct XscShaderOutput*   outputDesc,
+    const struct XscLog*            log,
+    struct XscReflectionData*       reflectionData
+);
+
+//! Clears the cache of all included files of the specified compiler session, e.g. after files have been added to the search paths (modified files are detected automatically).
+XSC_EXPORT void XscClearCompilerSessionIncludeCache(struct XscCompilerSession* session);
+
 
 #ifdef __cplusplus
 } // /extern "C"
@@ -9,6 +9,7 @@
 #include "ASTFactory.h"
 #include "Exception.h"
 #include "IntrinsicAdept.h"
+#include "OverloadCache.h"
 #include "Variant.h"
 #include "SymbolTable.h"
 #include "ReportHandler.h"
@@ -621,7 +622,7 @@ bool VarDecl::AccumAlignedVectorSize(unsigned int& size, unsigned int& padding,
 
 TypeDenoterPtr BufferDecl::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
-    return std::make_shared<BufferTypeDenoter>(this)->AsArray(arrayDims);
+    return MakeShared<BufferTypeDenoter>(this)->AsArray(arrayDims);
 }
 
 BufferType BufferDecl::GetBufferType() const
@@ -634,7 +635,7 @@ BufferType BufferDecl::GetBufferType() const
 
 TypeDenoterPtr SamplerDecl::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
-    return std::make_shared<SamplerTypeDenoter>(this)->AsArray(arrayDims);
+    return MakeShared<SamplerTypeDenoter>(this)->AsArray(arrayDims);
 }
 
 SamplerType SamplerDecl::GetSamplerType() const
@@ -800,7 +801,7 @@ std::string StructDecl::FetchSimilar(const std::string& ident)
 
 TypeDenoterPtr StructDecl::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
-    return std::make_shared<StructTypeDenoter>(this);
+    return MakeShared<StructTypeDenoter>(this);
 }
 
 bool StructDecl::HasNonSystemValueMembers() const
@@ -1107,7 +1108,7 @@ void FunctionDecl::ParameterSemantics::UpdateDistribution()
 TypeDenoterPtr FunctionDecl::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
     //RuntimeErr(R_CantDeriveTypeOfFunction, this);
-    return std::make_shared<FunctionTypeDenoter>(this);
+    return MakeShared<FunctionTypeDenoter>(this);
 }
 
 bool FunctionDecl::IsForwardDecl() const
@@ -1642,7 +1643,7 @@ TypeDenoterPtr NullExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDeno
     Return 'int' as type, because null expressions are only
     used as dynamic array dimensions (which must be integral types)
     */
-    return std::make_shared<BaseTypeDenoter>(DataType::Int);
+    return BaseTypeDenoter::GetCanonical(DataType::Int);
 }
 
 
@@ -1691,9 +1692,9 @@ void SequenceExpr::Append(const ExprPtr& expr)
 TypeDenoterPtr LiteralExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDenoter*/)
 {
     if (IsNull())
-        return std::make_shared<NullTypeDenoter>();
+        return MakeShared<NullTypeDenoter>();
     else
-        return std::make_shared<BaseTypeDenoter>(dataType);
+        return BaseTypeDenoter::GetCanonical(dataType);
 }
 
 void LiteralExpr::ConvertDataType(const DataType type)
@@ -1815,7 +1816,7 @@ TypeDenoterPtr TernaryExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeD
             {
                 /* Return common type denoter, based on conditional expression type dimension */
                 const auto subDataType = VectorDataType(baseSubTypeDen->dataType, condVecSize);
-                return std::make_shared<BaseTypeDenoter>(subDataType);
+                return BaseTypeDenoter::GetCanonical(subDataType);
             }
         }
     }
@@ -2011,12 +2012,18 @@ TypeDenoterPtr CallExpr::DeriveTypeDenoter(const TypeDenoter* /*expectedTypeDeno
             /* Get object expression if this is a member function */
             auto memberFuncObjExpr = GetMemberFuncObjectExpr();
 
-            /* Return type denoter of associated intrinsic */
-            return IntrinsicAdept::Get().GetIntrinsicReturnType(
-                intrinsic,
-                arguments,
-                (memberFuncObjExpr != nullptr ? memberFuncObjExpr->GetTypeDenoter() : nullptr)
-            );
+            const auto prefixTypeDenoter = (memberFuncObjExpr != nullptr ? memberFuncObjExpr->GetTypeDenoter() : nullptr);
+
+            auto DeriveIntrinsicReturnType = [&]()
+            {
+                return IntrinsicAdept::Get().GetIntrinsicReturnType(intrinsic, arguments, prefixTypeDenoter);
+            };
+
+            /* Return type denoter of associated intrinsic (from the overload cache if enabled) */
+            if (auto overloadCache = OverloadCache::Active())
+                return overloadCache->GetIntrinsicReturnType(intrinsic, arguments, prefixTypeDenoter, DeriveIntrinsicReturnType);
+            else
+                return DeriveIntrinsicReturnType();
         }
         catch (const std::exception& e)
         {
@@ -2371,7 +2378,7 @@ BaseTypeDenoterPtr ObjectExpr::GetTypeDenoterFromSubscript() const
             {
                 /* Get vector type from subscript */
                 auto vectorType = SubscriptDataType(baseTypeDen->dataType, ident);
-                return std::make_shared<BaseTypeDenoter>(vectorType);
+                return BaseTypeDenoter::GetCanonical(vectorType);
             }
             catch (const std::exception& e)
             {
@@ -254,6 +254,8 @@ struct TypedAST : public AST
 
     private:
 
+        friend class ASTSerializer;
+
         // Buffered type denoter which is stored in the "GetTypeDenoter" function and can be reset with the "ResetTypeDenoter" function.
         TypeDenoterPtr bufferedTypeDenoter_;
 
@@ -0,0 +1,606 @@
+/*
+ * ASTCloner.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ASTCloner.h"
+
+
+namespace Xsc
+{
+
+
+ProgramPtr ASTCloner::CloneProgram(const Program& program)
+{
+    /* Copy all AST nodes and type denoters */
+    auto programCopy = std::static_pointer_cast<Program>(CloneAST(program));
+
+    /* Re-map all references to the copied nodes */
+    for (auto ast : clonedASTs_)
+        RemapASTRefs(*ast);
+
+    for (auto typeDen : clonedTypeDenoters_)
+        RemapTypeDenoterRefs(*typeDen);
+
+    /* Release internal references to the copied nodes */
+    astMap_.clear();
+    typeDenoterMap_.clear();
+    clonedASTs_.clear();
+    clonedTypeDenoters_.clear();
+
+    return programCopy;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+template <typename T>
+std::shared_ptr<T> ASTCloner::Clone(const std::shared_ptr<T>& ast)
+{
+    if (!ast)
+        return nullptr;
+
+    /* Return previous copy to preserve shared AST nodes */
+    auto it = astMap_.find(ast.get());
+    if (it != astMap_.end())
+        return std::static_pointer_cast<T>(it->second);
+
+    return std::static_pointer_cast<T>(CloneAST(*ast));
+}
+
+template <typename T>
+void ASTCloner::CloneList(std::vector<std::shared_ptr<T>>& astList)
+{
+    for (auto& ast : astList)
+        ast = Clone(ast);
+}
+
+template <typename T>
+std::shared_ptr<T> ASTCloner::CloneTypeDenoter(const std::shared_ptr<T>& typeDenoter)
+{
+    if (!typeDenoter)
+        return nullptr;
+
+    /* Return previous copy to preserve shared type denoters */
+    auto it = typeDenoterMap_.find(typeDenoter.get());
+    if (it != typeDenoterMap_.end())
+        return std::static_pointer_cast<T>(it->second);
+
+    return std::static_pointer_cast<T>(CloneTypeDenoterPrimary(*typeDenoter));
+}
+
+#define CLONE_AST_CASE(CLASS_NAME) \
+    case AST::Types::CLASS_NAME: return CopyAST<CLASS_NAME>(ast)
+
+ASTPtr ASTCloner::CloneAST(const AST& ast)
+{
+    switch (ast.Type())
+    {
+        CLONE_AST_CASE( Program           );
+        CLONE_AST_CASE( CodeBlock         );
+        CLONE_AST_CASE( Attribute         );
+        CLONE_AST_CASE( SwitchCase        );
+        CLONE_AST_CASE( SamplerValue      );
+        CLONE_AST_CASE( Register          );
+        CLONE_AST_CASE( PackOffset        );
+        CLONE_AST_CASE( ArrayDimension    );
+        CLONE_AST_CASE( TypeSpecifier     );
+
+        CLONE_AST_CASE( VarDecl           );
+        CLONE_AST_CASE( BufferDecl        );
+        CLONE_AST_CASE( SamplerDecl       );
+        CLONE_AST_CASE( StructDecl        );
+        CLONE_AST_CASE( AliasDecl         );
+        CLONE_AST_CASE( FunctionDecl      );
+        CLONE_AST_CASE( UniformBufferDecl );
+
+        CLONE_AST_CASE( VarDeclStmnt      );
+        CLONE_AST_CASE( BufferDeclStmnt   );
+        CLONE_AST_CASE( SamplerDeclStmnt  );
+        CLONE_AST_CASE( AliasDeclStmnt    );
+        CLONE_AST_CASE( BasicDeclStmnt    );
+
+        CLONE_AST_CASE( NullStmnt         );
+        CLONE_AST_CASE( CodeBlockStmnt    );
+        CLONE_AST_CASE( ForLoopStmnt      );
+        CLONE_AST_CASE( WhileLoopStmnt    );
+        CLONE_AST_CASE( DoWhileLoopStmnt  );
+        CLONE_AST_CASE( IfStmnt           );
+        CLONE_AST_CASE( ElseStmnt         );
+        CLONE_AST_CASE( SwitchStmnt       );
+        CLONE_AST_CASE( ExprStmnt         );
+        CLONE_AST_CASE( ReturnStmnt       );
+        CLONE_AST_CASE( CtrlTransferStmnt );
+        CLONE_AST_CASE( LayoutStmnt       );
+
+        CLONE_AST_CASE( NullExpr          );
+        CLONE_AST_CASE( SequenceExpr      );
+        CLONE_AST_CASE( LiteralExpr       );
+        CLONE_AST_CASE( TypeSpecifierExpr );
+        CLONE_AST_CASE( TernaryExpr       );
+        CLONE_AST_CASE( BinaryExpr        );
+        CLONE_AST_CASE( UnaryExpr         );
+        CLONE_AST_CASE( PostUnaryExpr     );
+        CLONE_AST_CASE( CallExpr          );
+        CLONE_AST_CASE( BracketExpr       );
+        CLONE_AST_CASE( ObjectExpr        );
+        CLONE_AST_CASE( AssignExpr        );
+        CLONE_AST_CASE( ArrayExpr         );
+        CLONE_AST_CASE( CastExpr          );
+        CLONE_AST_CASE( InitializerExpr   );
+    }
+    return nullptr;
+}
+
+#undef CLONE_AST_CASE
+
+TypeDenoterPtr ASTCloner::CloneTypeDenoterPrimary(const TypeDenoter& typeDenoter)
+{
+    /* Make shallow copy of type denoter and register it before sub type denoters are copied */
+    auto typeDenoterCopy = typeDenoter.Copy();
+
+    typeDenoterMap_[&typeDenoter] = typeDenoterCopy;
+    clonedTypeDenoters_.push_back(typeDenoterCopy.get());
+
+    if (auto bufferTypeDen = typeDenoterCopy->As<BufferTypeDenoter>())
+    {
+        bufferTypeDen->genericTypeDenoter = CloneTypeDenoter(bufferTypeDen->genericTypeDenoter);
+    }
+    else if (auto arrayTypeDen = typeDenoterCopy->As<ArrayTypeDenoter>())
+    {
+        arrayTypeDen->subTypeDenoter = CloneTypeDenoter(arrayTypeDen->subTypeDenoter);
+        CloneList(arrayTypeDen->arrayDims);
+    }
+
+    return typeDenoterCopy;
+}
+
+template <typename T>
+ASTPtr ASTCloner::CopyAST(const AST& ast)
+{
+    /* Make shallow copy of AST node and register it before sub nodes are copied */
+    auto astCopy = MakeShared<T>(static_cast<const T&>(ast));
+
+    astMap_[&ast] = astCopy;
+    clonedASTs_.push_back(astCopy.get());
+
+    CloneBaseMembers(*astCopy);
+    CloneMembers(*astCopy);
+
+    return astCopy;
+}
+
+/* ----- Sub node copies ----- */
+
+void ASTCloner::CloneBaseMembers(AST& /*ast*/)
+{
+    // dummy
+}
+
+void ASTCloner::CloneBaseMembers(Stmnt& ast)
+{
+    CloneList(ast.attribs);
+}
+
+void ASTCloner::CloneBaseMembers(TypedAST& ast)
+{
+    ast.ResetTypeDenoter();
+}
+
+void ASTCloner::CloneMembers(AST& /*ast*/)
+{
+    // dummy
+}
+
+void ASTCloner::CloneMembers(Program& ast)
+{
+    CloneList(ast.globalStmnts);
+    CloneList(ast.disabledAST);
+}
+
+void ASTCloner::CloneMembers(CodeBlock& ast)
+{
+    CloneList(ast.stmnts);
+}
+
+void ASTCloner::CloneMembers(SamplerValue& ast)
+{
+    ast.value = Clone(ast.value);
+}
+
+void ASTCloner::CloneMembers(Attribute& ast)
+{
+    CloneList(ast.arguments);
+}
+
+void ASTCloner::CloneMembers(SwitchCase& ast)
+{
+    ast.expr = Clone(ast.expr);
+    CloneList(ast.stmnts);
+}
+
+void ASTCloner::CloneMembers(ArrayDimension& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(TypeSpecifier& ast)
+{
+    ast.structDecl  = Clone(ast.structDecl);
+    ast.typeDenoter = CloneTypeDenoter(ast.typeDenoter);
+}
+
+/* --- Declarations --- */
+
+void ASTCloner::CloneMembers(VarDecl& ast)
+{
+    ast.namespaceExpr       = Clone(ast.namespaceExpr);
+    CloneList(ast.arrayDims);
+    CloneList(ast.slotRegisters);
+    ast.packOffset          = Clone(ast.packOffset);
+    CloneList(ast.annotations);
+    ast.initializer         = Clone(ast.initializer);
+    ast.customTypeDenoter   = CloneTypeDenoter(ast.customTypeDenoter);
+}
+
+void ASTCloner::CloneMembers(BufferDecl& ast)
+{
+    CloneList(ast.arrayDims);
+    CloneList(ast.slotRegisters);
+    CloneList(ast.annotations);
+}
+
+void ASTCloner::CloneMembers(SamplerDecl& ast)
+{
+    CloneList(ast.arrayDims);
+    CloneList(ast.slotRegisters);
+    CloneList(ast.samplerValues);
+}
+
+void ASTCloner::CloneMembers(StructDecl& ast)
+{
+    CloneList(ast.localStmnts);
+    CloneList(ast.varMembers);
+    CloneList(ast.funcMembers);
+}
+
+void ASTCloner::CloneMembers(AliasDecl& ast)
+{
+    ast.typeDenoter = CloneTypeDenoter(ast.typeDenoter);
+}
+
+void ASTCloner::CloneMembers(FunctionDecl& ast)
+{
+    ast.returnType  = Clone(ast.returnType);
+    CloneList(ast.parameters);
+    CloneList(ast.annotations);
+    ast.codeBlock   = Clone(ast.codeBlock);
+}
+
+void ASTCloner::CloneMembers(UniformBufferDecl& ast)
+{
+    CloneList(ast.slotRegisters);
+    CloneList(ast.localStmnts);
+    CloneList(ast.varMembers);
+}
+
+/* --- Declaration statements --- */
+
+void ASTCloner::CloneMembers(BufferDeclStmnt& ast)
+{
+    ast.typeDenoter = CloneTypeDenoter(ast.typeDenoter);
+    CloneList(ast.bufferDecls);
+}
+
+void ASTCloner::CloneMembers(SamplerDeclStmnt& ast)
+{
+    ast.typeDenoter = CloneTypeDenoter(ast.typeDenoter);
+    CloneList(ast.samplerDecls);
+}
+
+void ASTCloner::CloneMembers(BasicDeclStmnt& ast)
+{
+    ast.declObject = Clone(ast.declObject);
+}
+
+void ASTCloner::CloneMembers(VarDeclStmnt& ast)
+{
+    ast.typeSpecifier = Clone(ast.typeSpecifier);
+    CloneList(ast.varDecls);
+}
+
+void ASTCloner::CloneMembers(AliasDeclStmnt& ast)
+{
+    ast.structDecl = Clone(ast.structDecl);
+    CloneList(ast.aliasDecls);
+}
+
+/* --- Statements --- */
+
+void ASTCloner::CloneMembers(CodeBlockStmnt& ast)
+{
+    ast.codeBlock = Clone(ast.codeBlock);
+}
+
+void ASTCloner::CloneMembers(ForLoopStmnt& ast)
+{
+    ast.initStmnt   = Clone(ast.initStmnt);
+    ast.condition   = Clone(ast.condition);
+    ast.iteration   = Clone(ast.iteration);
+    ast.bodyStmnt   = Clone(ast.bodyStmnt);
+}
+
+void ASTCloner::CloneMembers(WhileLoopStmnt& ast)
+{
+    ast.condition   = Clone(ast.condition);
+    ast.bodyStmnt   = Clone(ast.bodyStmnt);
+}
+
+void ASTCloner::CloneMembers(DoWhileLoopStmnt& ast)
+{
+    ast.bodyStmnt   = Clone(ast.bodyStmnt);
+    ast.condition   = Clone(ast.condition);
+}
+
+void ASTCloner::CloneMembers(IfStmnt& ast)
+{
+    ast.condition   = Clone(ast.condition);
+    ast.bodyStmnt   = Clone(ast.bodyStmnt);
+    ast.elseStmnt   = Clone(ast.elseStmnt);
+}
+
+void ASTCloner::CloneMembers(ElseStmnt& ast)
+{
+    ast.bodyStmnt = Clone(ast.bodyStmnt);
+}
+
+void ASTCloner::CloneMembers(SwitchStmnt& ast)
+{
+    ast.selector = Clone(ast.selector);
+    CloneList(ast.cases);
+}
+
+void ASTCloner::CloneMembers(ExprStmnt& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(ReturnStmnt& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+/* --- Expressions --- */
+
+void ASTCloner::CloneMembers(SequenceExpr& ast)
+{
+    CloneList(ast.exprs);
+}
+
+void ASTCloner::CloneMembers(TypeSpecifierExpr& ast)
+{
+    ast.typeSpecifier = Clone(ast.typeSpecifier);
+}
+
+void ASTCloner::CloneMembers(TernaryExpr& ast)
+{
+    ast.condExpr = Clone(ast.condExpr);
+    ast.thenExpr = Clone(ast.thenExpr);
+    ast.elseExpr = Clone(ast.elseExpr);
+}
+
+void ASTCloner::CloneMembers(BinaryExpr& ast)
+{
+    ast.lhsExpr = Clone(ast.lhsExpr);
+    ast.rhsExpr = Clone(ast.rhsExpr);
+}
+
+void ASTCloner::CloneMembers(UnaryExpr& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(PostUnaryExpr& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(CallExpr& ast)
+{
+    ast.prefixExpr  = Clone(ast.prefixExpr);
+    ast.typeDenoter = CloneTypeDenoter(ast.typeDenoter);
+    CloneList(ast.arguments);
+}
+
+void ASTCloner::CloneMembers(BracketExpr& ast)
+{
+    ast.expr = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(AssignExpr& ast)
+{
+    ast.lvalueExpr = Clone(ast.lvalueExpr);
+    ast.rvalueExpr = Clone(ast.rvalueExpr);
+}
+
+void ASTCloner::CloneMembers(ObjectExpr& ast)
+{
+    ast.prefixExpr = Clone(ast.prefixExpr);
+}
+
+void ASTCloner::CloneMembers(ArrayExpr& ast)
+{
+    ast.prefixExpr = Clone(ast.prefixExpr);
+    CloneList(ast.arrayIndices);
+}
+
+void ASTCloner::CloneMembers(CastExpr& ast)
+{
+    ast.typeSpecifier   = Clone(ast.typeSpecifier);
+    ast.expr            = Clone(ast.expr);
+}
+
+void ASTCloner::CloneMembers(InitializerExpr& ast)
+{
+    CloneList(ast.exprs);
+}
+
+/* ----- Reference re-mapping ----- */
+
+template <typename T>
+void ASTCloner::RemapRef(T*& ref) const
+{
+    if (ref)
+    {
+        auto it = astMap_.find(ref);
+        if (it != astMap_.end())
+            ref = static_cast<T*>(it->second.get());
+    }
+}
+
+template <typename T>
+void ASTCloner::RemapRefs(std::vector<T*>& refs) const
+{
+    for (auto& ref : refs)
+        RemapRef(ref);
+}
+
+template <typename T>
+void ASTCloner::RemapRefs(std::set<T*>& refs) const
+{
+    std::set<T*> refsCopy;
+
+    for (auto ref : refs)
+    {
+        RemapRef(ref);
+        refsCopy.insert(ref);
+    }
+
+    refs = std::move(refsCopy);
+}
+
+void ASTCloner::RemapASTRefs(AST& ast)
+{
+    switch (ast.Type())
+    {
+        case AST::Types::Program:
+        {
+            auto& program = static_cast<Program&>(ast);
+            RemapRef(program.entryPointRef);
+            RemapRef(program.layoutTessControl.patchConstFunctionRef);
+        }
+        break;
+
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<VarDecl&>(ast);
+            RemapRef(varDecl.declStmntRef);
+            RemapRef(varDecl.bufferDeclRef);
+            RemapRef(varDecl.structDeclRef);
+            RemapRef(varDecl.staticMemberVarRef);
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+        {
+            RemapRef(static_cast<BufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::SamplerDecl:
+        {
+            RemapRef(static_cast<SamplerDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::StructDecl:
+        {
+            auto& structDecl = static_cast<StructDecl&>(ast);
+            RemapRef(structDecl.declStmntRef);
+            RemapRef(structDecl.baseStructRef);
+            RemapRef(structDecl.compatibleStructRef);
+
+            for (auto& systemValue : structDecl.systemValuesRef)
+                RemapRef(systemValue.second);
+
+            RemapRefs(structDecl.parentStructDeclRefs);
+            RemapRefs(structDecl.shaderOutputVarDeclRefs);
+        }
+        break;
+
+        case AST::Types::AliasDecl:
+        {
+            RemapRef(static_cast<AliasDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<FunctionDecl&>(ast);
+            RemapRefs(funcDecl.inputSemantics.varDeclRefs);
+            RemapRefs(funcDecl.inputSemantics.varDeclRefsSV);
+            RemapRefs(funcDecl.outputSemantics.varDeclRefs);
+            RemapRefs(funcDecl.outputSemantics.varDeclRefsSV);
+            RemapRef(funcDecl.declStmntRef);
+            RemapRef(funcDecl.funcImplRef);
+            RemapRefs(funcDecl.funcForwardDeclRefs);
+            RemapRef(funcDecl.structDeclRef);
+
+            for (auto& paramStruct : funcDecl.paramStructs)
+            {
+                RemapRef(paramStruct.expr);
+                RemapRef(paramStruct.varDecl);
+                RemapRef(paramStruct.structDecl);
+            }
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+        {
+            RemapRef(static_cast<UniformBufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::CallExpr:
+        {
+            auto& callExpr = static_cast<CallExpr&>(ast);
+            RemapRef(callExpr.funcDeclRef);
+            RemapRefs(callExpr.defaultParamRefs);
+        }
+        break;
+
+        case AST::Types::ObjectExpr:
+        {
+            RemapRef(static_cast<ObjectExpr&>(ast).symbolRef);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void ASTCloner::RemapTypeDenoterRefs(TypeDenoter& typeDenoter)
+{
+    if (auto bufferTypeDen = typeDenoter.As<BufferTypeDenoter>())
+        RemapRef(bufferTypeDen->bufferDeclRef);
+    else if (auto samplerTypeDen = typeDenoter.As<SamplerTypeDenoter>())
+        RemapRef(samplerTypeDen->samplerDeclRef);
+    else if (auto structTypeDen = typeDenoter.As<StructTypeDenoter>())
+        RemapRef(structTypeDen->structDeclRef);
+    else if (auto aliasTypeDen = typeDenoter.As<AliasTypeDenoter>())
+        RemapRef(aliasTypeDen->aliasDeclRef);
+    else if (auto funcTypeDen = typeDenoter.As<FunctionTypeDenoter>())
+        RemapRefs(funcTypeDen->funcDeclRefs);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,146 @@
+/*
+ * ASTCloner.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_AST_CLONER_H
+#define XSC_AST_CLONER_H
+
+
+#include "AST.h"
+#include "TypeDenoter.h"
+#include <unordered_map>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+AST deep copy class.
+Copies an entire program with all its AST nodes and type denoters,
+and re-maps all references (e.g. 'symbolRef', 'declStmntRef') to the copied nodes.
+References to nodes outside of the source program are left unchanged.
+Buffered type denoters of all typed AST nodes are reset and derived again on demand.
+*/
+class ASTCloner
+{
+
+    public:
+
+        // Returns a deep copy of the specified program.
+        ProgramPtr CloneProgram(const Program& program);
+
+    private:
+
+        /* === Functions === */
+
+        // Returns the copy of the specified AST node, or creates a new one if the node has not been copied yet.
+        template <typename T>
+        std::shared_ptr<T> Clone(const std::shared_ptr<T>& ast);
+
+        // Replaces all AST nodes in the specified list by their copies.
+        template <typename T>
+        void CloneList(std::vector<std::shared_ptr<T>>& astList);
+
+        // Returns the copy of the specified type denoter, or creates a new one if the type denoter has not been copied yet.
+        template <typename T>
+        std::shared_ptr<T> CloneTypeDenoter(const std::shared_ptr<T>& typeDenoter);
+
+        ASTPtr CloneAST(const AST& ast);
+        TypeDenoterPtr CloneTypeDenoterPrimary(const TypeDenoter& typeDenoter);
+
+        // Makes a shallow copy of the specified AST node and replaces all sub nodes by their copies.
+        template <typename T>
+        ASTPtr CopyAST(const AST& ast);
+
+        /* --- Sub node copies --- */
+
+        void CloneBaseMembers(AST& ast);
+        void CloneBaseMembers(Stmnt& ast);
+        void CloneBaseMembers(TypedAST& ast);
+
+        void CloneMembers(AST& ast);
+        void CloneMembers(Program& ast);
+        void CloneMembers(CodeBlock& ast);
+        void CloneMembers(SamplerValue& ast);
+        void CloneMembers(Attribute& ast);
+        void CloneMembers(SwitchCase& ast);
+        void CloneMembers(ArrayDimension& ast);
+        void CloneMembers(TypeSpecifier& ast);
+
+        void CloneMembers(VarDecl& ast);
+        void CloneMembers(BufferDecl& ast);
+        void CloneMembers(SamplerDecl& ast);
+        void CloneMembers(StructDecl& ast);
+        void CloneMembers(AliasDecl& ast);
+        void CloneMembers(FunctionDecl& ast);
+        void CloneMembers(UniformBufferDecl& ast);
+
+        void CloneMembers(BufferDeclStmnt& ast);
+        void CloneMembers(SamplerDeclStmnt& ast);
+        void CloneMembers(BasicDeclStmnt& ast);
+        void CloneMembers(VarDeclStmnt& ast);
+        void CloneMembers(AliasDeclStmnt& ast);
+
+        void CloneMembers(CodeBlockStmnt& ast);
+        void CloneMembers(ForLoopStmnt& ast);
+        void CloneMembers(WhileLoopStmnt& ast);
+        void CloneMembers(DoWhileLoopStmnt& ast);
+        void CloneMembers(IfStmnt& ast);
+        void CloneMembers(ElseStmnt& ast);
+        void CloneMembers(SwitchStmnt& ast);
+        void CloneMembers(ExprStmnt& ast);
+        void CloneMembers(ReturnStmnt& ast);
+
+        void CloneMembers(SequenceExpr& ast);
+        void CloneMembers(TypeSpecifierExpr& ast);
+        void CloneMembers(TernaryExpr& ast);
+        void CloneMembers(BinaryExpr& ast);
+        void CloneMembers(UnaryExpr& ast);
+        void CloneMembers(PostUnaryExpr& ast);
+        void CloneMembers(CallExpr& ast);
+        void CloneMembers(BracketExpr& ast);
+        void CloneMembers(AssignExpr& ast);
+        void CloneMembers(ObjectExpr& ast);
+        void CloneMembers(ArrayExpr& ast);
+        void CloneMembers(CastExpr& ast);
+        void CloneMembers(InitializerExpr& ast);
+
+        /* --- Reference re-mapping --- */
+
+        // Re-maps the specified reference to its copy (if the referenced node has been copied).
+        template <typename T>
+        void RemapRef(T*& ref) const;
+
+        template <typename T>
+        void RemapRefs(std::vector<T*>& refs) const;
+
+        template <typename T>
+        void RemapRefs(std::set<T*>& refs) const;
+
+        void RemapASTRefs(AST& ast);
+        void RemapTypeDenoterRefs(TypeDenoter& typeDenoter);
+
+        /* === Members === */
+
+        std::unordered_map<const AST*, ASTPtr>                  astMap_;
+        std::unordered_map<const TypeDenoter*, TypeDenoterPtr>  typeDenoterMap_;
+
+        std::vector<AST*>                                       clonedASTs_;
+        std::vector<TypeDenoter*>                               clonedTypeDenoters_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
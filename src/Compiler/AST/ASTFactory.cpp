@@ -22,14 +22,14 @@ namespace ASTFactory
 template <typename T, typename... Args>
 std::shared_ptr<T> MakeAST(Args&&... args)
 {
-    return std::make_shared<T>(SourcePosition::ignore, std::forward<Args>(args)...);
+    return MakeShared<T>(SourcePosition::ignore, std::forward<Args>(args)...);
 }
 
 // Makes a new AST node and takes the source origin from the first parameter.
 template <typename T, typename Origin, typename... Args>
 std::shared_ptr<T> MakeASTWithOrigin(const Origin& origin, Args&&... args)
 {
-    return std::make_shared<T>(origin->area, std::forward<Args>(args)...);
+    return MakeShared<T>(origin->area, std::forward<Args>(args)...);
 }
 
 /* ----- Make functions ----- */
@@ -54,7 +54,7 @@ CallExprPtr MakeTextureSamplerBindingCallExpr(const ExprPtr& textureObjectExpr,
         const auto& typeDen = textureObjectExpr->GetTypeDenoter()->GetAliased();
         if (auto bufferTypeDen = typeDen.As<BufferTypeDenoter>())
         {
-            ast->typeDenoter    = std::make_shared<SamplerTypeDenoter>(TextureTypeToSamplerType(bufferTypeDen->bufferType));
+            ast->typeDenoter    = MakeShared<SamplerTypeDenoter>(TextureTypeToSamplerType(bufferTypeDen->bufferType));
             ast->arguments      = { textureObjectExpr, samplerObjectExpr };
         }
     }
@@ -151,7 +151,7 @@ AliasDeclStmntPtr MakeBaseTypeAlias(const DataType dataType, const std::string&
         auto aliasDecl = MakeAST<AliasDecl>();
         {
             aliasDecl->ident        = ident;
-            aliasDecl->typeDenoter  = std::make_shared<BaseTypeDenoter>(dataType);
+            aliasDecl->typeDenoter  = BaseTypeDenoter::GetCanonical(dataType);
             aliasDecl->declStmntRef = ast.get();
         }
         ast->aliasDecls.push_back(aliasDecl);
@@ -164,7 +164,7 @@ TypeSpecifierPtr MakeTypeSpecifier(const StructDeclPtr& structDecl)
     auto ast = MakeAST<TypeSpecifier>();
     {
         ast->structDecl     = structDecl;
-        ast->typeDenoter    = std::make_shared<StructTypeDenoter>(structDecl.get());
+        ast->typeDenoter    = MakeShared<StructTypeDenoter>(structDecl.get());
     }
     ast->area = ast->structDecl->area;
     return ast;
@@ -181,7 +181,7 @@ TypeSpecifierPtr MakeTypeSpecifier(const TypeDenoterPtr& typeDenoter)
 
 TypeSpecifierPtr MakeTypeSpecifier(const DataType dataType)
 {
-    return MakeTypeSpecifier(std::make_shared<BaseTypeDenoter>(dataType));
+    return MakeTypeSpecifier(BaseTypeDenoter::GetCanonical(dataType));
 }
 
 VarDeclStmntPtr MakeVarDeclStmnt(const TypeSpecifierPtr& typeSpecifier, const std::string& ident, const ExprPtr& initializer)
@@ -492,7 +492,7 @@ ExprPtr ConvertExprBaseType(const DataType dataType, const ExprPtr& subExpr)
         /* Make new cast expression */
         auto ast = MakeASTWithOrigin<CastExpr>(subExpr);
         {
-            ast->typeSpecifier          = MakeTypeSpecifier(std::make_shared<BaseTypeDenoter>(dataType));
+            ast->typeSpecifier          = MakeTypeSpecifier(BaseTypeDenoter::GetCanonical(dataType));
             ast->typeSpecifier->area    = subExpr->area;
             ast->expr                   = subExpr;
         }
@@ -0,0 +1,1762 @@
+/*
+ * ASTSerializer.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ASTSerializer.h"
+#include "MemoryArena.h"
+#include <stdexcept>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal members
+ */
+
+// Identifies a serialized program; the version must be increased whenever the AST or this format changes.
+static const char*          g_astMagic          = "XSCAST";
+static const std::uint32_t  g_astFormatVersion  = 1;
+
+// Returns true if the specified AST type denotes a sub class of "Stmnt" (including the GLSL only 'LayoutStmnt').
+static bool IsStmntClass(const AST::Types t)
+{
+    return (IsStmntAST(t) || t == AST::Types::LayoutStmnt);
+}
+
+// Returns true if the specified AST type denotes a sub class of "TypedAST".
+static bool IsTypedClass(const AST::Types t)
+{
+    return (IsExprAST(t) || IsDeclAST(t) || t == AST::Types::ArrayDimension || t == AST::Types::TypeSpecifier);
+}
+
+#define MAKE_AST_CASE(CLASS_NAME) \
+    case AST::Types::CLASS_NAME: return MakeShared<CLASS_NAME>(area)
+
+static ASTPtr MakeAST(const AST::Types type, const SourceArea& area)
+{
+    switch (type)
+    {
+        MAKE_AST_CASE( Program           );
+        MAKE_AST_CASE( CodeBlock         );
+        MAKE_AST_CASE( Attribute         );
+        MAKE_AST_CASE( SwitchCase        );
+        MAKE_AST_CASE( SamplerValue      );
+        MAKE_AST_CASE( Register          );
+        MAKE_AST_CASE( PackOffset        );
+        MAKE_AST_CASE( ArrayDimension    );
+        MAKE_AST_CASE( TypeSpecifier     );
+
+        MAKE_AST_CASE( VarDecl           );
+        MAKE_AST_CASE( BufferDecl        );
+        MAKE_AST_CASE( SamplerDecl       );
+        MAKE_AST_CASE( StructDecl        );
+        MAKE_AST_CASE( AliasDecl         );
+        MAKE_AST_CASE( FunctionDecl      );
+        MAKE_AST_CASE( UniformBufferDecl );
+
+        MAKE_AST_CASE( VarDeclStmnt      );
+        MAKE_AST_CASE( BufferDeclStmnt   );
+        MAKE_AST_CASE( SamplerDeclStmnt  );
+        MAKE_AST_CASE( AliasDeclStmnt    );
+        MAKE_AST_CASE( BasicDeclStmnt    );
+
+        MAKE_AST_CASE( NullStmnt         );
+        MAKE_AST_CASE( CodeBlockStmnt    );
+        MAKE_AST_CASE( ForLoopStmnt      );
+        MAKE_AST_CASE( WhileLoopStmnt    );
+        MAKE_AST_CASE( DoWhileLoopStmnt  );
+        MAKE_AST_CASE( IfStmnt           );
+        MAKE_AST_CASE( ElseStmnt         );
+        MAKE_AST_CASE( SwitchStmnt       );
+        MAKE_AST_CASE( ExprStmnt         );
+        MAKE_AST_CASE( ReturnStmnt       );
+        MAKE_AST_CASE( CtrlTransferStmnt );
+        MAKE_AST_CASE( LayoutStmnt       );
+
+        MAKE_AST_CASE( NullExpr          );
+        MAKE_AST_CASE( SequenceExpr      );
+        MAKE_AST_CASE( LiteralExpr       );
+        MAKE_AST_CASE( TypeSpecifierExpr );
+        MAKE_AST_CASE( TernaryExpr       );
+        MAKE_AST_CASE( BinaryExpr        );
+        MAKE_AST_CASE( UnaryExpr         );
+        MAKE_AST_CASE( PostUnaryExpr     );
+        MAKE_AST_CASE( CallExpr          );
+        MAKE_AST_CASE( BracketExpr       );
+        MAKE_AST_CASE( ObjectExpr        );
+        MAKE_AST_CASE( AssignExpr        );
+        MAKE_AST_CASE( ArrayExpr         );
+        MAKE_AST_CASE( CastExpr          );
+        MAKE_AST_CASE( InitializerExpr   );
+    }
+    throw std::runtime_error("invalid AST type in serialized program");
+}
+
+#undef MAKE_AST_CASE
+
+static TypeDenoterPtr MakeTypeDenoter(const TypeDenoter::Types type)
+{
+    switch (type)
+    {
+        case TypeDenoter::Types::Void:      return MakeShared<VoidTypeDenoter>();
+        case TypeDenoter::Types::Null:      return MakeShared<NullTypeDenoter>();
+        case TypeDenoter::Types::Base:      return MakeShared<BaseTypeDenoter>();
+        case TypeDenoter::Types::Buffer:    return MakeShared<BufferTypeDenoter>();
+        case TypeDenoter::Types::Sampler:   return MakeShared<SamplerTypeDenoter>();
+        case TypeDenoter::Types::Struct:    return MakeShared<StructTypeDenoter>();
+        case TypeDenoter::Types::Alias:     return MakeShared<AliasTypeDenoter>();
+        case TypeDenoter::Types::Array:     return MakeShared<ArrayTypeDenoter>();
+        case TypeDenoter::Types::Function:  return MakeShared<FunctionTypeDenoter>();
+    }
+    throw std::runtime_error("invalid type denoter in serialized program");
+}
+
+
+/*
+ * ASTSerializer class
+ */
+
+std::string ASTSerializer::Save(const Program& program)
+{
+    BinaryWriter writer;
+    writer_ = &writer;
+
+    writer.WriteString(g_astMagic);
+    writer.WriteUInt(g_astFormatVersion);
+
+    /* Write all AST nodes and type denoters (shared nodes are written only once) */
+    WriteAST(&program);
+
+    /* Write all references, once all referenced nodes have an index */
+    for (auto ast : savedASTs_)
+        WriteASTRefs(*ast);
+
+    for (auto typeDen : savedTypeDenoters_)
+        WriteTypeDenoterRefs(*typeDen);
+
+    numNodes_ = savedASTs_.size();
+
+    /* Release internal references to the saved nodes */
+    writer_ = nullptr;
+    astIndices_.clear();
+    typeDenoterIndices_.clear();
+    originIndices_.clear();
+    savedASTs_.clear();
+    savedTypeDenoters_.clear();
+
+    return writer.Data();
+}
+
+ProgramPtr ASTSerializer::Load(const char* data, std::size_t size)
+{
+    BinaryReader reader(data, size);
+    reader_ = &reader;
+
+    ProgramPtr program;
+
+    try
+    {
+        if (reader.ReadString() == g_astMagic && reader.ReadUInt() == g_astFormatVersion)
+        {
+            /* Read all AST nodes and type denoters */
+            auto ast = ReadASTPrimary();
+            if (ast && ast->Type() == AST::Types::Program)
+            {
+                /* Read all references, once all referenced nodes have been created */
+                for (const auto& loadedAST : loadedASTs_)
+                    ReadASTRefs(*loadedAST);
+
+                for (const auto& loadedTypeDen : loadedTypeDenoters_)
+                    ReadTypeDenoterRefs(*loadedTypeDen);
+
+                if (reader.Finished())
+                    program = std::static_pointer_cast<Program>(ast);
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        program.reset();
+    }
+
+    numNodes_ = (program ? loadedASTs_.size() : 0);
+
+    /* Release internal references to the loaded nodes */
+    reader_ = nullptr;
+    loadedASTs_.clear();
+    loadedTypeDenoters_.clear();
+    loadedOrigins_.clear();
+
+    return program;
+}
+
+ProgramPtr ASTSerializer::Load(const std::string& data)
+{
+    return Load(data.data(), data.size());
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+/* ----- Saving ----- */
+
+void ASTSerializer::WriteAST(const AST* ast)
+{
+    if (!ast)
+    {
+        writer_->WriteUInt(0);
+        return;
+    }
+
+    /* Write only the index of a previously written AST node */
+    auto it = astIndices_.find(ast);
+    if (it != astIndices_.end())
+    {
+        writer_->WriteUInt(it->second);
+        return;
+    }
+
+    /* Register AST node before its sub nodes are written */
+    const auto index = static_cast<std::uint32_t>(savedASTs_.size() + 1);
+    astIndices_[ast] = index;
+    savedASTs_.push_back(ast);
+
+    writer_->WriteUInt(index);
+    writer_->WriteEnum(ast->Type());
+    WriteSourceArea(ast->area);
+    WriteASTMembers(*ast);
+}
+
+template <typename T>
+void ASTSerializer::WriteASTList(const std::vector<std::shared_ptr<T>>& astList)
+{
+    writer_->WriteUInt(static_cast<std::uint32_t>(astList.size()));
+    for (const auto& ast : astList)
+        WriteAST(ast.get());
+}
+
+void ASTSerializer::WriteASTMembers(const AST& ast)
+{
+    writer_->WriteUInt(ast.flags);
+
+    /* Write members of base classes (the buffered type denoter may depend on the context, e.g. for initializer lists) */
+    if (IsTypedClass(ast.Type()))
+        WriteTypeDenoter(static_cast<const TypedAST&>(ast).bufferedTypeDenoter_.get());
+
+    if (IsStmntClass(ast.Type()))
+    {
+        auto& stmnt = static_cast<const Stmnt&>(ast);
+        writer_->WriteString(stmnt.comment);
+        WriteASTList(stmnt.attribs);
+    }
+    else if (IsDeclAST(ast.Type()))
+        WriteIdentifier(static_cast<const Decl&>(ast).ident);
+
+    switch (ast.Type())
+    {
+        /* --- Common AST nodes --- */
+
+        case AST::Types::Program:
+        {
+            auto& program = static_cast<const Program&>(ast);
+            WriteASTList(program.globalStmnts);
+            WriteASTList(program.disabledAST);
+
+            writer_->WriteUInt(static_cast<std::uint32_t>(program.usedIntrinsics.size()));
+            for (const auto& usage : program.usedIntrinsics)
+            {
+                writer_->WriteEnum(usage.first);
+                writer_->WriteUInt(static_cast<std::uint32_t>(usage.second.argLists.size()));
+                for (const auto& argList : usage.second.argLists)
+                    writer_->WriteList(argList.argTypes, [this](DataType t) { writer_->WriteEnum(t); });
+            }
+
+            writer_->WriteUInt(static_cast<std::uint32_t>(program.usedMatrixSubscripts.size()));
+            for (const auto& usage : program.usedMatrixSubscripts)
+            {
+                writer_->WriteList(
+                    usage.indices,
+                    [this](const std::pair<int, int>& index)
+                    {
+                        writer_->WriteInt(index.first);
+                        writer_->WriteInt(index.second);
+                    }
+                );
+                writer_->WriteEnum(usage.dataTypeIn);
+                writer_->WriteEnum(usage.dataTypeOut);
+            }
+
+            writer_->WriteUInt(program.layoutTessControl.outputControlPoints);
+            writer_->WriteFloat(program.layoutTessControl.maxTessFactor);
+            writer_->WriteEnum(program.layoutTessEvaluation.domainType);
+            writer_->WriteEnum(program.layoutTessEvaluation.partitioning);
+            writer_->WriteEnum(program.layoutTessEvaluation.outputTopology);
+            writer_->WriteEnum(program.layoutGeometry.inputPrimitive);
+            writer_->WriteEnum(program.layoutGeometry.outputPrimitive);
+            writer_->WriteUInt(program.layoutGeometry.maxVertices);
+            writer_->WriteBool(program.layoutFragment.fragCoordUsed);
+            writer_->WriteBool(program.layoutFragment.pixelCenterInteger);
+            writer_->WriteBool(program.layoutFragment.earlyDepthStencil);
+            for (auto numThreads : program.layoutCompute.numThreads)
+                writer_->WriteUInt(numThreads);
+        }
+        break;
+
+        case AST::Types::CodeBlock:
+        {
+            WriteASTList(static_cast<const CodeBlock&>(ast).stmnts);
+        }
+        break;
+
+        case AST::Types::Attribute:
+        {
+            auto& attrib = static_cast<const Attribute&>(ast);
+            writer_->WriteEnum(attrib.attributeType);
+            WriteASTList(attrib.arguments);
+        }
+        break;
+
+        case AST::Types::SwitchCase:
+        {
+            auto& switchCase = static_cast<const SwitchCase&>(ast);
+            WriteAST(switchCase.expr.get());
+            WriteASTList(switchCase.stmnts);
+        }
+        break;
+
+        case AST::Types::SamplerValue:
+        {
+            auto& samplerValue = static_cast<const SamplerValue&>(ast);
+            writer_->WriteString(samplerValue.name);
+            WriteAST(samplerValue.value.get());
+        }
+        break;
+
+        case AST::Types::Register:
+        {
+            auto& slotRegister = static_cast<const Register&>(ast);
+            writer_->WriteEnum(slotRegister.shaderTarget);
+            writer_->WriteEnum(slotRegister.registerType);
+            writer_->WriteInt(slotRegister.slot);
+        }
+        break;
+
+        case AST::Types::PackOffset:
+        {
+            auto& packOffset = static_cast<const PackOffset&>(ast);
+            writer_->WriteString(packOffset.registerName);
+            writer_->WriteString(packOffset.vectorComponent);
+        }
+        break;
+
+        case AST::Types::ArrayDimension:
+        {
+            auto& arrayDim = static_cast<const ArrayDimension&>(ast);
+            WriteAST(arrayDim.expr.get());
+            writer_->WriteInt(arrayDim.size);
+        }
+        break;
+
+        case AST::Types::TypeSpecifier:
+        {
+            auto& typeSpecifier = static_cast<const TypeSpecifier&>(ast);
+            writer_->WriteBool(typeSpecifier.isInput);
+            writer_->WriteBool(typeSpecifier.isOutput);
+            writer_->WriteBool(typeSpecifier.isUniform);
+            writer_->WriteUInt(static_cast<std::uint32_t>(typeSpecifier.storageClasses.size()));
+            for (auto storageClass : typeSpecifier.storageClasses)
+                writer_->WriteEnum(storageClass);
+            writer_->WriteUInt(static_cast<std::uint32_t>(typeSpecifier.interpModifiers.size()));
+            for (auto interpModifier : typeSpecifier.interpModifiers)
+                writer_->WriteEnum(interpModifier);
+            writer_->WriteUInt(static_cast<std::uint32_t>(typeSpecifier.typeModifiers.size()));
+            for (auto typeModifier : typeSpecifier.typeModifiers)
+                writer_->WriteEnum(typeModifier);
+            writer_->WriteEnum(typeSpecifier.primitiveType);
+            WriteAST(typeSpecifier.structDecl.get());
+            WriteTypeDenoter(typeSpecifier.typeDenoter.get());
+        }
+        break;
+
+        /* --- Declarations --- */
+
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<const VarDecl&>(ast);
+            WriteAST(varDecl.namespaceExpr.get());
+            WriteASTList(varDecl.arrayDims);
+            WriteASTList(varDecl.slotRegisters);
+            WriteSemantic(varDecl.semantic);
+            WriteAST(varDecl.packOffset.get());
+            WriteASTList(varDecl.annotations);
+            WriteAST(varDecl.initializer.get());
+            WriteTypeDenoter(varDecl.customTypeDenoter.get());
+            WriteVariant(varDecl.initializerValue);
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+        {
+            auto& bufferDecl = static_cast<const BufferDecl&>(ast);
+            WriteASTList(bufferDecl.arrayDims);
+            WriteASTList(bufferDecl.slotRegisters);
+            WriteASTList(bufferDecl.annotations);
+        }
+        break;
+
+        case AST::Types::SamplerDecl:
+        {
+            auto& samplerDecl = static_cast<const SamplerDecl&>(ast);
+            WriteASTList(samplerDecl.arrayDims);
+            WriteASTList(samplerDecl.slotRegisters);
+            writer_->WriteString(samplerDecl.textureIdent);
+            WriteASTList(samplerDecl.samplerValues);
+        }
+        break;
+
+        case AST::Types::StructDecl:
+        {
+            auto& structDecl = static_cast<const StructDecl&>(ast);
+            writer_->WriteBool(structDecl.isClass);
+            writer_->WriteString(structDecl.baseStructName);
+            WriteASTList(structDecl.localStmnts);
+            WriteASTList(structDecl.varMembers);
+            WriteASTList(structDecl.funcMembers);
+        }
+        break;
+
+        case AST::Types::AliasDecl:
+        {
+            WriteTypeDenoter(static_cast<const AliasDecl&>(ast).typeDenoter.get());
+        }
+        break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<const FunctionDecl&>(ast);
+            WriteAST(funcDecl.returnType.get());
+            WriteASTList(funcDecl.parameters);
+            WriteSemantic(funcDecl.semantic);
+            WriteASTList(funcDecl.annotations);
+            WriteAST(funcDecl.codeBlock.get());
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+        {
+            auto& uniformBufferDecl = static_cast<const UniformBufferDecl&>(ast);
+            writer_->WriteEnum(uniformBufferDecl.bufferType);
+            WriteASTList(uniformBufferDecl.slotRegisters);
+            WriteASTList(uniformBufferDecl.localStmnts);
+            WriteASTList(uniformBufferDecl.varMembers);
+            writer_->WriteEnum(uniformBufferDecl.commonStorageLayout);
+        }
+        break;
+
+        /* --- Declaration statements --- */
+
+        case AST::Types::VarDeclStmnt:
+        {
+            auto& varDeclStmnt = static_cast<const VarDeclStmnt&>(ast);
+            WriteAST(varDeclStmnt.typeSpecifier.get());
+            WriteASTList(varDeclStmnt.varDecls);
+        }
+        break;
+
+        case AST::Types::BufferDeclStmnt:
+        {
+            auto& bufferDeclStmnt = static_cast<const BufferDeclStmnt&>(ast);
+            WriteTypeDenoter(bufferDeclStmnt.typeDenoter.get());
+            WriteASTList(bufferDeclStmnt.bufferDecls);
+        }
+        break;
+
+        case AST::Types::SamplerDeclStmnt:
+        {
+            auto& samplerDeclStmnt = static_cast<const SamplerDeclStmnt&>(ast);
+            WriteTypeDenoter(samplerDeclStmnt.typeDenoter.get());
+            WriteASTList(samplerDeclStmnt.samplerDecls);
+        }
+        break;
+
+        case AST::Types::AliasDeclStmnt:
+        {
+            auto& aliasDeclStmnt = static_cast<const AliasDeclStmnt&>(ast);
+            WriteAST(aliasDeclStmnt.structDecl.get());
+            WriteASTList(aliasDeclStmnt.aliasDecls);
+        }
+        break;
+
+        case AST::Types::BasicDeclStmnt:
+        {
+            WriteAST(static_cast<const BasicDeclStmnt&>(ast).declObject.get());
+        }
+        break;
+
+        /* --- Statements --- */
+
+        case AST::Types::CodeBlockStmnt:
+        {
+            WriteAST(static_cast<const CodeBlockStmnt&>(ast).codeBlock.get());
+        }
+        break;
+
+        case AST::Types::ForLoopStmnt:
+        {
+            auto& forLoopStmnt = static_cast<const ForLoopStmnt&>(ast);
+            WriteAST(forLoopStmnt.initStmnt.get());
+            WriteAST(forLoopStmnt.condition.get());
+            WriteAST(forLoopStmnt.iteration.get());
+            WriteAST(forLoopStmnt.bodyStmnt.get());
+        }
+        break;
+
+        case AST::Types::WhileLoopStmnt:
+        {
+            auto& whileLoopStmnt = static_cast<const WhileLoopStmnt&>(ast);
+            WriteAST(whileLoopStmnt.condition.get());
+            WriteAST(whileLoopStmnt.bodyStmnt.get());
+        }
+        break;
+
+        case AST::Types::DoWhileLoopStmnt:
+        {
+            auto& doWhileLoopStmnt = static_cast<const DoWhileLoopStmnt&>(ast);
+            WriteAST(doWhileLoopStmnt.bodyStmnt.get());
+            WriteAST(doWhileLoopStmnt.condition.get());
+        }
+        break;
+
+        case AST::Types::IfStmnt:
+        {
+            auto& ifStmnt = static_cast<const IfStmnt&>(ast);
+            WriteAST(ifStmnt.condition.get());
+            WriteAST(ifStmnt.bodyStmnt.get());
+            WriteAST(ifStmnt.elseStmnt.get());
+        }
+        break;
+
+        case AST::Types::ElseStmnt:
+        {
+            WriteAST(static_cast<const ElseStmnt&>(ast).bodyStmnt.get());
+        }
+        break;
+
+        case AST::Types::SwitchStmnt:
+        {
+            auto& switchStmnt = static_cast<const SwitchStmnt&>(ast);
+            WriteAST(switchStmnt.selector.get());
+            WriteASTList(switchStmnt.cases);
+        }
+        break;
+
+        case AST::Types::ExprStmnt:
+        {
+            WriteAST(static_cast<const ExprStmnt&>(ast).expr.get());
+        }
+        break;
+
+        case AST::Types::ReturnStmnt:
+        {
+            WriteAST(static_cast<const ReturnStmnt&>(ast).expr.get());
+        }
+        break;
+
+        case AST::Types::CtrlTransferStmnt:
+        {
+            writer_->WriteEnum(static_cast<const CtrlTransferStmnt&>(ast).transfer);
+        }
+        break;
+
+        case AST::Types::LayoutStmnt:
+        {
+            auto& layoutStmnt = static_cast<const LayoutStmnt&>(ast);
+            writer_->WriteBool(layoutStmnt.isInput);
+            writer_->WriteBool(layoutStmnt.isOutput);
+        }
+        break;
+
+        /* --- Expressions --- */
+
+        case AST::Types::SequenceExpr:
+        {
+            WriteASTList(static_cast<const SequenceExpr&>(ast).exprs);
+        }
+        break;
+
+        case AST::Types::LiteralExpr:
+        {
+            auto& literalExpr = static_cast<const LiteralExpr&>(ast);
+            writer_->WriteString(literalExpr.value);
+            writer_->WriteEnum(literalExpr.dataType);
+        }
+        break;
+
+        case AST::Types::TypeSpecifierExpr:
+        {
+            WriteAST(static_cast<const TypeSpecifierExpr&>(ast).typeSpecifier.get());
+        }
+        break;
+
+        case AST::Types::TernaryExpr:
+        {
+            auto& ternaryExpr = static_cast<const TernaryExpr&>(ast);
+            WriteAST(ternaryExpr.condExpr.get());
+            WriteAST(ternaryExpr.thenExpr.get());
+            WriteAST(ternaryExpr.elseExpr.get());
+        }
+        break;
+
+        case AST::Types::BinaryExpr:
+        {
+            auto& binaryExpr = static_cast<const BinaryExpr&>(ast);
+            WriteAST(binaryExpr.lhsExpr.get());
+            writer_->WriteEnum(binaryExpr.op);
+            WriteAST(binaryExpr.rhsExpr.get());
+        }
+        break;
+
+        case AST::Types::UnaryExpr:
+        {
+            auto& unaryExpr = static_cast<const UnaryExpr&>(ast);
+            writer_->WriteEnum(unaryExpr.op);
+            WriteAST(unaryExpr.expr.get());
+        }
+        break;
+
+        case AST::Types::PostUnaryExpr:
+        {
+            auto& postUnaryExpr = static_cast<const PostUnaryExpr&>(ast);
+            WriteAST(postUnaryExpr.expr.get());
+            writer_->WriteEnum(postUnaryExpr.op);
+        }
+        break;
+
+        case AST::Types::CallExpr:
+        {
+            auto& callExpr = static_cast<const CallExpr&>(ast);
+            WriteAST(callExpr.prefixExpr.get());
+            writer_->WriteBool(callExpr.isStatic);
+            writer_->WriteString(callExpr.ident);
+            WriteTypeDenoter(callExpr.typeDenoter.get());
+            WriteASTList(callExpr.arguments);
+            writer_->WriteEnum(callExpr.intrinsic);
+        }
+        break;
+
+        case AST::Types::BracketExpr:
+        {
+            WriteAST(static_cast<const BracketExpr&>(ast).expr.get());
+        }
+        break;
+
+        case AST::Types::ObjectExpr:
+        {
+            auto& objectExpr = static_cast<const ObjectExpr&>(ast);
+            WriteAST(objectExpr.prefixExpr.get());
+            writer_->WriteBool(objectExpr.isStatic);
+            writer_->WriteString(objectExpr.ident);
+        }
+        break;
+
+        case AST::Types::AssignExpr:
+        {
+            auto& assignExpr = static_cast<const AssignExpr&>(ast);
+            WriteAST(assignExpr.lvalueExpr.get());
+            writer_->WriteEnum(assignExpr.op);
+            WriteAST(assignExpr.rvalueExpr.get());
+        }
+        break;
+
+        case AST::Types::ArrayExpr:
+        {
+            auto& arrayExpr = static_cast<const ArrayExpr&>(ast);
+            WriteAST(arrayExpr.prefixExpr.get());
+            WriteASTList(arrayExpr.arrayIndices);
+        }
+        break;
+
+        case AST::Types::CastExpr:
+        {
+            auto& castExpr = static_cast<const CastExpr&>(ast);
+            WriteAST(castExpr.typeSpecifier.get());
+            WriteAST(castExpr.expr.get());
+        }
+        break;
+
+        case AST::Types::InitializerExpr:
+        {
+            WriteASTList(static_cast<const InitializerExpr&>(ast).exprs);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void ASTSerializer::WriteASTRefs(const AST& ast)
+{
+    switch (ast.Type())
+    {
+        case AST::Types::Program:
+        {
+            auto& program = static_cast<const Program&>(ast);
+            WriteRef(program.entryPointRef);
+            WriteRef(program.layoutTessControl.patchConstFunctionRef);
+        }
+        break;
+
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<const VarDecl&>(ast);
+            WriteRef(varDecl.declStmntRef);
+            WriteRef(varDecl.bufferDeclRef);
+            WriteRef(varDecl.structDeclRef);
+            WriteRef(varDecl.staticMemberVarRef);
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+        {
+            WriteRef(static_cast<const BufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::SamplerDecl:
+        {
+            WriteRef(static_cast<const SamplerDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::StructDecl:
+        {
+            auto& structDecl = static_cast<const StructDecl&>(ast);
+            WriteRef(structDecl.declStmntRef);
+            WriteRef(structDecl.baseStructRef);
+            WriteRef(structDecl.compatibleStructRef);
+            writer_->WriteUInt(static_cast<std::uint32_t>(structDecl.systemValuesRef.size()));
+            for (const auto& systemValue : structDecl.systemValuesRef)
+            {
+                writer_->WriteString(systemValue.first);
+                WriteRef(systemValue.second);
+            }
+            WriteRefs(structDecl.parentStructDeclRefs);
+            WriteRefs(structDecl.shaderOutputVarDeclRefs);
+        }
+        break;
+
+        case AST::Types::AliasDecl:
+        {
+            WriteRef(static_cast<const AliasDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<const FunctionDecl&>(ast);
+            WriteRefs(funcDecl.inputSemantics.varDeclRefs);
+            WriteRefs(funcDecl.inputSemantics.varDeclRefsSV);
+            WriteRefs(funcDecl.outputSemantics.varDeclRefs);
+            WriteRefs(funcDecl.outputSemantics.varDeclRefsSV);
+            WriteRef(funcDecl.declStmntRef);
+            WriteRef(funcDecl.funcImplRef);
+            WriteRefs(funcDecl.funcForwardDeclRefs);
+            WriteRef(funcDecl.structDeclRef);
+            writer_->WriteUInt(static_cast<std::uint32_t>(funcDecl.paramStructs.size()));
+            for (const auto& paramStruct : funcDecl.paramStructs)
+            {
+                WriteRef(paramStruct.expr);
+                WriteRef(paramStruct.varDecl);
+                WriteRef(paramStruct.structDecl);
+            }
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+        {
+            WriteRef(static_cast<const UniformBufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::CallExpr:
+        {
+            auto& callExpr = static_cast<const CallExpr&>(ast);
+            WriteRef(callExpr.funcDeclRef);
+            WriteRefs(callExpr.defaultParamRefs);
+        }
+        break;
+
+        case AST::Types::ObjectExpr:
+        {
+            WriteRef(static_cast<const ObjectExpr&>(ast).symbolRef);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void ASTSerializer::WriteTypeDenoter(const TypeDenoter* typeDenoter)
+{
+    if (!typeDenoter)
+    {
+        writer_->WriteUInt(0);
+        return;
+    }
+
+    /* Write only the index of a previously written type denoter */
+    auto it = typeDenoterIndices_.find(typeDenoter);
+    if (it != typeDenoterIndices_.end())
+    {
+        writer_->WriteUInt(it->second);
+        return;
+    }
+
+    /* Register type denoter before its sub type denoters are written */
+    const auto index = static_cast<std::uint32_t>(savedTypeDenoters_.size() + 1);
+    typeDenoterIndices_[typeDenoter] = index;
+    savedTypeDenoters_.push_back(typeDenoter);
+
+    writer_->WriteUInt(index);
+    writer_->WriteEnum(typeDenoter->Type());
+    WriteTypeDenoterMembers(*typeDenoter);
+}
+
+void ASTSerializer::WriteTypeDenoterMembers(const TypeDenoter& typeDenoter)
+{
+    if (auto baseTypeDen = typeDenoter.As<BaseTypeDenoter>())
+    {
+        writer_->WriteEnum(baseTypeDen->dataType);
+        #ifdef XSC_ENABLE_LANGUAGE_EXT
+        writer_->WriteString(std::string(baseTypeDen->vectorSpace.src.begin(), baseTypeDen->vectorSpace.src.end()));
+        writer_->WriteString(std::string(baseTypeDen->vectorSpace.dst.begin(), baseTypeDen->vectorSpace.dst.end()));
+        #endif
+    }
+    else if (auto bufferTypeDen = typeDenoter.As<BufferTypeDenoter>())
+    {
+        writer_->WriteEnum(bufferTypeDen->bufferType);
+        WriteTypeDenoter(bufferTypeDen->genericTypeDenoter.get());
+        writer_->WriteInt(bufferTypeDen->genericSize);
+        #ifdef XSC_ENABLE_LANGUAGE_EXT
+        writer_->WriteEnum(bufferTypeDen->layoutFormat);
+        #endif
+    }
+    else if (auto samplerTypeDen = typeDenoter.As<SamplerTypeDenoter>())
+        writer_->WriteEnum(samplerTypeDen->samplerType);
+    else if (auto structTypeDen = typeDenoter.As<StructTypeDenoter>())
+        writer_->WriteString(structTypeDen->ident);
+    else if (auto aliasTypeDen = typeDenoter.As<AliasTypeDenoter>())
+        writer_->WriteString(aliasTypeDen->ident);
+    else if (auto arrayTypeDen = typeDenoter.As<ArrayTypeDenoter>())
+    {
+        WriteTypeDenoter(arrayTypeDen->subTypeDenoter.get());
+        WriteASTList(arrayTypeDen->arrayDims);
+    }
+    else if (auto funcTypeDen = typeDenoter.As<FunctionTypeDenoter>())
+        writer_->WriteString(funcTypeDen->ident);
+}
+
+void ASTSerializer::WriteTypeDenoterRefs(const TypeDenoter& typeDenoter)
+{
+    if (auto bufferTypeDen = typeDenoter.As<BufferTypeDenoter>())
+        WriteRef(bufferTypeDen->bufferDeclRef);
+    else if (auto samplerTypeDen = typeDenoter.As<SamplerTypeDenoter>())
+        WriteRef(samplerTypeDen->samplerDeclRef);
+    else if (auto structTypeDen = typeDenoter.As<StructTypeDenoter>())
+        WriteRef(structTypeDen->structDeclRef);
+    else if (auto aliasTypeDen = typeDenoter.As<AliasTypeDenoter>())
+        WriteRef(aliasTypeDen->aliasDeclRef);
+    else if (auto funcTypeDen = typeDenoter.As<FunctionTypeDenoter>())
+        WriteRefs(funcTypeDen->funcDeclRefs);
+}
+
+void ASTSerializer::WriteRef(const AST* ref)
+{
+    if (ref)
+    {
+        auto it = astIndices_.find(ref);
+        if (it != astIndices_.end())
+        {
+            writer_->WriteUInt(it->second);
+            return;
+        }
+    }
+    writer_->WriteUInt(0);
+}
+
+template <typename T>
+void ASTSerializer::WriteRefs(const std::vector<T*>& refs)
+{
+    writer_->WriteUInt(static_cast<std::uint32_t>(refs.size()));
+    for (auto ref : refs)
+        WriteRef(ref);
+}
+
+template <typename T>
+void ASTSerializer::WriteRefs(const std::set<T*>& refs)
+{
+    writer_->WriteUInt(static_cast<std::uint32_t>(refs.size()));
+    for (auto ref : refs)
+        WriteRef(ref);
+}
+
+void ASTSerializer::WriteSourceArea(const SourceArea& area)
+{
+    const auto& pos = area.Pos();
+
+    writer_->WriteUInt(pos.Row());
+    writer_->WriteUInt(pos.Column());
+
+    /* Write source origin only once, since it is shared by all positions of the same source file */
+    if (auto origin = pos.GetOrigin())
+    {
+        auto it = originIndices_.find(origin);
+        if (it != originIndices_.end())
+            writer_->WriteUInt(it->second);
+        else
+        {
+            const auto index = static_cast<std::uint32_t>(originIndices_.size() + 1);
+            originIndices_[origin] = index;
+            writer_->WriteUInt(index);
+            writer_->WriteString(origin->filename);
+            writer_->WriteInt(origin->lineOffset);
+        }
+    }
+    else
+        writer_->WriteUInt(0);
+
+    writer_->WriteUInt(area.Length());
+    writer_->WriteUInt(area.Offset());
+}
+
+void ASTSerializer::WriteIdentifier(const Identifier& ident)
+{
+    writer_->WriteBool(ident.originalSet_);
+    writer_->WriteString(ident.original_.Str());
+    writer_->WriteBool(ident.renamedSet_);
+    writer_->WriteString(ident.renamed_.Str());
+    writer_->WriteInt(ident.counter_);
+}
+
+void ASTSerializer::WriteSemantic(const IndexedSemantic& semantic)
+{
+    writer_->WriteEnum(semantic.semantic_);
+    writer_->WriteInt(semantic.index_);
+    writer_->WriteString(semantic.userDefined_);
+}
+
+void ASTSerializer::WriteVariant(const Variant& value)
+{
+    writer_->WriteEnum(value.Type());
+    switch (value.Type())
+    {
+        case Variant::Types::Undefined:
+            break;
+        case Variant::Types::Bool:
+            writer_->WriteBool(value.Bool());
+            break;
+        case Variant::Types::Int:
+            writer_->WriteUInt64(static_cast<std::uint64_t>(value.Int()));
+            break;
+        case Variant::Types::Real:
+            writer_->WriteDouble(value.Real());
+            break;
+        case Variant::Types::Array:
+            writer_->WriteList(value.Array(), [this](const Variant& subValue) { WriteVariant(subValue); });
+            break;
+    }
+}
+
+/* ----- Loading ----- */
+
+ASTPtr ASTSerializer::ReadASTPrimary()
+{
+    const auto index = ReadIndex(loadedASTs_.size());
+    if (index == 0)
+        return nullptr;
+
+    /* Return previously loaded AST node to preserve shared AST nodes */
+    if (index <= loadedASTs_.size())
+        return loadedASTs_[index - 1];
+
+    /* Register AST node before its sub nodes are loaded */
+    const auto type = reader_->ReadEnum<AST::Types>();
+    auto ast = MakeAST(type, ReadSourceArea());
+
+    loadedASTs_.push_back(ast);
+    ReadASTMembers(*ast);
+
+    return ast;
+}
+
+template <typename T>
+std::shared_ptr<T> ASTSerializer::ReadAST()
+{
+    return std::static_pointer_cast<T>(ReadASTPrimary());
+}
+
+template <typename T>
+void ASTSerializer::ReadASTList(std::vector<std::shared_ptr<T>>& astList)
+{
+    const auto size = reader_->ReadUInt();
+    astList.clear();
+    astList.reserve(size);
+    for (std::uint32_t i = 0; i < size && reader_->Valid(); ++i)
+        astList.push_back(ReadAST<T>());
+}
+
+void ASTSerializer::ReadASTMembers(AST& ast)
+{
+    ast.flags = Flags(reader_->ReadUInt());
+
+    /* Read members of base classes */
+    if (IsTypedClass(ast.Type()))
+        static_cast<TypedAST&>(ast).bufferedTypeDenoter_ = ReadTypeDenoter<TypeDenoter>();
+
+    if (IsStmntClass(ast.Type()))
+    {
+        auto& stmnt = static_cast<Stmnt&>(ast);
+        stmnt.comment = reader_->ReadString();
+        ReadASTList(stmnt.attribs);
+    }
+    else if (IsDeclAST(ast.Type()))
+        ReadIdentifier(static_cast<Decl&>(ast).ident);
+
+    switch (ast.Type())
+    {
+        /* --- Common AST nodes --- */
+
+        case AST::Types::Program:
+        {
+            auto& program = static_cast<Program&>(ast);
+            ReadASTList(program.globalStmnts);
+            ReadASTList(program.disabledAST);
+
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+            {
+                auto& usage = program.usedIntrinsics[reader_->ReadEnum<Intrinsic>()];
+                for (auto numArgLists = reader_->ReadUInt(); numArgLists > 0 && reader_->Valid(); --numArgLists)
+                {
+                    IntrinsicUsage::ArgumentList argList;
+                    reader_->ReadList(argList.argTypes, [this](DataType& t) { t = reader_->ReadEnum<DataType>(); });
+                    usage.argLists.insert(std::move(argList));
+                }
+            }
+
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+            {
+                MatrixSubscriptUsage usage;
+                reader_->ReadList(
+                    usage.indices,
+                    [this](std::pair<int, int>& index)
+                    {
+                        index.first     = reader_->ReadInt();
+                        index.second    = reader_->ReadInt();
+                    }
+                );
+                usage.dataTypeIn    = reader_->ReadEnum<DataType>();
+                usage.dataTypeOut   = reader_->ReadEnum<DataType>();
+                program.usedMatrixSubscripts.insert(std::move(usage));
+            }
+
+            program.layoutTessControl.outputControlPoints   = reader_->ReadUInt();
+            program.layoutTessControl.maxTessFactor         = reader_->ReadFloat();
+            program.layoutTessEvaluation.domainType         = reader_->ReadEnum<AttributeValue>();
+            program.layoutTessEvaluation.partitioning       = reader_->ReadEnum<AttributeValue>();
+            program.layoutTessEvaluation.outputTopology     = reader_->ReadEnum<AttributeValue>();
+            program.layoutGeometry.inputPrimitive           = reader_->ReadEnum<PrimitiveType>();
+            program.layoutGeometry.outputPrimitive          = reader_->ReadEnum<BufferType>();
+            program.layoutGeometry.maxVertices              = reader_->ReadUInt();
+            program.layoutFragment.fragCoordUsed            = reader_->ReadBool();
+            program.layoutFragment.pixelCenterInteger       = reader_->ReadBool();
+            program.layoutFragment.earlyDepthStencil        = reader_->ReadBool();
+            for (auto& numThreads : program.layoutCompute.numThreads)
+                numThreads = reader_->ReadUInt();
+        }
+        break;
+
+        case AST::Types::CodeBlock:
+        {
+            ReadASTList(static_cast<CodeBlock&>(ast).stmnts);
+        }
+        break;
+
+        case AST::Types::Attribute:
+        {
+            auto& attrib = static_cast<Attribute&>(ast);
+            attrib.attributeType = reader_->ReadEnum<AttributeType>();
+            ReadASTList(attrib.arguments);
+        }
+        break;
+
+        case AST::Types::SwitchCase:
+        {
+            auto& switchCase = static_cast<SwitchCase&>(ast);
+            switchCase.expr = ReadAST<Expr>();
+            ReadASTList(switchCase.stmnts);
+        }
+        break;
+
+        case AST::Types::SamplerValue:
+        {
+            auto& samplerValue = static_cast<SamplerValue&>(ast);
+            samplerValue.name   = reader_->ReadString();
+            samplerValue.value  = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::Register:
+        {
+            auto& slotRegister = static_cast<Register&>(ast);
+            slotRegister.shaderTarget   = reader_->ReadEnum<ShaderTarget>();
+            slotRegister.registerType   = reader_->ReadEnum<RegisterType>();
+            slotRegister.slot           = reader_->ReadInt();
+        }
+        break;
+
+        case AST::Types::PackOffset:
+        {
+            auto& packOffset = static_cast<PackOffset&>(ast);
+            packOffset.registerName     = reader_->ReadString();
+            packOffset.vectorComponent  = reader_->ReadString();
+        }
+        break;
+
+        case AST::Types::ArrayDimension:
+        {
+            auto& arrayDim = static_cast<ArrayDimension&>(ast);
+            arrayDim.expr = ReadAST<Expr>();
+            arrayDim.size = reader_->ReadInt();
+        }
+        break;
+
+        case AST::Types::TypeSpecifier:
+        {
+            auto& typeSpecifier = static_cast<TypeSpecifier&>(ast);
+            typeSpecifier.isInput   = reader_->ReadBool();
+            typeSpecifier.isOutput  = reader_->ReadBool();
+            typeSpecifier.isUniform = reader_->ReadBool();
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+                typeSpecifier.storageClasses.insert(reader_->ReadEnum<StorageClass>());
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+                typeSpecifier.interpModifiers.insert(reader_->ReadEnum<InterpModifier>());
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+                typeSpecifier.typeModifiers.insert(reader_->ReadEnum<TypeModifier>());
+            typeSpecifier.primitiveType = reader_->ReadEnum<PrimitiveType>();
+            typeSpecifier.structDecl    = ReadAST<StructDecl>();
+            typeSpecifier.typeDenoter   = ReadTypeDenoter<TypeDenoter>();
+        }
+        break;
+
+        /* --- Declarations --- */
+
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<VarDecl&>(ast);
+            varDecl.namespaceExpr = ReadAST<ObjectExpr>();
+            ReadASTList(varDecl.arrayDims);
+            ReadASTList(varDecl.slotRegisters);
+            ReadSemantic(varDecl.semantic);
+            varDecl.packOffset = ReadAST<PackOffset>();
+            ReadASTList(varDecl.annotations);
+            varDecl.initializer         = ReadAST<Expr>();
+            varDecl.customTypeDenoter   = ReadTypeDenoter<TypeDenoter>();
+            varDecl.initializerValue    = ReadVariant();
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+        {
+            auto& bufferDecl = static_cast<BufferDecl&>(ast);
+            ReadASTList(bufferDecl.arrayDims);
+            ReadASTList(bufferDecl.slotRegisters);
+            ReadASTList(bufferDecl.annotations);
+        }
+        break;
+
+        case AST::Types::SamplerDecl:
+        {
+            auto& samplerDecl = static_cast<SamplerDecl&>(ast);
+            ReadASTList(samplerDecl.arrayDims);
+            ReadASTList(samplerDecl.slotRegisters);
+            samplerDecl.textureIdent = reader_->ReadString();
+            ReadASTList(samplerDecl.samplerValues);
+        }
+        break;
+
+        case AST::Types::StructDecl:
+        {
+            auto& structDecl = static_cast<StructDecl&>(ast);
+            structDecl.isClass          = reader_->ReadBool();
+            structDecl.baseStructName   = reader_->ReadString();
+            ReadASTList(structDecl.localStmnts);
+            ReadASTList(structDecl.varMembers);
+            ReadASTList(structDecl.funcMembers);
+        }
+        break;
+
+        case AST::Types::AliasDecl:
+        {
+            static_cast<AliasDecl&>(ast).typeDenoter = ReadTypeDenoter<TypeDenoter>();
+        }
+        break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<FunctionDecl&>(ast);
+            funcDecl.returnType = ReadAST<TypeSpecifier>();
+            ReadASTList(funcDecl.parameters);
+            ReadSemantic(funcDecl.semantic);
+            ReadASTList(funcDecl.annotations);
+            funcDecl.codeBlock = ReadAST<CodeBlock>();
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+        {
+            auto& uniformBufferDecl = static_cast<UniformBufferDecl&>(ast);
+            uniformBufferDecl.bufferType = reader_->ReadEnum<UniformBufferType>();
+            ReadASTList(uniformBufferDecl.slotRegisters);
+            ReadASTList(uniformBufferDecl.localStmnts);
+            ReadASTList(uniformBufferDecl.varMembers);
+            uniformBufferDecl.commonStorageLayout = reader_->ReadEnum<TypeModifier>();
+        }
+        break;
+
+        /* --- Declaration statements --- */
+
+        case AST::Types::VarDeclStmnt:
+        {
+            auto& varDeclStmnt = static_cast<VarDeclStmnt&>(ast);
+            varDeclStmnt.typeSpecifier = ReadAST<TypeSpecifier>();
+            ReadASTList(varDeclStmnt.varDecls);
+        }
+        break;
+
+        case AST::Types::BufferDeclStmnt:
+        {
+            auto& bufferDeclStmnt = static_cast<BufferDeclStmnt&>(ast);
+            bufferDeclStmnt.typeDenoter = ReadTypeDenoter<BufferTypeDenoter>();
+            ReadASTList(bufferDeclStmnt.bufferDecls);
+        }
+        break;
+
+        case AST::Types::SamplerDeclStmnt:
+        {
+            auto& samplerDeclStmnt = static_cast<SamplerDeclStmnt&>(ast);
+            samplerDeclStmnt.typeDenoter = ReadTypeDenoter<SamplerTypeDenoter>();
+            ReadASTList(samplerDeclStmnt.samplerDecls);
+        }
+        break;
+
+        case AST::Types::AliasDeclStmnt:
+        {
+            auto& aliasDeclStmnt = static_cast<AliasDeclStmnt&>(ast);
+            aliasDeclStmnt.structDecl = ReadAST<StructDecl>();
+            ReadASTList(aliasDeclStmnt.aliasDecls);
+        }
+        break;
+
+        case AST::Types::BasicDeclStmnt:
+        {
+            static_cast<BasicDeclStmnt&>(ast).declObject = ReadAST<Decl>();
+        }
+        break;
+
+        /* --- Statements --- */
+
+        case AST::Types::CodeBlockStmnt:
+        {
+            static_cast<CodeBlockStmnt&>(ast).codeBlock = ReadAST<CodeBlock>();
+        }
+        break;
+
+        case AST::Types::ForLoopStmnt:
+        {
+            auto& forLoopStmnt = static_cast<ForLoopStmnt&>(ast);
+            forLoopStmnt.initStmnt  = ReadAST<Stmnt>();
+            forLoopStmnt.condition  = ReadAST<Expr>();
+            forLoopStmnt.iteration  = ReadAST<Expr>();
+            forLoopStmnt.bodyStmnt  = ReadAST<Stmnt>();
+        }
+        break;
+
+        case AST::Types::WhileLoopStmnt:
+        {
+            auto& whileLoopStmnt = static_cast<WhileLoopStmnt&>(ast);
+            whileLoopStmnt.condition = ReadAST<Expr>();
+            whileLoopStmnt.bodyStmnt = ReadAST<Stmnt>();
+        }
+        break;
+
+        case AST::Types::DoWhileLoopStmnt:
+        {
+            auto& doWhileLoopStmnt = static_cast<DoWhileLoopStmnt&>(ast);
+            doWhileLoopStmnt.bodyStmnt = ReadAST<Stmnt>();
+            doWhileLoopStmnt.condition = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::IfStmnt:
+        {
+            auto& ifStmnt = static_cast<IfStmnt&>(ast);
+            ifStmnt.condition   = ReadAST<Expr>();
+            ifStmnt.bodyStmnt   = ReadAST<Stmnt>();
+            ifStmnt.elseStmnt   = ReadAST<ElseStmnt>();
+        }
+        break;
+
+        case AST::Types::ElseStmnt:
+        {
+            static_cast<ElseStmnt&>(ast).bodyStmnt = ReadAST<Stmnt>();
+        }
+        break;
+
+        case AST::Types::SwitchStmnt:
+        {
+            auto& switchStmnt = static_cast<SwitchStmnt&>(ast);
+            switchStmnt.selector = ReadAST<Expr>();
+            ReadASTList(switchStmnt.cases);
+        }
+        break;
+
+        case AST::Types::ExprStmnt:
+        {
+            static_cast<ExprStmnt&>(ast).expr = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::ReturnStmnt:
+        {
+            static_cast<ReturnStmnt&>(ast).expr = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::CtrlTransferStmnt:
+        {
+            static_cast<CtrlTransferStmnt&>(ast).transfer = reader_->ReadEnum<CtrlTransfer>();
+        }
+        break;
+
+        case AST::Types::LayoutStmnt:
+        {
+            auto& layoutStmnt = static_cast<LayoutStmnt&>(ast);
+            layoutStmnt.isInput     = reader_->ReadBool();
+            layoutStmnt.isOutput    = reader_->ReadBool();
+        }
+        break;
+
+        /* --- Expressions --- */
+
+        case AST::Types::SequenceExpr:
+        {
+            ReadASTList(static_cast<SequenceExpr&>(ast).exprs);
+        }
+        break;
+
+        case AST::Types::LiteralExpr:
+        {
+            auto& literalExpr = static_cast<LiteralExpr&>(ast);
+            literalExpr.value       = reader_->ReadString();
+            literalExpr.dataType    = reader_->ReadEnum<DataType>();
+        }
+        break;
+
+        case AST::Types::TypeSpecifierExpr:
+        {
+            static_cast<TypeSpecifierExpr&>(ast).typeSpecifier = ReadAST<TypeSpecifier>();
+        }
+        break;
+
+        case AST::Types::TernaryExpr:
+        {
+            auto& ternaryExpr = static_cast<TernaryExpr&>(ast);
+            ternaryExpr.condExpr = ReadAST<Expr>();
+            ternaryExpr.thenExpr = ReadAST<Expr>();
+            ternaryExpr.elseExpr = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::BinaryExpr:
+        {
+            auto& binaryExpr = static_cast<BinaryExpr&>(ast);
+            binaryExpr.lhsExpr  = ReadAST<Expr>();
+            binaryExpr.op       = reader_->ReadEnum<BinaryOp>();
+            binaryExpr.rhsExpr  = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::UnaryExpr:
+        {
+            auto& unaryExpr = static_cast<UnaryExpr&>(ast);
+            unaryExpr.op    = reader_->ReadEnum<UnaryOp>();
+            unaryExpr.expr  = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::PostUnaryExpr:
+        {
+            auto& postUnaryExpr = static_cast<PostUnaryExpr&>(ast);
+            postUnaryExpr.expr  = ReadAST<Expr>();
+            postUnaryExpr.op    = reader_->ReadEnum<UnaryOp>();
+        }
+        break;
+
+        case AST::Types::CallExpr:
+        {
+            auto& callExpr = static_cast<CallExpr&>(ast);
+            callExpr.prefixExpr     = ReadAST<Expr>();
+            callExpr.isStatic       = reader_->ReadBool();
+            callExpr.ident          = reader_->ReadString();
+            callExpr.typeDenoter    = ReadTypeDenoter<TypeDenoter>();
+            ReadASTList(callExpr.arguments);
+            callExpr.intrinsic      = reader_->ReadEnum<Intrinsic>();
+        }
+        break;
+
+        case AST::Types::BracketExpr:
+        {
+            static_cast<BracketExpr&>(ast).expr = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::ObjectExpr:
+        {
+            auto& objectExpr = static_cast<ObjectExpr&>(ast);
+            objectExpr.prefixExpr   = ReadAST<Expr>();
+            objectExpr.isStatic     = reader_->ReadBool();
+            objectExpr.ident        = reader_->ReadString();
+        }
+        break;
+
+        case AST::Types::AssignExpr:
+        {
+            auto& assignExpr = static_cast<AssignExpr&>(ast);
+            assignExpr.lvalueExpr   = ReadAST<Expr>();
+            assignExpr.op           = reader_->ReadEnum<AssignOp>();
+            assignExpr.rvalueExpr   = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::ArrayExpr:
+        {
+            auto& arrayExpr = static_cast<ArrayExpr&>(ast);
+            arrayExpr.prefixExpr = ReadAST<Expr>();
+            ReadASTList(arrayExpr.arrayIndices);
+        }
+        break;
+
+        case AST::Types::CastExpr:
+        {
+            auto& castExpr = static_cast<CastExpr&>(ast);
+            castExpr.typeSpecifier  = ReadAST<TypeSpecifier>();
+            castExpr.expr           = ReadAST<Expr>();
+        }
+        break;
+
+        case AST::Types::InitializerExpr:
+        {
+            ReadASTList(static_cast<InitializerExpr&>(ast).exprs);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void ASTSerializer::ReadASTRefs(AST& ast)
+{
+    switch (ast.Type())
+    {
+        case AST::Types::Program:
+        {
+            auto& program = static_cast<Program&>(ast);
+            ReadRef(program.entryPointRef);
+            ReadRef(program.layoutTessControl.patchConstFunctionRef);
+        }
+        break;
+
+        case AST::Types::VarDecl:
+        {
+            auto& varDecl = static_cast<VarDecl&>(ast);
+            ReadRef(varDecl.declStmntRef);
+            ReadRef(varDecl.bufferDeclRef);
+            ReadRef(varDecl.structDeclRef);
+            ReadRef(varDecl.staticMemberVarRef);
+        }
+        break;
+
+        case AST::Types::BufferDecl:
+        {
+            ReadRef(static_cast<BufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::SamplerDecl:
+        {
+            ReadRef(static_cast<SamplerDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::StructDecl:
+        {
+            auto& structDecl = static_cast<StructDecl&>(ast);
+            ReadRef(structDecl.declStmntRef);
+            ReadRef(structDecl.baseStructRef);
+            ReadRef(structDecl.compatibleStructRef);
+            for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+            {
+                auto ident = reader_->ReadString();
+                ReadRef(structDecl.systemValuesRef[ident]);
+            }
+            ReadRefs(structDecl.parentStructDeclRefs);
+            ReadRefs(structDecl.shaderOutputVarDeclRefs);
+        }
+        break;
+
+        case AST::Types::AliasDecl:
+        {
+            ReadRef(static_cast<AliasDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::FunctionDecl:
+        {
+            auto& funcDecl = static_cast<FunctionDecl&>(ast);
+            ReadRefs(funcDecl.inputSemantics.varDeclRefs);
+            ReadRefs(funcDecl.inputSemantics.varDeclRefsSV);
+            ReadRefs(funcDecl.outputSemantics.varDeclRefs);
+            ReadRefs(funcDecl.outputSemantics.varDeclRefsSV);
+            ReadRef(funcDecl.declStmntRef);
+            ReadRef(funcDecl.funcImplRef);
+            ReadRefs(funcDecl.funcForwardDeclRefs);
+            ReadRef(funcDecl.structDeclRef);
+            funcDecl.paramStructs.resize(reader_->Valid() ? reader_->ReadUInt() : 0);
+            for (auto& paramStruct : funcDecl.paramStructs)
+            {
+                ReadRef(paramStruct.expr);
+                ReadRef(paramStruct.varDecl);
+                ReadRef(paramStruct.structDecl);
+            }
+        }
+        break;
+
+        case AST::Types::UniformBufferDecl:
+        {
+            ReadRef(static_cast<UniformBufferDecl&>(ast).declStmntRef);
+        }
+        break;
+
+        case AST::Types::CallExpr:
+        {
+            auto& callExpr = static_cast<CallExpr&>(ast);
+            ReadRef(callExpr.funcDeclRef);
+            ReadRefs(callExpr.defaultParamRefs);
+        }
+        break;
+
+        case AST::Types::ObjectExpr:
+        {
+            ReadRef(static_cast<ObjectExpr&>(ast).symbolRef);
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+TypeDenoterPtr ASTSerializer::ReadTypeDenoterPrimary()
+{
+    const auto index = ReadIndex(loadedTypeDenoters_.size());
+    if (index == 0)
+        return nullptr;
+
+    /* Return previously loaded type denoter to preserve shared type denoters */
+    if (index <= loadedTypeDenoters_.size())
+        return loadedTypeDenoters_[index - 1];
+
+    /* Register type denoter before its sub type denoters are loaded */
+    auto typeDenoter = MakeTypeDenoter(reader_->ReadEnum<TypeDenoter::Types>());
+
+    loadedTypeDenoters_.push_back(typeDenoter);
+    ReadTypeDenoterMembers(*typeDenoter);
+
+    return typeDenoter;
+}
+
+template <typename T>
+std::shared_ptr<T> ASTSerializer::ReadTypeDenoter()
+{
+    return std::static_pointer_cast<T>(ReadTypeDenoterPrimary());
+}
+
+void ASTSerializer::ReadTypeDenoterMembers(TypeDenoter& typeDenoter)
+{
+    if (auto baseTypeDen = typeDenoter.As<BaseTypeDenoter>())
+    {
+        baseTypeDen->dataType = reader_->ReadEnum<DataType>();
+        #ifdef XSC_ENABLE_LANGUAGE_EXT
+        auto src = reader_->ReadString();
+        auto dst = reader_->ReadString();
+        baseTypeDen->vectorSpace.src = VectorSpace::StringType(src.begin(), src.end());
+        baseTypeDen->vectorSpace.dst = VectorSpace::StringType(dst.begin(), dst.end());
+        #endif
+    }
+    else if (auto bufferTypeDen = typeDenoter.As<BufferTypeDenoter>())
+    {
+        bufferTypeDen->bufferType           = reader_->ReadEnum<BufferType>();
+        bufferTypeDen->genericTypeDenoter   = ReadTypeDenoter<TypeDenoter>();
+        bufferTypeDen->genericSize          = reader_->ReadInt();
+        #ifdef XSC_ENABLE_LANGUAGE_EXT
+        bufferTypeDen->layoutFormat         = reader_->ReadEnum<ImageLayoutFormat>();
+        #endif
+    }
+    else if (auto samplerTypeDen = typeDenoter.As<SamplerTypeDenoter>())
+        samplerTypeDen->samplerType = reader_->ReadEnum<SamplerType>();
+    else if (auto structTypeDen = typeDenoter.As<StructTypeDenoter>())
+        structTypeDen->ident = reader_->ReadString();
+    else if (auto aliasTypeDen = typeDenoter.As<AliasTypeDenoter>())
+        aliasTypeDen->ident = reader_->ReadString();
+    else if (auto arrayTypeDen = typeDenoter.As<ArrayTypeDenoter>())
+    {
+        arrayTypeDen->subTypeDenoter = ReadTypeDenoter<TypeDenoter>();
+        ReadASTList(arrayTypeDen->arrayDims);
+    }
+    else if (auto funcTypeDen = typeDenoter.As<FunctionTypeDenoter>())
+        funcTypeDen->ident = reader_->ReadString();
+}
+
+void ASTSerializer::ReadTypeDenoterRefs(TypeDenoter& typeDenoter)
+{
+    if (auto bufferTypeDen = typeDenoter.As<BufferTypeDenoter>())
+        ReadRef(bufferTypeDen->bufferDeclRef);
+    else if (auto samplerTypeDen = typeDenoter.As<SamplerTypeDenoter>())
+        ReadRef(samplerTypeDen->samplerDeclRef);
+    else if (auto structTypeDen = typeDenoter.As<StructTypeDenoter>())
+        ReadRef(structTypeDen->structDeclRef);
+    else if (auto aliasTypeDen = typeDenoter.As<AliasTypeDenoter>())
+        ReadRef(aliasTypeDen->aliasDeclRef);
+    else if (auto funcTypeDen = typeDenoter.As<FunctionTypeDenoter>())
+        ReadRefs(funcTypeDen->funcDeclRefs);
+}
+
+template <typename T>
+void ASTSerializer::ReadRef(T*& ref)
+{
+    const auto index = reader_->ReadUInt();
+    if (index == 0)
+        ref = nullptr;
+    else if (index <= loadedASTs_.size())
+        ref = static_cast<T*>(loadedASTs_[index - 1].get());
+    else
+        throw std::runtime_error("invalid AST reference in serialized program");
+}
+
+template <typename T>
+void ASTSerializer::ReadRefs(std::vector<T*>& refs)
+{
+    refs.resize(reader_->ReadUInt());
+    for (auto& ref : refs)
+        ReadRef(ref);
+}
+
+template <typename T>
+void ASTSerializer::ReadRefs(std::set<T*>& refs)
+{
+    refs.clear();
+    for (auto n = reader_->ReadUInt(); n > 0 && reader_->Valid(); --n)
+    {
+        T* ref = nullptr;
+        ReadRef(ref);
+        refs.insert(ref);
+    }
+}
+
+SourceArea ASTSerializer::ReadSourceArea()
+{
+    const auto row      = reader_->ReadUInt();
+    const auto column   = reader_->ReadUInt();
+
+    /* Read source origin only for its first occurrence */
+    SourceOriginPtr origin;
+
+    const auto originIndex = ReadIndex(loadedOrigins_.size());
+    if (originIndex > loadedOrigins_.size())
+    {
+        origin = std::make_shared<SourceOrigin>();
+        origin->filename    = reader_->ReadString();
+        origin->lineOffset  = reader_->ReadInt();
+        loadedOrigins_.push_back(origin);
+    }
+    else if (originIndex > 0)
+        origin = loadedOrigins_[originIndex - 1];
+
+    const auto length = reader_->ReadUInt();
+    const auto offset = reader_->ReadUInt();
+
+    return SourceArea(SourcePosition(row, column, origin), length, offset);
+}
+
+void ASTSerializer::ReadIdentifier(Identifier& ident)
+{
+    ident.originalSet_  = reader_->ReadBool();
+    ident.original_     = Atom(reader_->ReadString());
+    ident.renamedSet_   = reader_->ReadBool();
+    ident.renamed_      = Atom(reader_->ReadString());
+    ident.counter_      = reader_->ReadInt();
+}
+
+void ASTSerializer::ReadSemantic(IndexedSemantic& semantic)
+{
+    semantic.semantic_      = reader_->ReadEnum<Semantic>();
+    semantic.index_         = reader_->ReadInt();
+    semantic.userDefined_   = reader_->ReadString();
+}
+
+Variant ASTSerializer::ReadVariant()
+{
+    switch (reader_->ReadEnum<Variant::Types>())
+    {
+        case Variant::Types::Undefined:
+            return Variant();
+        case Variant::Types::Bool:
+            return Variant(reader_->ReadBool());
+        case Variant::Types::Int:
+            return Variant(static_cast<Variant::IntType>(reader_->ReadUInt64()));
+        case Variant::Types::Real:
+            return Variant(reader_->ReadDouble());
+        case Variant::Types::Array:
+        {
+            std::vector<Variant> subValues;
+            reader_->ReadList(subValues, [this](Variant& subValue) { subValue = ReadVariant(); });
+            return Variant(std::move(subValues));
+        }
+    }
+    throw std::runtime_error("invalid variant in serialized program");
+}
+
+std::uint32_t ASTSerializer::ReadIndex(std::size_t tableSize)
+{
+    const auto index = reader_->ReadUInt();
+    if (index > tableSize + 1)
+        throw std::runtime_error("invalid index in serialized program");
+    return index;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,155 @@
+/*
+ * ASTSerializer.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_AST_SERIALIZER_H
+#define XSC_AST_SERIALIZER_H
+
+
+#include "AST.h"
+#include "TypeDenoter.h"
+#include "BinaryStream.h"
+#include <unordered_map>
+#include <vector>
+#include <set>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+AST binary serialization class.
+Saves an entire program with all its AST nodes, type denoters, source areas, and references (e.g. 'symbolRef', 'declStmntRef') in a versioned binary format.
+Shared AST nodes and type denoters are stored only once. References to nodes outside of the saved program are loaded as null.
+The buffered type denoters of all typed AST nodes are stored as well, since they may depend on the context of their derivation (e.g. for initializer lists).
+The pre-processed source code of the program is not stored. Identifiers are interned in the active atom table of the loading thread.
+*/
+class ASTSerializer
+{
+
+    public:
+
+        // Returns the binary representation of the specified program.
+        std::string Save(const Program& program);
+
+        /*
+        Loads a program from the specified binary data, which is only read during this call (e.g. from a memory mapped file).
+        Returns null if the data is invalid or was saved with another format version.
+        */
+        ProgramPtr Load(const char* data, std::size_t size);
+
+        // Loads a program from the specified binary data.
+        ProgramPtr Load(const std::string& data);
+
+        // Returns the number of AST nodes that have been saved or loaded by the last call.
+        inline std::size_t NumNodes() const
+        {
+            return numNodes_;
+        }
+
+    private:
+
+        /* === Functions === */
+
+        /* --- Saving --- */
+
+        void WriteAST(const AST* ast);
+
+        template <typename T>
+        void WriteASTList(const std::vector<std::shared_ptr<T>>& astList);
+
+        void WriteASTMembers(const AST& ast);
+        void WriteASTRefs(const AST& ast);
+
+        void WriteTypeDenoter(const TypeDenoter* typeDenoter);
+        void WriteTypeDenoterMembers(const TypeDenoter& typeDenoter);
+        void WriteTypeDenoterRefs(const TypeDenoter& typeDenoter);
+
+        // Writes the index of the referenced AST node, or zero if the node is null or has not been saved.
+        void WriteRef(const AST* ref);
+
+        template <typename T>
+        void WriteRefs(const std::vector<T*>& refs);
+
+        template <typename T>
+        void WriteRefs(const std::set<T*>& refs);
+
+        void WriteSourceArea(const SourceArea& area);
+        void WriteIdentifier(const Identifier& ident);
+        void WriteSemantic(const IndexedSemantic& semantic);
+        void WriteVariant(const Variant& value);
+
+        /* --- Loading --- */
+
+        ASTPtr ReadASTPrimary();
+
+        template <typename T>
+        std::shared_ptr<T> ReadAST();
+
+        template <typename T>
+        void ReadASTList(std::vector<std::shared_ptr<T>>& astList);
+
+        void ReadASTMembers(AST& ast);
+        void ReadASTRefs(AST& ast);
+
+        TypeDenoterPtr ReadTypeDenoterPrimary();
+
+        template <typename T>
+        std::shared_ptr<T> ReadTypeDenoter();
+
+        void ReadTypeDenoterMembers(TypeDenoter& typeDenoter);
+        void ReadTypeDenoterRefs(TypeDenoter& typeDenoter);
+
+        template <typename T>
+        void ReadRef(T*& ref);
+
+        template <typename T>
+        void ReadRefs(std::vector<T*>& refs);
+
+        template <typename T>
+        void ReadRefs(std::set<T*>& refs);
+
+        SourceArea ReadSourceArea();
+        void ReadIdentifier(Identifier& ident);
+        void ReadSemantic(IndexedSemantic& semantic);
+        Variant ReadVariant();
+
+        // Reads an index of the specified table, which is only valid if it is not greater than the table size plus one (for a new entry).
+        std::uint32_t ReadIndex(std::size_t tableSize);
+
+        /* === Members === */
+
+        std::size_t                                             numNodes_       = 0;
+
+        BinaryWriter*                                           writer_         = nullptr;
+        BinaryReader*                                           reader_         = nullptr;
+
+        std::unordered_map<const AST*, std::uint32_t>           astIndices_;
+        std::unordered_map<const TypeDenoter*, std::uint32_t>   typeDenoterIndices_;
+        std::unordered_map<const SourceOrigin*, std::uint32_t>  originIndices_;
+
+        std::vector<const AST*>                                 savedASTs_;
+        std::vector<const TypeDenoter*>                         savedTypeDenoters_;
+
+        std::vector<ASTPtr>                                     loadedASTs_;
+        std::vector<TypeDenoterPtr>                             loadedTypeDenoters_;
+        std::vector<SourceOriginPtr>                            loadedOrigins_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,97 @@
+/*
+ * Atom.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "Atom.h"
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Returns the entry of the empty atom.
+static const std::pair<const std::string, std::size_t>* EmptyAtomEntry()
+{
+    static const std::pair<const std::string, std::size_t> entry { std::string(), 0 };
+    return &entry;
+}
+
+// Active atom table of the current thread, or null to use the default atom table.
+thread_local static AtomTable* g_activeAtomTable = nullptr;
+
+
+/*
+ * Atom class
+ */
+
+Atom::Atom() :
+    entry_ { EmptyAtomEntry() }
+{
+}
+
+Atom::Atom(const std::string& s) :
+    Atom { AtomTable::Active().Intern(s) }
+{
+}
+
+Atom::Atom(const Entry* entry) :
+    entry_ { entry }
+{
+}
+
+
+/*
+ * AtomTable class
+ */
+
+Atom AtomTable::Intern(const std::string& s)
+{
+    if (s.empty())
+        return Atom();
+
+    /* Insert new string with the next handle (handle 0 is reserved for the empty atom) */
+    auto it = entries_.find(s);
+    if (it == entries_.end())
+        it = entries_.emplace(s, entries_.size() + 1).first;
+
+    return Atom(&(*it));
+}
+
+AtomTable& AtomTable::Active()
+{
+    if (g_activeAtomTable)
+        return *g_activeAtomTable;
+
+    thread_local static AtomTable defaultAtomTable;
+    return defaultAtomTable;
+}
+
+
+/*
+ * AtomTableScope class
+ */
+
+AtomTableScope::AtomTableScope(AtomTable& atomTable) :
+    prevAtomTable_ { g_activeAtomTable }
+{
+    g_activeAtomTable = &atomTable;
+}
+
+AtomTableScope::~AtomTableScope()
+{
+    g_activeAtomTable = prevAtomTable_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
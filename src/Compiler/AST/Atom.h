@@ -0,0 +1,190 @@
+/*
+ * Atom.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_ATOM_H
+#define XSC_ATOM_H
+
+
+#include <string>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+class AtomTable;
+
+/*
+Interned string, which is identified by a small integer within its atom table.
+Two atoms of the same atom table are equal if and only if their handles are equal,
+so atoms must not be compared with atoms of another atom table.
+*/
+class Atom
+{
+
+    public:
+
+        // Constructs the empty atom, which is shared by all atom tables.
+        Atom();
+
+        // Interns the specified string in the active atom table of the current thread (see AtomTable::Active).
+        Atom(const std::string& s);
+
+        // Returns the string of this atom.
+        inline const std::string& Str() const
+        {
+            return entry_->first;
+        }
+
+        // Operator shortcut for 'Str()'.
+        inline operator const std::string& () const
+        {
+            return Str();
+        }
+
+        // Returns the handle of this atom within its atom table (0 for the empty atom).
+        inline std::size_t Id() const
+        {
+            return entry_->second;
+        }
+
+        // Returns true if this is the empty atom.
+        inline bool Empty() const
+        {
+            return (Id() == 0);
+        }
+
+    private:
+
+        friend class AtomTable;
+
+        using Entry = std::pair<const std::string, std::size_t>;
+
+        Atom(const Entry* entry);
+
+        const Entry* entry_ = nullptr;
+
+};
+
+inline bool operator == (const Atom& lhs, const Atom& rhs)
+{
+    return (&lhs.Str() == &rhs.Str());
+}
+
+inline bool operator != (const Atom& lhs, const Atom& rhs)
+{
+    return (&lhs.Str() != &rhs.Str());
+}
+
+inline bool operator < (const Atom& lhs, const Atom& rhs)
+{
+    return (lhs.Id() < rhs.Id());
+}
+
+inline bool operator == (const Atom& lhs, const std::string& rhs)
+{
+    return (lhs.Str() == rhs);
+}
+
+inline bool operator == (const std::string& lhs, const Atom& rhs)
+{
+    return (lhs == rhs.Str());
+}
+
+inline bool operator != (const Atom& lhs, const std::string& rhs)
+{
+    return (lhs.Str() != rhs);
+}
+
+inline bool operator != (const std::string& lhs, const Atom& rhs)
+{
+    return (lhs != rhs.Str());
+}
+
+/*
+Table of interned strings (atoms). Each string is stored only once, and all tokens and identifiers refer to it by an atom.
+The atom table of a compiler driver is cleared at the beginning of each compilation, since no atom outlives a compilation.
+*/
+class AtomTable
+{
+
+    public:
+
+        AtomTable() = default;
+
+        AtomTable(const AtomTable&) = delete;
+        AtomTable& operator = (const AtomTable&) = delete;
+
+        // Returns the atom of the specified string, and interns the string if it is not already in this table.
+        Atom Intern(const std::string& s);
+
+        // Removes all atoms from this table. All atoms of this table (except the empty atom) become invalid.
+        inline void Clear()
+        {
+            entries_.clear();
+        }
+
+        // Returns the number of atoms in this table (excluding the empty atom).
+        inline std::size_t Size() const
+        {
+            return entries_.size();
+        }
+
+        // Returns the active atom table of the current thread (see AtomTableScope), or the default atom table of the current thread.
+        static AtomTable& Active();
+
+    private:
+
+        std::unordered_map<std::string, std::size_t> entries_;
+
+};
+
+// Activates the specified atom table for the current thread during the lifetime of this scope.
+class AtomTableScope
+{
+
+    public:
+
+        AtomTableScope(AtomTable& atomTable);
+        ~AtomTableScope();
+
+        AtomTableScope(const AtomTableScope&) = delete;
+        AtomTableScope& operator = (const AtomTableScope&) = delete;
+
+    private:
+
+        AtomTable* prevAtomTable_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+namespace std
+{
+
+template <>
+struct hash<Xsc::Atom>
+{
+    std::size_t operator () (const Xsc::Atom& atom) const
+    {
+        return std::hash<std::size_t>()(atom.Id());
+    }
+};
+
+} // /namespace std
+
+
+#endif
+
+
+
+// ================================================================================
@@ -15,25 +15,12 @@ namespace Xsc
 
 Identifier& Identifier::operator = (const Identifier& rhs)
 {
-    *this = rhs.Final();
-    return *this;
+    return Assign(rhs.FinalAtom());
 }
 
 Identifier& Identifier::operator = (const std::string& s)
 {
-    if (!originalSet_)
-    {
-        /* Set original identifier for the first time */
-        originalSet_ = true;
-        original_ = s;
-    }
-    else
-    {
-        /* Set renamed identifier */
-        renamedSet_ = true;
-        renamed_ = s;
-    }
-    return *this;
+    return Assign(Atom(s));
 }
 
 Identifier& Identifier::AppendPrefix(const std::string& prefix)
@@ -68,11 +55,38 @@ Identifier& Identifier::RemovePrefix(const std::string& prefix)
 }
 
 const std::string& Identifier::Final() const
+{
+    return FinalAtom().Str();
+}
+
+const Atom& Identifier::FinalAtom() const
 {
     return (renamedSet_ ? renamed_ : original_);
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+Identifier& Identifier::Assign(const Atom& atom)
+{
+    if (!originalSet_)
+    {
+        /* Set original identifier for the first time */
+        originalSet_ = true;
+        original_ = atom;
+    }
+    else
+    {
+        /* Set renamed identifier */
+        renamedSet_ = true;
+        renamed_ = atom;
+    }
+    return *this;
+}
+
+
 } // /namespace Xsc
 
 
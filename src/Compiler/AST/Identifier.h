@@ -9,6 +9,7 @@
 #define XSC_IDENTIFIER_H
 
 
+#include "Atom.h"
 #include <string>
 
 
@@ -49,31 +50,45 @@ class Identifier
             return Final().empty();
         }
 
+        // Returns the final identifier as atom.
+        const Atom& FinalAtom() const;
+
         // Operator shortcut for 'Final()'.
         inline operator const std::string& () const
         {
             return Final();
         }
 
+        // Operator shortcut for 'FinalAtom()'.
+        inline operator const Atom& () const
+        {
+            return FinalAtom();
+        }
+
         // Returns the original identifier.
         inline const std::string& Original() const
         {
-            return original_;
+            return original_.Str();
         }
 
         // Returns true if this identifier is renamed.
         inline bool IsRenamed() const
         {
-            return !renamed_.empty();
+            return !renamed_.Empty();
         }
 
     private:
 
+        friend class ASTSerializer;
+
+        // Sets the original identifier for the first time, or the renamed identifier otherwise.
+        Identifier& Assign(const Atom& atom);
+
         bool        originalSet_    = false;
-        std::string original_;
+        Atom        original_;
 
         bool        renamedSet_     = false;
-        std::string renamed_;
+        Atom        renamed_;
 
         int         counter_        = 0;
 
@@ -82,7 +97,17 @@ class Identifier
 
 inline bool operator == (const Identifier& lhs, const Identifier& rhs)
 {
-    return (std::string(lhs) == std::string(rhs));
+    return (lhs.FinalAtom() == rhs.FinalAtom());
+}
+
+inline bool operator == (const Atom& lhs, const Identifier& rhs)
+{
+    return (lhs == rhs.FinalAtom());
+}
+
+inline bool operator == (const Identifier& lhs, const Atom& rhs)
+{
+    return (lhs.FinalAtom() == rhs);
 }
 
 inline bool operator == (const std::string& lhs, const Identifier& rhs)
@@ -98,7 +123,17 @@ inline bool operator == (const Identifier& lhs, const std::string& rhs)
 
 inline bool operator != (const Identifier& lhs, const Identifier& rhs)
 {
-    return (std::string(lhs) != std::string(rhs));
+    return (lhs.FinalAtom() != rhs.FinalAtom());
+}
+
+inline bool operator != (const Atom& lhs, const Identifier& rhs)
+{
+    return (lhs != rhs.FinalAtom());
+}
+
+inline bool operator != (const Identifier& lhs, const Atom& rhs)
+{
+    return (lhs.FinalAtom() != rhs);
 }
 
 inline bool operator != (const std::string& lhs, const Identifier& rhs)
@@ -34,9 +34,9 @@ Token::Token(const SourcePosition& pos, const Types type, const std::string& spe
 }
 
 Token::Token(const SourcePosition& pos, const Types type, std::string&& spell) :
-    type_  { type             },
-    pos_   { pos              },
-    spell_ { std::move(spell) }
+    type_  { type  },
+    pos_   { pos   },
+    spell_ { spell }
 {
 }
 
@@ -10,9 +10,10 @@
 
 
 #include "SourceArea.h"
+#include "Atom.h"
+#include "PerfectHashMap.h"
 #include <string>
 #include <memory>
-#include <map>
 
 
 namespace Xsc
@@ -175,6 +176,12 @@ class Token
 
         // Returns the token spelling.
         inline const std::string& Spell() const
+        {
+            return spell_.Str();
+        }
+
+        // Returns the token spelling as atom.
+        inline const Atom& SpellAtom() const
         {
             return spell_;
         }
@@ -183,15 +190,15 @@ class Token
 
         Types           type_;  // Type of this token.
         SourcePosition  pos_;   // Source area of this token.
-        std::string     spell_; // Token spelling.
+        Atom            spell_; // Token spelling (interned in the active atom table).
 
 };
 
 // Token shared pointer type.
 using TokenPtr = std::shared_ptr<Token>;
 
-// Keyword-to-Token map type.
-using KeywordMapType = std::map<std::string, Token::Types>;
+// Keyword-to-Token map type (generated with a perfect hash function, since the scanners look up every identifier).
+using KeywordMapType = PerfectHashMap<Token::Types>;
 
 
 } // /namespace Xsc
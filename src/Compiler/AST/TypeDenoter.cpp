@@ -317,7 +317,7 @@ TypeDenoterPtr TypeDenoter::AsArray(const std::vector<ArrayDimensionPtr>& arrayD
     if (arrayDims.empty())
         return shared_from_this();
     else
-        return std::make_shared<ArrayTypeDenoter>(shared_from_this(), arrayDims);
+        return MakeShared<ArrayTypeDenoter>(shared_from_this(), arrayDims);
 }
 
 TypeDenoter* TypeDenoter::FetchSubTypeDenoter() const
@@ -340,7 +340,7 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndScalar(BaseTypeDenoter* lhsT
 {
     /* Return scalar type with highest order data type */
     auto commonType = HighestOrderDataType(lhsTypeDen->dataType, rhsTypeDen->dataType);
-    return std::make_shared<BaseTypeDenoter>(commonType);
+    return BaseTypeDenoter::GetCanonical(commonType);
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterScalarAndVector(BaseTypeDenoter* lhsTypeDen, BaseTypeDenoter* rhsTypeDen, bool useMinDimension)
@@ -349,13 +349,13 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndVector(BaseTypeDenoter* lhsT
     if (useMinDimension)
     {
         /* Return scalar type (minimal dimension) */
-        return std::make_shared<BaseTypeDenoter>(commonType);
+        return BaseTypeDenoter::GetCanonical(commonType);
     }
     else
     {
         /* Return vector type */
         auto rhsDim = VectorTypeDim(rhsTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, rhsDim));
+        return BaseTypeDenoter::GetCanonical(VectorDataType(commonType, rhsDim));
     }
 }
 
@@ -365,13 +365,13 @@ static TypeDenoterPtr FindCommonTypeDenoterScalarAndMatrix(BaseTypeDenoter* lhsT
     if (useMinDimension)
     {
         /* Return scalar type (minimal dimension) */
-        return std::make_shared<BaseTypeDenoter>(commonType);
+        return BaseTypeDenoter::GetCanonical(commonType);
     }
     else
     {
         /* Return matrix type */
         auto rhsDim = MatrixTypeDim(rhsTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(MatrixDataType(commonType, rhsDim.first, rhsDim.second));
+        return BaseTypeDenoter::GetCanonical(MatrixDataType(commonType, rhsDim.first, rhsDim.second));
     }
 }
 
@@ -384,7 +384,7 @@ static TypeDenoterPtr FindCommonTypeDenoterVectorAndVector(BaseTypeDenoter* lhsT
     auto rhsDim = VectorTypeDim(rhsTypeDen->dataType);
     auto commonDim = std::min(lhsDim, rhsDim);
 
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, commonDim));
+    return BaseTypeDenoter::GetCanonical(VectorDataType(commonType, commonDim));
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterVectorAndMatrix(BaseTypeDenoter* lhsTypeDen, BaseTypeDenoter* rhsTypeDen, bool rowVector)
@@ -395,7 +395,7 @@ static TypeDenoterPtr FindCommonTypeDenoterVectorAndMatrix(BaseTypeDenoter* lhsT
     auto matrixDim = MatrixTypeDim(rhsTypeDen->dataType);
     auto commonDim = (rowVector ? matrixDim.first : matrixDim.second);
 
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(commonType, commonDim));
+    return BaseTypeDenoter::GetCanonical(VectorDataType(commonType, commonDim));
 }
 
 static TypeDenoterPtr FindCommonTypeDenoterAnyAndAny(TypeDenoter* lhsTypeDen, TypeDenoter* rhsTypeDen)
@@ -485,12 +485,12 @@ BaseTypeDenoterPtr TypeDenoter::MakeBoolTypeWithDimensionOf(const TypeDenoter& t
     {
         /* Make vector boolean type denoter with dimension of the specified type denoter */
         auto vecBoolType = VectorDataType(DataType::Bool, VectorTypeDim(baseTypeDen->dataType));
-        return std::make_shared<BaseTypeDenoter>(vecBoolType);
+        return BaseTypeDenoter::GetCanonical(vecBoolType);
     }
     else
     {
         /* Make single boolean type denoter */
-        return std::make_shared<BaseTypeDenoter>(DataType::Bool);
+        return BaseTypeDenoter::GetCanonical(DataType::Bool);
     }
 }
 
@@ -536,7 +536,14 @@ std::string VoidTypeDenoter::ToString() const
 
 TypeDenoterPtr VoidTypeDenoter::Copy() const
 {
-    return std::make_shared<VoidTypeDenoter>();
+    return MakeShared<VoidTypeDenoter>();
+}
+
+VoidTypeDenoterPtr VoidTypeDenoter::GetCanonical()
+{
+    /* Canonical instances are allocated on the heap, since they outlive all memory arenas */
+    static const VoidTypeDenoterPtr canonicalTypeDen = std::make_shared<VoidTypeDenoter>();
+    return canonicalTypeDen;
 }
 
 bool VoidTypeDenoter::IsCastableTo(const TypeDenoter& targetType) const
@@ -560,7 +567,7 @@ std::string NullTypeDenoter::ToString() const
 
 TypeDenoterPtr NullTypeDenoter::Copy() const
 {
-    return std::make_shared<NullTypeDenoter>();
+    return MakeShared<NullTypeDenoter>();
 }
 
 bool NullTypeDenoter::IsCastableTo(const TypeDenoter& targetType) const
@@ -573,6 +580,24 @@ bool NullTypeDenoter::IsCastableTo(const TypeDenoter& targetType) const
 
 /* ----- BaseTypeDenoter ----- */
 
+#ifndef XSC_ENABLE_LANGUAGE_EXT
+
+// Generates the table of canonical base type denoters, one for each data type.
+static std::vector<BaseTypeDenoterPtr> GenerateCanonicalBaseTypeDenoters()
+{
+    std::vector<BaseTypeDenoterPtr> typeDens;
+
+    const auto numDataTypes = static_cast<std::size_t>(DataType::Double4x4) + 1;
+    typeDens.reserve(numDataTypes);
+
+    for (std::size_t i = 0; i < numDataTypes; ++i)
+        typeDens.push_back(std::make_shared<BaseTypeDenoter>(static_cast<DataType>(i)));
+
+    return typeDens;
+}
+
+#endif
+
 BaseTypeDenoter::BaseTypeDenoter(const DataType dataType) :
     dataType { dataType }
 {
@@ -590,11 +615,36 @@ std::string BaseTypeDenoter::ToString() const
 
 TypeDenoterPtr BaseTypeDenoter::Copy() const
 {
-    return std::make_shared<BaseTypeDenoter>(dataType);
+    return MakeShared<BaseTypeDenoter>(dataType);
+}
+
+BaseTypeDenoterPtr BaseTypeDenoter::GetCanonical(const DataType dataType)
+{
+    #ifdef XSC_ENABLE_LANGUAGE_EXT
+
+    /* Base type denoters are not immutable with language extensions (due to their vector space) */
+    return MakeShared<BaseTypeDenoter>(dataType);
+
+    #else
+
+    /* Canonical instances are allocated on the heap, since they outlive all memory arenas */
+    static const std::vector<BaseTypeDenoterPtr> canonicalTypeDens = GenerateCanonicalBaseTypeDenoters();
+
+    const auto idx = static_cast<std::size_t>(dataType);
+    if (idx < canonicalTypeDens.size())
+        return canonicalTypeDens[idx];
+    else
+        return MakeShared<BaseTypeDenoter>(dataType);
+
+    #endif
 }
 
 bool BaseTypeDenoter::Equals(const TypeDenoter& rhs, const Flags& /*compareFlags*/) const
 {
+    /* Shared (canonical) type denoters are trivially equal */
+    if (this == &rhs)
+        return true;
+
     /* Compare data types of both type denoters */
     if (auto rhsBaseTypeDen = rhs.As<BaseTypeDenoter>())
         return (dataType == rhsBaseTypeDen->dataType);
@@ -648,7 +698,7 @@ TypeDenoterPtr BaseTypeDenoter::GetSubObject(const std::string& ident, const AST
     try
     {
         auto subscriptDataType = SubscriptDataType(dataType, ident);
-        auto subTypeDen = std::make_shared<BaseTypeDenoter>(subscriptDataType);
+        auto subTypeDen = BaseTypeDenoter::GetCanonical(subscriptDataType);
 
         #ifdef XSC_ENABLE_LANGUAGE_EXT
         subTypeDen->vectorSpace = vectorSpace;
@@ -673,7 +723,7 @@ TypeDenoterPtr BaseTypeDenoter::GetSubArray(const std::size_t numArrayIndices, c
             if (numArrayIndices > 1)
                 RuntimeErr(R_TooManyArrayDimensions(R_VectorTypeDen), ast);
             else
-                return std::make_shared<BaseTypeDenoter>(BaseDataType(dataType));
+                return BaseTypeDenoter::GetCanonical(BaseDataType(dataType));
         }
         else if (IsMatrixType(dataType))
         {
@@ -681,10 +731,10 @@ TypeDenoterPtr BaseTypeDenoter::GetSubArray(const std::size_t numArrayIndices, c
             if (numArrayIndices == 1)
             {
                 auto matrixDim = MatrixTypeDim(dataType);
-                return std::make_shared<BaseTypeDenoter>(VectorDataType(BaseDataType(dataType), matrixDim.second));
+                return BaseTypeDenoter::GetCanonical(VectorDataType(BaseDataType(dataType), matrixDim.second));
             }
             else if (numArrayIndices == 2)
-                return std::make_shared<BaseTypeDenoter>(BaseDataType(dataType));
+                return BaseTypeDenoter::GetCanonical(BaseDataType(dataType));
             else if (numArrayIndices > 2)
                 RuntimeErr(R_TooManyArrayDimensions(R_MatrixTypeDen), ast);
         }
@@ -736,7 +786,7 @@ std::string BufferTypeDenoter::ToString() const
 
 TypeDenoterPtr BufferTypeDenoter::Copy() const
 {
-    auto copy = std::make_shared<BufferTypeDenoter>();
+    auto copy = MakeShared<BufferTypeDenoter>();
     {
         copy->bufferType            = bufferType;
         copy->genericTypeDenoter    = genericTypeDenoter;
@@ -797,7 +847,7 @@ TypeDenoterPtr BufferTypeDenoter::GetGenericTypeDenoter() const
     if (genericTypeDenoter)
         return genericTypeDenoter;
     else
-        return std::make_shared<BaseTypeDenoter>(DataType::Float4);
+        return BaseTypeDenoter::GetCanonical(DataType::Float4);
 }
 
 AST* BufferTypeDenoter::SymbolRef() const
@@ -832,7 +882,7 @@ std::string SamplerTypeDenoter::ToString() const
 
 TypeDenoterPtr SamplerTypeDenoter::Copy() const
 {
-    auto copy = std::make_shared<SamplerTypeDenoter>();
+    auto copy = MakeShared<SamplerTypeDenoter>();
     {
         copy->samplerType       = samplerType;
         copy->samplerDeclRef    = samplerDeclRef;
@@ -880,7 +930,7 @@ std::string StructTypeDenoter::ToString() const
 
 TypeDenoterPtr StructTypeDenoter::Copy() const
 {
-    auto copy = std::make_shared<StructTypeDenoter>();
+    auto copy = MakeShared<StructTypeDenoter>();
     {
         copy->ident         = ident;
         copy->structDeclRef = structDeclRef;
@@ -995,7 +1045,7 @@ std::string AliasTypeDenoter::ToString() const
 
 TypeDenoterPtr AliasTypeDenoter::Copy() const
 {
-    auto copy = std::make_shared<AliasTypeDenoter>();
+    auto copy = MakeShared<AliasTypeDenoter>();
     {
         copy->ident         = ident;
         copy->aliasDeclRef  = aliasDeclRef;
@@ -1111,7 +1161,7 @@ std::string ArrayTypeDenoter::ToString() const
 
 TypeDenoterPtr ArrayTypeDenoter::Copy() const
 {
-    return std::make_shared<ArrayTypeDenoter>(subTypeDenoter, arrayDims);
+    return MakeShared<ArrayTypeDenoter>(subTypeDenoter, arrayDims);
 }
 
 TypeDenoterPtr ArrayTypeDenoter::GetSubArray(const std::size_t numArrayIndices, const AST* ast)
@@ -1129,7 +1179,7 @@ TypeDenoterPtr ArrayTypeDenoter::GetSubArray(const std::size_t numArrayIndices,
         /* Make new array type denoter with less dimensions */
         auto subArrayDims = arrayDims;
         subArrayDims.resize(numDims - numArrayIndices);
-        return std::make_shared<ArrayTypeDenoter>(subTypeDenoter, subArrayDims);
+        return MakeShared<ArrayTypeDenoter>(subTypeDenoter, subArrayDims);
     }
 
     /* Get sub type denoter with next array index */
@@ -1227,7 +1277,7 @@ TypeDenoterPtr ArrayTypeDenoter::AsArray(const std::vector<ArrayDimensionPtr>& s
     if (subArrayDims.empty())
         return shared_from_this();
     else
-        return std::make_shared<ArrayTypeDenoter>(subTypeDenoter, arrayDims, subArrayDims);
+        return MakeShared<ArrayTypeDenoter>(subTypeDenoter, arrayDims, subArrayDims);
 }
 
 TypeDenoter* ArrayTypeDenoter::FetchSubTypeDenoter() const
@@ -1298,7 +1348,7 @@ std::string FunctionTypeDenoter::ToString() const
 
 TypeDenoterPtr FunctionTypeDenoter::Copy() const
 {
-    return std::make_shared<FunctionTypeDenoter>(ident, funcDeclRefs);
+    return MakeShared<FunctionTypeDenoter>(ident, funcDeclRefs);
 }
 
 bool FunctionTypeDenoter::Equals(const TypeDenoter& rhs, const Flags& compareFlags) const
@@ -13,6 +13,7 @@
 #include "ASTEnums.h"
 #include "Flags.h"
 #include "CiString.h"
+#include "MemoryArena.h"
 #include <memory>
 #include <string>
 
@@ -256,6 +257,9 @@ struct VoidTypeDenoter : public TypeDenoter
 
     // Returns always false, since void type can not be casted to anything.
     bool IsCastableTo(const TypeDenoter& targetType) const override;
+
+    // Returns the canonical void type denoter, which is shared by all users and must not be modified.
+    static VoidTypeDenoterPtr GetCanonical();
 };
 
 // Null type denoter.
@@ -289,6 +293,13 @@ struct BaseTypeDenoter : public TypeDenoter
     TypeDenoterPtr GetSubObject(const std::string& ident, const AST* ast = nullptr) override;
     TypeDenoterPtr GetSubArray(const std::size_t numArrayIndices, const AST* ast = nullptr) override;
 
+    /*
+    Returns the canonical base type denoter for the specified data type, which is shared by all structurally equal base types.
+    The returned instance must not be modified; use 'Copy' or 'MakeShared' for a modifiable type denoter.
+    With language extensions enabled, this always returns a new instance (see 'vectorSpace').
+    */
+    static BaseTypeDenoterPtr GetCanonical(const DataType dataType);
+
     DataType    dataType    = DataType::Undefined;  // Data type of this base type denoter. By default DataType::Undefined.
 
     #ifdef XSC_ENABLE_LANGUAGE_EXT
@@ -0,0 +1,388 @@
+/*
+ * ConstExprProgram.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ConstExprProgram.h"
+#include "AST.h"
+#include "Helper.h"
+#include "Exception.h"
+#include "ReportIdents.h"
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Evaluates the unary operator like the ExprEvaluator. Only literals of defined types are compiled, so all values are defined.
+static Variant EvaluateUnaryOp(const UnaryOp op, Variant rhs)
+{
+    switch (op)
+    {
+        case UnaryOp::LogicalNot:
+            return (!rhs.ToBool());
+        case UnaryOp::Not:
+            return (~rhs);
+        case UnaryOp::Negate:
+            return (-rhs);
+        case UnaryOp::Inc:
+            return (++rhs);
+        case UnaryOp::Dec:
+            return (--rhs);
+        default:
+            return rhs;
+    }
+}
+
+// Evaluates the binary operator like the ExprEvaluator (logical AND and OR are compiled into jumps).
+static Variant EvaluateBinaryOp(const BinaryOp op, const Variant& lhs, const Variant& rhs)
+{
+    switch (op)
+    {
+        case BinaryOp::Or:
+            return (lhs | rhs);
+        case BinaryOp::Xor:
+            return (lhs ^ rhs);
+        case BinaryOp::And:
+            return (lhs & rhs);
+        case BinaryOp::LShift:
+            return (lhs << rhs);
+        case BinaryOp::RShift:
+            return (lhs >> rhs);
+        case BinaryOp::Add:
+            return (lhs + rhs);
+        case BinaryOp::Sub:
+            return (lhs - rhs);
+        case BinaryOp::Mul:
+            return (lhs * rhs);
+        case BinaryOp::Div:
+            if (lhs.Type() == Variant::Types::Int && rhs.Int() == 0)
+                RuntimeErr(R_IllegalExprInConstExpr(R_DivisionByZero));
+            return (lhs / rhs);
+        case BinaryOp::Mod:
+            if (lhs.Type() == Variant::Types::Int && rhs.Int() == 0)
+                RuntimeErr(R_IllegalExprInConstExpr(R_DivisionByZero));
+            return (lhs % rhs);
+        case BinaryOp::Equal:
+            return (lhs == rhs);
+        case BinaryOp::NotEqual:
+            return (lhs != rhs);
+        case BinaryOp::Less:
+            return (lhs < rhs);
+        case BinaryOp::Greater:
+            return (lhs > rhs);
+        case BinaryOp::LessEqual:
+            return (lhs <= rhs);
+        case BinaryOp::GreaterEqual:
+            return (lhs >= rhs);
+        default:
+            return {};
+    }
+}
+
+
+/*
+ * ConstExprProgram class
+ */
+
+bool ConstExprProgram::Compile(Expr& expr)
+{
+    /* Reset previous program */
+    instructions_.clear();
+    constants_.clear();
+
+    maxStackSize_   = 0;
+    stackSize_      = 0;
+    failed_         = false;
+
+    /* Visit expression AST */
+    Visit(&expr);
+
+    /* Discard incomplete program */
+    if (failed_ || stackSize_ != 1)
+    {
+        instructions_.clear();
+        constants_.clear();
+        return false;
+    }
+
+    return true;
+}
+
+Variant ConstExprProgram::Execute(std::vector<Variant>& stack) const
+{
+    if (!IsValid())
+        RuntimeErr(R_StackUnderflow(R_ExprEvaluator));
+
+    stack.clear();
+    stack.reserve(maxStackSize_);
+
+    for (std::size_t pc = 0, n = instructions_.size(); pc < n;)
+    {
+        const auto& instr = instructions_[pc++];
+
+        switch (instr.opcode)
+        {
+            case Opcodes::Push:
+            {
+                stack.push_back(constants_[instr.operand]);
+            }
+            break;
+
+            case Opcodes::UnaryOp:
+            {
+                stack.back() = EvaluateUnaryOp(static_cast<UnaryOp>(instr.op), stack.back());
+            }
+            break;
+
+            case Opcodes::BinaryOp:
+            {
+                const auto rhs = std::move(stack.back());
+                stack.pop_back();
+                stack.back() = EvaluateBinaryOp(static_cast<BinaryOp>(instr.op), stack.back(), rhs);
+            }
+            break;
+
+            case Opcodes::ToBool:
+            {
+                stack.back() = stack.back().ToBool();
+            }
+            break;
+
+            case Opcodes::LogicalAnd:
+            {
+                if (!stack.back().ToBool())
+                {
+                    stack.back() = false;
+                    pc = instr.operand;
+                }
+                else
+                    stack.pop_back();
+            }
+            break;
+
+            case Opcodes::LogicalOr:
+            {
+                if (stack.back().ToBool())
+                {
+                    stack.back() = true;
+                    pc = instr.operand;
+                }
+                else
+                    stack.pop_back();
+            }
+            break;
+
+            case Opcodes::JumpIfFalse:
+            {
+                const auto cond = stack.back().ToBool();
+                stack.pop_back();
+                if (!cond)
+                    pc = instr.operand;
+            }
+            break;
+
+            case Opcodes::Jump:
+            {
+                pc = instr.operand;
+            }
+            break;
+        }
+    }
+
+    return stack.back();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ConstExprProgram::Emit(const Opcodes opcode, std::uint8_t op, std::uint32_t operand)
+{
+    instructions_.push_back({ opcode, op, operand });
+}
+
+std::size_t ConstExprProgram::EmitJump(const Opcodes opcode)
+{
+    Emit(opcode);
+    return (instructions_.size() - 1);
+}
+
+void ConstExprProgram::ResolveJump(std::size_t instructionIndex)
+{
+    instructions_[instructionIndex].operand = static_cast<std::uint32_t>(instructions_.size());
+}
+
+void ConstExprProgram::EmitPush(const Variant& value)
+{
+    Emit(Opcodes::Push, 0, static_cast<std::uint32_t>(constants_.size()));
+    constants_.push_back(value);
+    ChangeStackSize(1);
+}
+
+void ConstExprProgram::ChangeStackSize(int change)
+{
+    stackSize_ += change;
+    if (stackSize_ > 0)
+        maxStackSize_ = std::max(maxStackSize_, static_cast<std::size_t>(stackSize_));
+}
+
+/* --- Expressions --- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void ConstExprProgram::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+// Expressions that are not constant can not be compiled
+#define IMPLEMENT_VISIT_PROC_NOT_CONSTANT(AST_NAME) \
+    IMPLEMENT_VISIT_PROC(AST_NAME)                  \
+    {                                               \
+        failed_ = true;                             \
+    }
+
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( NullExpr          )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( TypeSpecifierExpr )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( CallExpr          )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( AssignExpr        )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( ObjectExpr        )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( ArrayExpr         )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( CastExpr          )
+IMPLEMENT_VISIT_PROC_NOT_CONSTANT( InitializerExpr   )
+
+IMPLEMENT_VISIT_PROC(SequenceExpr)
+{
+    /* Only compile first sub-expression (when used as condExpr) */
+    Visit(ast->exprs.front());
+}
+
+IMPLEMENT_VISIT_PROC(LiteralExpr)
+{
+    switch (ast->dataType)
+    {
+        case DataType::Bool:
+        {
+            if (ast->value == "true")
+                EmitPush(true);
+            else if (ast->value == "false")
+                EmitPush(false);
+            else
+                failed_ = true;
+        }
+        break;
+
+        case DataType::Int:
+        {
+            EmitPush(FromStringOrDefault<long long>(ast->value));
+        }
+        break;
+
+        case DataType::UInt:
+        {
+            EmitPush(static_cast<Variant::IntType>(FromStringOrDefault<unsigned long>(ast->value)));
+        }
+        break;
+
+        case DataType::Half:
+        case DataType::Float:
+        case DataType::Double:
+        {
+            EmitPush(FromStringOrDefault<double>(ast->value));
+        }
+        break;
+
+        default:
+        {
+            failed_ = true;
+        }
+        break;
+    }
+}
+
+IMPLEMENT_VISIT_PROC(TernaryExpr)
+{
+    /* Compile condition, and jump to the else-branch if it is false */
+    Visit(ast->condExpr);
+
+    auto jumpToElse = EmitJump(Opcodes::JumpIfFalse);
+    ChangeStackSize(-1);
+
+    /* Compile then-branch, and jump over the else-branch */
+    Visit(ast->thenExpr);
+
+    auto jumpToEnd = EmitJump(Opcodes::Jump);
+    ChangeStackSize(-1);
+
+    /* Compile else-branch */
+    ResolveJump(jumpToElse);
+    Visit(ast->elseExpr);
+    ResolveJump(jumpToEnd);
+}
+
+// EXPR OP EXPR
+IMPLEMENT_VISIT_PROC(BinaryExpr)
+{
+    Visit(ast->lhsExpr);
+
+    if (ast->op == BinaryOp::LogicalAnd || ast->op == BinaryOp::LogicalOr)
+    {
+        /* Only evaluate the right hand side expression if necessary */
+        auto jumpToEnd = EmitJump(ast->op == BinaryOp::LogicalAnd ? Opcodes::LogicalAnd : Opcodes::LogicalOr);
+        ChangeStackSize(-1);
+
+        Visit(ast->rhsExpr);
+        Emit(Opcodes::ToBool);
+
+        ResolveJump(jumpToEnd);
+    }
+    else if (ast->op != BinaryOp::Undefined)
+    {
+        Visit(ast->rhsExpr);
+        Emit(Opcodes::BinaryOp, static_cast<std::uint8_t>(ast->op));
+        ChangeStackSize(-1);
+    }
+    else
+        failed_ = true;
+}
+
+// OP EXPR
+IMPLEMENT_VISIT_PROC(UnaryExpr)
+{
+    Visit(ast->expr);
+
+    if (ast->op == UnaryOp::Undefined)
+        failed_ = true;
+    else if (ast->op != UnaryOp::Nop)
+        Emit(Opcodes::UnaryOp, static_cast<std::uint8_t>(ast->op));
+}
+
+// EXPR OP
+IMPLEMENT_VISIT_PROC(PostUnaryExpr)
+{
+    Visit(ast->expr);
+
+    /* Only the original value is used (post inc/dec will return the value BEFORE the operation) */
+    if (ast->op != UnaryOp::Inc && ast->op != UnaryOp::Dec)
+        failed_ = true;
+}
+
+IMPLEMENT_VISIT_PROC(BracketExpr)
+{
+    Visit(ast->expr);
+}
+
+#undef IMPLEMENT_VISIT_PROC_NOT_CONSTANT
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
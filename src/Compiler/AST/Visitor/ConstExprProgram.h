@@ -0,0 +1,120 @@
+/*
+ * ConstExprProgram.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_CONST_EXPR_PROGRAM_H
+#define XSC_CONST_EXPR_PROGRAM_H
+
+
+#include "Visitor.h"
+#include "Variant.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+/*
+Constant expression compiled into a compact stack machine program, which can be executed repeatedly without the AST.
+The program produces the same result as the ExprEvaluator with the 'EvaluateReducedBinaryExpr' flag,
+but only expressions of literals and operators can be compiled (e.g. the conditions of '#if'-directives after macro expansion).
+*/
+class ConstExprProgram : private Visitor
+{
+
+    public:
+
+        // Compiles the specified expression into this program. Returns false if the expression contains anything else than literals and operators.
+        bool Compile(Expr& expr);
+
+        /*
+        Executes this program and returns the result, or throws a runtime error on failure (e.g. division by zero).
+        The specified stack is used as working storage, so its memory can be reused for multiple executions.
+        */
+        Variant Execute(std::vector<Variant>& stack) const;
+
+        // Returns true if this program has been compiled successfully.
+        inline bool IsValid() const
+        {
+            return !instructions_.empty();
+        }
+
+    private:
+
+        /* === Structures === */
+
+        enum class Opcodes : std::uint8_t
+        {
+            Push,           // Push constant at index 'operand'
+            UnaryOp,        // Replace top value by result of unary operator 'op'
+            BinaryOp,       // Replace two top values by result of binary operator 'op'
+            ToBool,         // Replace top value by its boolean value
+            LogicalAnd,     // Replace top value by 'false' and jump to 'operand' if it is false, otherwise pop it
+            LogicalOr,      // Replace top value by 'true' and jump to 'operand' if it is true, otherwise pop it
+            JumpIfFalse,    // Pop top value and jump to 'operand' if it is false
+            Jump,           // Jump to 'operand'
+        };
+
+        struct Instruction
+        {
+            Opcodes         opcode;
+            std::uint8_t    op;         // Unary or binary operator
+            std::uint32_t   operand;    // Constant index or jump target
+        };
+
+        /* === Functions === */
+
+        void Emit(const Opcodes opcode, std::uint8_t op = 0, std::uint32_t operand = 0);
+
+        // Emits the specified jump instruction, whose target is set by 'ResolveJump'. Returns the index of the instruction.
+        std::size_t EmitJump(const Opcodes opcode);
+        void ResolveJump(std::size_t instructionIndex);
+
+        void EmitPush(const Variant& value);
+
+        // Changes the stack size at compile time, to determine the maximal stack size.
+        void ChangeStackSize(int change);
+
+        /* --- Visitor implementation --- */
+
+        DECL_VISIT_PROC( NullExpr          );
+        DECL_VISIT_PROC( SequenceExpr      );
+        DECL_VISIT_PROC( LiteralExpr       );
+        DECL_VISIT_PROC( TypeSpecifierExpr );
+        DECL_VISIT_PROC( TernaryExpr       );
+        DECL_VISIT_PROC( BinaryExpr        );
+        DECL_VISIT_PROC( UnaryExpr         );
+        DECL_VISIT_PROC( PostUnaryExpr     );
+        DECL_VISIT_PROC( CallExpr          );
+        DECL_VISIT_PROC( BracketExpr       );
+        DECL_VISIT_PROC( AssignExpr        );
+        DECL_VISIT_PROC( ObjectExpr        );
+        DECL_VISIT_PROC( ArrayExpr         );
+        DECL_VISIT_PROC( CastExpr          );
+        DECL_VISIT_PROC( InitializerExpr   );
+
+        /* === Members === */
+
+        std::vector<Instruction>    instructions_;
+        std::vector<Variant>        constants_;
+
+        std::size_t                 maxStackSize_   = 0;
+        int                         stackSize_      = 0;    // Stack size at compile time
+        bool                        failed_         = false;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -87,7 +87,7 @@ static void ConvertCastExpr(ExprPtr& expr, const DataType sourceType, const Data
         if (sourceDim < targetDim)
         {
             /* Convert to cast expression and extend type constructor with sequential zero-literals (e.g. 'float3(v4)' => 'float4(v4, 0)') */
-            auto typeDenoter = std::make_shared<BaseTypeDenoter>(targetType);
+            auto typeDenoter = BaseTypeDenoter::GetCanonical(targetType);
 
             std::vector<ExprPtr> args;
             args.push_back(expr);
@@ -474,16 +474,12 @@ IMPLEMENT_VISIT_PROC(ArrayExpr)
 
 static TypeDenoterPtr MakeBufferAccessCallTypeDenoter(const DataType genericDataType)
 {
-    auto typeDenoter = std::make_shared<BaseTypeDenoter>();
-
     if (IsIntType(genericDataType))
-        typeDenoter->dataType = DataType::Int4;
+        return BaseTypeDenoter::GetCanonical(DataType::Int4);
     else if (IsUIntType(genericDataType))
-        typeDenoter->dataType = DataType::UInt4;
+        return BaseTypeDenoter::GetCanonical(DataType::UInt4);
     else
-        typeDenoter->dataType = DataType::Float4;
-
-    return typeDenoter;
+        return BaseTypeDenoter::GetCanonical(DataType::Float4);
 }
 
 void ExprConverter::ConvertExpr(ExprPtr& expr, const Flags& flags)
@@ -584,7 +580,7 @@ void ExprConverter::ConvertExprMatrixSubscriptObject(ExprPtr& expr, ObjectExpr*
                 const auto wrapperIdent = ExprConverter::GetMatrixSubscriptWrapperIdent(nameMangling_, subscriptUsage); 
                 expr = ASTFactory::MakeWrapperCallExpr(
                     wrapperIdent,
-                    std::make_shared<BaseTypeDenoter>(subscriptUsage.dataTypeOut),
+                    BaseTypeDenoter::GetCanonical(subscriptUsage.dataTypeOut),
                     { objectExpr->prefixExpr }
                 );
             }
@@ -943,8 +939,7 @@ void ExprConverter::ConvertExprFormatInitializer(ExprPtr& expr, InitializerExpr*
             if (numEntries == initExpr->exprs.size())
             {
                 /* Make vector type for matrix rows */
-                auto rowTypeDenoter = std::make_shared<BaseTypeDenoter>();
-                rowTypeDenoter->dataType = VectorDataType(BaseDataType(baseTargetTypeDen->dataType), dims.second);
+                auto rowTypeDenoter = BaseTypeDenoter::GetCanonical(VectorDataType(BaseDataType(baseTargetTypeDen->dataType), dims.second));
 
                 std::vector<ExprPtr> subInitExprs;
 
@@ -0,0 +1,53 @@
+/*
+ * FuncCallCollector.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "FuncCallCollector.h"
+#include "AST.h"
+
+
+namespace Xsc
+{
+
+
+void FuncCallCollector::Collect(AST* ast, std::vector<std::string>& funcIdents)
+{
+    funcIdents_ = &funcIdents;
+    Visit(ast);
+    funcIdents_ = nullptr;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+/* ------- Visit functions ------- */
+
+#define IMPLEMENT_VISIT_PROC(AST_NAME) \
+    void FuncCallCollector::Visit##AST_NAME(AST_NAME* ast, void* args)
+
+IMPLEMENT_VISIT_PROC(CallExpr)
+{
+    if (!ast->ident.empty())
+        funcIdents_->push_back(ast->ident);
+    VISIT_DEFAULT(CallExpr);
+}
+
+IMPLEMENT_VISIT_PROC(LiteralExpr)
+{
+    if (ast->dataType == DataType::String)
+        funcIdents_->push_back(ast->GetStringValue());
+}
+
+#undef IMPLEMENT_VISIT_PROC
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
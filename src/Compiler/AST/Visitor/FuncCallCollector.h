@@ -0,0 +1,54 @@
+/*
+ * FuncCallCollector.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_FUNC_CALL_COLLECTOR_H
+#define XSC_FUNC_CALL_COLLECTOR_H
+
+
+#include "Visitor.h"
+#include <string>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Collects the identifiers of all function calls within an AST, before the AST has been analyzed.
+String literals are collected as well, since attributes refer to functions by name (e.g. "[patchconstantfunc("HS_Const")]").
+*/
+class FuncCallCollector : public Visitor
+{
+
+    public:
+
+        // Appends the identifiers of all called functions within the specified AST to the output list.
+        void Collect(AST* ast, std::vector<std::string>& funcIdents);
+
+    private:
+
+        /* --- Visitor implementation --- */
+
+        DECL_VISIT_PROC( CallExpr    );
+        DECL_VISIT_PROC( LiteralExpr );
+
+        /* === Members === */
+
+        std::vector<std::string>* funcIdents_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,84 @@
+/*
+ * FuncReachabilityAnalyzer.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "FuncReachabilityAnalyzer.h"
+#include "FuncCallCollector.h"
+#include "AST.h"
+#include <unordered_map>
+#include <unordered_set>
+
+
+namespace Xsc
+{
+
+
+std::vector<FunctionDecl*> FuncReachabilityAnalyzer::FindUnreachableFunctions(Program& program, const std::vector<std::string>& entryPoints)
+{
+    std::vector<FunctionDecl*> unreachableFuncDecls;
+
+    /* Map identifiers to global function implementations, and collect all function calls outside of these functions */
+    std::unordered_map<std::string, std::vector<FunctionDecl*>> funcDeclsByIdent;
+    std::vector<std::string> pendingIdents = entryPoints;
+
+    FuncCallCollector collector;
+
+    for (auto& stmnt : program.globalStmnts)
+    {
+        if (auto basicDeclStmnt = stmnt->As<BasicDeclStmnt>())
+        {
+            if (auto funcDecl = basicDeclStmnt->declObject->As<FunctionDecl>())
+            {
+                if (funcDecl->codeBlock)
+                {
+                    /* Only collect function calls from attributes and default arguments */
+                    funcDeclsByIdent[funcDecl->ident.Original()].push_back(funcDecl);
+                    for (auto& attrib : basicDeclStmnt->attribs)
+                        collector.Collect(attrib.get(), pendingIdents);
+                    for (auto& param : funcDecl->parameters)
+                        collector.Collect(param.get(), pendingIdents);
+                    continue;
+                }
+            }
+        }
+        collector.Collect(stmnt.get(), pendingIdents);
+    }
+
+    /* Follow function calls as long as new functions are reached */
+    std::unordered_set<std::string> reachedIdents;
+
+    while (!pendingIdents.empty())
+    {
+        auto ident = std::move(pendingIdents.back());
+        pendingIdents.pop_back();
+
+        if (!reachedIdents.insert(ident).second)
+            continue;
+
+        auto it = funcDeclsByIdent.find(ident);
+        if (it != funcDeclsByIdent.end())
+        {
+            for (auto funcDecl : it->second)
+                collector.Collect(funcDecl->codeBlock.get(), pendingIdents);
+        }
+    }
+
+    /* Return all function implementations that have not been reached */
+    for (const auto& it : funcDeclsByIdent)
+    {
+        if (reachedIdents.find(it.first) == reachedIdents.end())
+            unreachableFuncDecls.insert(unreachableFuncDecls.end(), it.second.begin(), it.second.end());
+    }
+
+    return unreachableFuncDecls;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,44 @@
+/*
+ * FuncReachabilityAnalyzer.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_FUNC_REACHABILITY_ANALYZER_H
+#define XSC_FUNC_REACHABILITY_ANALYZER_H
+
+
+#include "Visitor.h"
+#include <string>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+/*
+Call graph pre-pass for the context analyzer.
+This helper class determines which global functions can be reached from the entry points, before the AST has been analyzed.
+Function calls are followed by their identifiers only, so the result is a superset of the functions the context analyzer would reach.
+*/
+class FuncReachabilityAnalyzer
+{
+
+    public:
+
+        // Returns all global function implementations which can not be reached from the specified entry points.
+        std::vector<FunctionDecl*> FindUnreachableFunctions(Program& program, const std::vector<std::string>& entryPoints);
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -120,7 +120,7 @@ void UniformPacker::Convert(Program& program, const CbufferAttributes& cbufferAt
 void UniformPacker::MakeUniformBuffer()
 {
     /* Make single constant buffer to pack uniforms into */
-    declStmnt_ = std::make_shared<BasicDeclStmnt>(SourcePosition::ignore);
+    declStmnt_ = MakeShared<BasicDeclStmnt>(SourcePosition::ignore);
     {
         uniformBufferDecl_ = ASTFactory::MakeUniformBufferDecl(cbufferAttribs_.name, cbufferAttribs_.bindingSlot);
         uniformBufferDecl_->declStmntRef = declStmnt_.get();
@@ -44,17 +44,17 @@ void Converter::CloseScope()
     symTable_.CloseScope();
 }
 
-void Converter::Register(const std::string& ident)
+void Converter::Register(const Atom& ident)
 {
     symTable_.Register(ident, true);
 }
 
-bool Converter::Fetch(const std::string& ident) const
+bool Converter::Fetch(const Atom& ident) const
 {
     return symTable_.Fetch(ident);
 }
 
-bool Converter::FetchFromCurrentScope(const std::string& ident) const
+bool Converter::FetchFromCurrentScope(const Atom& ident) const
 {
     return symTable_.FetchFromCurrentScope(ident);
 }
@@ -55,13 +55,13 @@ class Converter : public VisitorTracker
         void CloseScope();
 
         // Registers the AST node in the current scope with the specified identifier.
-        void Register(const std::string& ident);
+        void Register(const Atom& ident);
 
         // Returns the symbol with the specified identifer which is in the deepest scope, or null if there is no such symbol.
-        bool Fetch(const std::string& ident) const;
+        bool Fetch(const Atom& ident) const;
 
         // Returns the symbol with the specified identifer which is in the current scope, or null if there is no such symbol.
-        bool FetchFromCurrentScope(const std::string& ident) const;
+        bool FetchFromCurrentScope(const Atom& ident) const;
 
         /* ----- Self parameter ----- */
 
@@ -200,8 +200,17 @@ std::string Generator::TimePoint() const
     auto currentTime    = std::chrono::system_clock::now();
     auto date           = std::chrono::system_clock::to_time_t(currentTime);
 
+    /* Convert to local time with the re-entrant functions, since 'std::localtime' uses a shared buffer */
+    std::tm localTime;
+
+    #ifdef _WIN32
+    localtime_s(&localTime, &date);
+    #else
+    localtime_r(&date, &localTime);
+    #endif
+
     std::stringstream s;
-    s << std::put_time(std::localtime(&date), "%d/%m/%Y %H:%M:%S");
+    s << std::put_time(&localTime, "%d/%m/%Y %H:%M:%S");
 
     return s.str();
 }
@@ -0,0 +1,224 @@
+/*
+ * BinaryStream.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_BINARY_STREAM_H
+#define XSC_BINARY_STREAM_H
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+// Binary writer for serialized data (integers are written in little-endian byte order).
+class BinaryWriter
+{
+
+    public:
+
+        void WriteUInt(std::uint32_t value)
+        {
+            for (int i = 0; i < 4; ++i)
+                data_.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+        }
+
+        void WriteUInt64(std::uint64_t value)
+        {
+            WriteUInt(static_cast<std::uint32_t>(value & 0xffffffffu));
+            WriteUInt(static_cast<std::uint32_t>(value >> 32));
+        }
+
+        void WriteInt(int value)
+        {
+            WriteUInt(static_cast<std::uint32_t>(value));
+        }
+
+        void WriteBool(bool value)
+        {
+            data_.push_back(value ? 1 : 0);
+        }
+
+        void WriteFloat(float value)
+        {
+            std::uint32_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            WriteUInt(bits);
+        }
+
+        void WriteDouble(double value)
+        {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(bits));
+            WriteUInt64(bits);
+        }
+
+        template <typename T>
+        void WriteEnum(T value)
+        {
+            WriteInt(static_cast<int>(value));
+        }
+
+        void WriteString(const std::string& s)
+        {
+            WriteUInt(static_cast<std::uint32_t>(s.size()));
+            data_ += s;
+        }
+
+        template <typename T, typename Func>
+        void WriteList(const std::vector<T>& list, const Func& writeElement)
+        {
+            WriteUInt(static_cast<std::uint32_t>(list.size()));
+            for (const auto& element : list)
+                writeElement(element);
+        }
+
+        inline const std::string& Data() const
+        {
+            return data_;
+        }
+
+    private:
+
+        std::string data_;
+
+};
+
+// Binary reader for serialized data. All read functions return a default value once the end of data is exceeded.
+class BinaryReader
+{
+
+    public:
+
+        BinaryReader(const std::string& data) :
+            data_ { data.data() },
+            size_ { data.size() }
+        {
+        }
+
+        // Borrows the specified memory buffer (e.g. a memory mapped file), which must be valid for the lifetime of this reader.
+        BinaryReader(const char* data, std::size_t size) :
+            data_ { data },
+            size_ { size }
+        {
+        }
+
+        std::uint32_t ReadUInt()
+        {
+            std::uint32_t value = 0;
+            if (Acquire(4))
+            {
+                for (int i = 0; i < 4; ++i)
+                    value |= (static_cast<std::uint32_t>(static_cast<unsigned char>(data_[pos_++])) << (i * 8));
+            }
+            return value;
+        }
+
+        std::uint64_t ReadUInt64()
+        {
+            auto lo = static_cast<std::uint64_t>(ReadUInt());
+            auto hi = static_cast<std::uint64_t>(ReadUInt());
+            return (lo | (hi << 32));
+        }
+
+        int ReadInt()
+        {
+            return static_cast<int>(ReadUInt());
+        }
+
+        bool ReadBool()
+        {
+            return (Acquire(1) && data_[pos_++] != 0);
+        }
+
+        float ReadFloat()
+        {
+            auto bits = ReadUInt();
+            float value = 0.0f;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        double ReadDouble()
+        {
+            auto bits = ReadUInt64();
+            double value = 0.0;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        template <typename T>
+        T ReadEnum()
+        {
+            return static_cast<T>(ReadInt());
+        }
+
+        std::string ReadString()
+        {
+            auto size = ReadUInt();
+            if (!Acquire(size))
+                return "";
+            auto s = std::string(data_ + pos_, size);
+            pos_ += size;
+            return s;
+        }
+
+        template <typename T, typename Func>
+        void ReadList(std::vector<T>& list, const Func& readElement)
+        {
+            auto size = ReadUInt();
+            list.clear();
+            for (std::uint32_t i = 0; i < size && valid_; ++i)
+            {
+                list.emplace_back();
+                readElement(list.back());
+            }
+        }
+
+        // Returns true if the end of data has not been exceeded yet.
+        inline bool Valid() const
+        {
+            return valid_;
+        }
+
+        // Returns true if all data has been read without exceeding the end of data.
+        inline bool Finished() const
+        {
+            return (valid_ && pos_ == size_);
+        }
+
+    private:
+
+        bool Acquire(std::size_t size)
+        {
+            if (valid_ && size <= size_ - pos_)
+                return true;
+            valid_ = false;
+            return false;
+        }
+
+        const char*         data_   = nullptr;
+        std::size_t         size_   = 0;
+        std::size_t         pos_    = 0;
+        bool                valid_  = true;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
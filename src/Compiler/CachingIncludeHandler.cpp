@@ -0,0 +1,231 @@
+/*
+ * CachingIncludeHandler.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/CachingIncludeHandler.h>
+#include "ReportIdents.h"
+#include "Exception.h"
+#include "MemoryStream.h"
+#include <mutex>
+#include <map>
+#include <fstream>
+#include <iterator>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal structures
+ */
+
+// Cached content of a file, which is shared by all streams that have been served from this cache entry.
+struct CachedFile
+{
+    std::uint64_t                       modificationTime    = 0;
+    std::uint64_t                       size                = 0;
+    std::shared_ptr<const std::string>  content;
+};
+
+struct CachingIncludeHandler::OpaqueData
+{
+    using IncludeKey = std::pair<std::string, bool>;
+
+    std::mutex                          mutex;
+    std::vector<std::string>            searchPaths;    // Search paths of the cached entries
+    std::map<IncludeKey, std::string>   resolvedPaths;  // Resolved path of each include filename, or empty string for negative lookups
+    std::map<std::string, CachedFile>   files;          // Cached file for each resolved path
+    std::size_t                         numHits         = 0;
+    std::size_t                         numMisses       = 0;
+};
+
+
+/*
+ * Internal functions
+ */
+
+static std::string JoinSearchPath(const std::string& path, const std::string& filename)
+{
+    std::string s = path;
+    if (path.back() != '/' && path.back() != '\\')
+        s += '/';
+    s += filename;
+    return s;
+}
+
+// Returns the path of the first existing file in the same order as the default include handler, or an empty string.
+static std::string ResolveIncludePath(const std::string& filename, bool useSearchPathsFirst, const std::vector<std::string>& searchPaths)
+{
+    std::uint64_t modificationTime = 0, size = 0;
+
+    if (!useSearchPathsFirst && QueryFileStatus(filename, modificationTime, size))
+        return filename;
+
+    for (const auto& path : searchPaths)
+    {
+        if (!path.empty())
+        {
+            auto s = JoinSearchPath(path, filename);
+            if (QueryFileStatus(s, modificationTime, size))
+                return s;
+        }
+    }
+
+    if (useSearchPathsFirst && QueryFileStatus(filename, modificationTime, size))
+        return filename;
+
+    return "";
+}
+
+static std::shared_ptr<const std::string> ReadFileContent(const std::string& filename)
+{
+    std::ifstream file(filename, std::ios_base::binary);
+    if (!file.good())
+        return nullptr;
+    return std::make_shared<std::string>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static std::unique_ptr<std::istream> MakeContentStream(const std::shared_ptr<const std::string>& content)
+{
+    /* Borrow the cached content, which is kept alive by the stream even if the cache entry is replaced */
+    return std::unique_ptr<std::istream>(new MemoryInputStream(content->data(), content->size(), content));
+}
+
+
+/*
+ * CachingIncludeHandler class
+ */
+
+CachingIncludeHandler::CachingIncludeHandler() :
+    data_ { new OpaqueData() }
+{
+}
+
+CachingIncludeHandler::~CachingIncludeHandler()
+{
+    delete data_;
+}
+
+std::unique_ptr<std::istream> CachingIncludeHandler::Include(const std::string& filename, bool useSearchPathsFirst)
+{
+    const OpaqueData::IncludeKey key { filename, useSearchPathsFirst };
+
+    std::vector<std::string> searchPaths;
+    std::string path;
+    bool resolved = false;
+
+    /* Find resolved path (the lock is not held while the file system is accessed) */
+    {
+        std::lock_guard<std::mutex> guard { data_->mutex };
+
+        /* Invalidate cache if the search paths have changed */
+        if (data_->searchPaths != GetSearchPaths())
+        {
+            data_->resolvedPaths.clear();
+            data_->files.clear();
+            data_->searchPaths = GetSearchPaths();
+        }
+
+        searchPaths = data_->searchPaths;
+
+        auto it = data_->resolvedPaths.find(key);
+        if (it != data_->resolvedPaths.end())
+        {
+            path        = it->second;
+            resolved    = true;
+        }
+    }
+
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        if (!resolved)
+        {
+            /* Resolve path and store it, including negative lookups */
+            path = ResolveIncludePath(filename, useSearchPathsFirst, searchPaths);
+            resolved = true;
+
+            std::lock_guard<std::mutex> guard { data_->mutex };
+            data_->resolvedPaths[key] = path;
+        }
+
+        if (path.empty())
+            break;
+
+        /* Query file status to validate the cached content */
+        std::uint64_t modificationTime = 0, size = 0;
+
+        if (!QueryFileStatus(path, modificationTime, size))
+        {
+            /* Resolve path again, since the file has been removed */
+            resolved = false;
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard { data_->mutex };
+
+            auto it = data_->files.find(path);
+            if (it != data_->files.end() && it->second.modificationTime == modificationTime && it->second.size == size)
+            {
+                ++data_->numHits;
+                return MakeContentStream(it->second.content);
+            }
+        }
+
+        /* Read file and replace outdated cache entry */
+        if (auto content = ReadFileContent(path))
+        {
+            std::lock_guard<std::mutex> guard { data_->mutex };
+
+            ++data_->numMisses;
+
+            auto& file = data_->files[path];
+            {
+                file.modificationTime   = modificationTime;
+                file.size               = size;
+                file.content            = content;
+            }
+
+            return MakeContentStream(content);
+        }
+
+        resolved = false;
+    }
+
+    RuntimeErr(R_FailedToIncludeFile(filename));
+}
+
+bool CachingIncludeHandler::IsThreadSafe() const
+{
+    return true;
+}
+
+void CachingIncludeHandler::Clear()
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    data_->resolvedPaths.clear();
+    data_->files.clear();
+}
+
+std::size_t CachingIncludeHandler::NumCacheHits() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->numHits;
+}
+
+std::size_t CachingIncludeHandler::NumCacheMisses() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->numMisses;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
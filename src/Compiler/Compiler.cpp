@@ -13,6 +13,13 @@
 #include "Optimizer.h"
 #include "ReflectionAnalyzer.h"
 #include "ASTPrinter.h"
+#include "ASTCloner.h"
+#include "ShaderCacheEntry.h"
+#include "IncludeCache.h"
+#include "IncludePrefetcher.h"
+#include "MemoryStream.h"
+#include "MemoryArena.h"
+#include "OverloadCache.h"
 
 #include "GLSLPreProcessor.h"
 #include "GLSLParser.h"
@@ -21,43 +28,172 @@
 #include "HLSLParser.h"
 #include "HLSLAnalyzer.h"
 #include "HLSLIntrinsics.h"
+#include "HLSLKeywords.h"
+#include "GLSLKeywords.h"
 
 #include <sstream>
 #include <stdexcept>
+#include <iterator>
+#include <unordered_map>
 
 
 namespace Xsc
 {
 
 
+// Returns true if the specified input and output descriptors result in the same AST from the parser.
+static bool IsParserConfigEqual(const ShaderInput& lhsIn, const ShaderOutput& lhs, const ShaderInput& rhsIn, const ShaderOutput& rhs)
+{
+    const auto& lhsMngl = lhs.nameMangling;
+    const auto& rhsMngl = rhs.nameMangling;
+    return
+    (
+        lhsMngl.inputPrefix             == rhsMngl.inputPrefix          &&
+        lhsMngl.outputPrefix            == rhsMngl.outputPrefix         &&
+        lhsMngl.reservedWordPrefix      == rhsMngl.reservedWordPrefix   &&
+        lhsMngl.temporaryPrefix         == rhsMngl.temporaryPrefix      &&
+        lhsMngl.namespacePrefix         == rhsMngl.namespacePrefix      &&
+        lhsMngl.useAlwaysSemantics      == rhsMngl.useAlwaysSemantics   &&
+        lhsMngl.renameBufferFields      == rhsMngl.renameBufferFields   &&
+        lhs.options.rowMajorAlignment   == rhs.options.rowMajorAlignment &&
+        lhs.options.lazyFunctionBodies  == rhs.options.lazyFunctionBodies &&
+        /* Lazy function bodies depend on the entry points */
+        ( !lhs.options.lazyFunctionBodies || ( lhsIn.entryPoint == rhsIn.entryPoint && lhsIn.secondaryEntryPoint == rhsIn.secondaryEntryPoint ) )
+    );
+}
+
+// Enables lazy function bodies for the specified parser, if enabled in the output descriptor and an entry point is specified.
+static void EnableLazyFunctionBodies(HLSLParser& parser, const ShaderInput& inputDesc, const ShaderOutput& outputDesc)
+{
+    /* Recorded function bodies can not preserve their comments, and can not be validated if they are never parsed */
+    const auto& options = outputDesc.options;
+    if (options.lazyFunctionBodies && !options.preserveComments && !options.validateAll && !inputDesc.entryPoint.empty())
+    {
+        std::vector<std::string> entryPoints { inputDesc.entryPoint };
+        if (!inputDesc.secondaryEntryPoint.empty())
+            entryPoints.push_back(inputDesc.secondaryEntryPoint);
+        parser.EnableLazyFunctionBodies(entryPoints);
+    }
+}
+
+// Selects the next permutation of the macro matrix (the last macro varies fastest). Returns false after the last permutation.
+static bool NextPermutation(std::vector<std::size_t>& variants, const std::vector<PermutationMacro>& macroMatrix)
+{
+    for (auto i = macroMatrix.size(); i-- > 0;)
+    {
+        const auto& macro = macroMatrix[i];
+        const auto numVariants = macro.values.size() + (macro.undefinedVariant ? 1u : 0u);
+
+        if (++variants[i] < numVariants)
+            return true;
+
+        variants[i] = 0;
+    }
+    return false;
+}
+
+// Returns a new memory arena for the syntax tree, or null if the 'arenaAllocation' option is disabled.
+static std::shared_ptr<MemoryArena> MakeArena(const ShaderOutput& outputDesc)
+{
+    return (outputDesc.options.arenaAllocation ? std::make_shared<MemoryArena>() : nullptr);
+}
+
 Compiler::Compiler(Log* log) :
     log_ { log }
 {
 }
 
+Compiler::~Compiler()
+{
+    // dummy
+}
+
+void Compiler::SetLog(Log* log)
+{
+    log_ = log;
+}
+
+void Compiler::WarmUp()
+{
+    EstablishIntrinsicAdept();
+
+    /* Initialize static keyword tables */
+    HLSLKeywords();
+    HLSLKeywordsExtCg();
+    GLSLKeywords();
+    ReservedGLSLKeywords();
+}
+
+void Compiler::PrintStageTimings(Log* log, const StageTimePoints& timePoints)
+{
+    auto PrintTiming = [log](const std::string& processName, const TimePoint startTime, const TimePoint endTime)
+    {
+        long long duration = 0ll;
+
+        if (endTime > startTime)
+        {
+            duration =
+            (
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::duration<float>(endTime - startTime)
+                ).count()
+            );
+        }
+
+        log->SubmitReport(
+            Report(
+                ReportTypes::Info,
+                "timing " + processName + std::to_string(duration) + " ms"
+            )
+        );
+    };
+
+    PrintTiming( "pre-processing:   ", timePoints.preprocessor, timePoints.parser     );
+    PrintTiming( "parsing:          ", timePoints.parser,       timePoints.analyzer   );
+    PrintTiming( "context analysis: ", timePoints.analyzer,     timePoints.optimizer  );
+    PrintTiming( "optimization:     ", timePoints.optimizer,    timePoints.generation );
+    PrintTiming( "code generation:  ", timePoints.generation,   timePoints.reflection );
+
+    /* Print hit rate of overload resolution cache */
+    const auto hitRate = (timePoints.overloadCacheLookups > 0 ? timePoints.overloadCacheHits * 100 / timePoints.overloadCacheLookups : 0);
+
+    log->SubmitReport(
+        Report(
+            ReportTypes::Info,
+            (
+                "timing overload cache:    " + std::to_string(hitRate) + "% hits (" +
+                std::to_string(timePoints.overloadCacheHits) + " of " + std::to_string(timePoints.overloadCacheLookups) + " lookups)"
+            )
+        )
+    );
+
+    /* Print number of re-scans avoided by the include guard detection */
+    log->SubmitReport(
+        Report(
+            ReportTypes::Info,
+            "timing include guards:    " + std::to_string(timePoints.skippedIncludes) + " re-scans avoided"
+        )
+    );
+}
+
 bool Compiler::CompileShader(
     const ShaderInput&          inputDesc,
     const ShaderOutput&         outputDesc,
     Reflection::ReflectionData* reflectionData,
     StageTimePoints*            stageTimePoints)
 {
-    /* Make copy of output descriptor to support validation without output stream */
-    std::stringstream dummyOutputStream;
+    AtomTableScope atomTableScope(atomTable_);
+    atomTable_.Clear();
 
-    auto outputDescCopy = outputDesc;
+    timePoints_ = StageTimePoints();
 
-    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly)
-    {
-        Warning(R_GLSLFrontendIsIncomplete);
-        outputDescCopy.options.validateOnly = true;
-    }
+    /* Make copy of output descriptor to support validation without output stream, and output callbacks */
+    CallbackOutputStream callbackOutputStream;
 
-    if (outputDescCopy.options.validateOnly)
-        outputDescCopy.sourceCode = &dummyOutputStream;
+    auto outputDescCopy = PrepareOutputDesc(inputDesc, outputDesc, callbackOutputStream);
 
-    /* Implicitly enable 'explicitBinding' option of 'autoBinding' is enabled */
-    if (outputDescCopy.options.autoBinding)
-        outputDescCopy.options.explicitBinding = true;
+    /* Allocate syntax tree in a memory arena if enabled */
+    ArenaScope arenaScope(MakeArena(outputDescCopy));
 
     /* Compile shader with primary function */
     auto result = CompileShaderPrimary(inputDesc, outputDescCopy, reflectionData);
@@ -69,6 +205,307 @@ bool Compiler::CompileShader(
     return result;
 }
 
+bool Compiler::CompileShaderBatch(
+    const ShaderInput&                  inputDesc,
+    const std::vector<ShaderBatchJob>&  jobs,
+    std::vector<bool>*                  jobResults,
+    std::vector<StageTimePoints>*       stageTimePoints)
+{
+    AtomTableScope atomTableScope(atomTable_);
+    atomTable_.Clear();
+
+    if (jobResults)
+        jobResults->assign(jobs.size(), false);
+    if (stageTimePoints)
+        stageTimePoints->assign(jobs.size(), StageTimePoints());
+
+    if (jobs.empty())
+        return true;
+
+    /* Make input descriptor for each job and validate arguments */
+    std::vector<ShaderInput> jobInputDescs(jobs.size(), inputDesc);
+    std::vector<ShaderOutput> jobOutputDescs(jobs.size());
+    std::vector<CallbackOutputStream> callbackOutputStreams(jobs.size());
+
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+        auto& jobInputDesc = jobInputDescs[i];
+        {
+            jobInputDesc.entryPoint             = jobs[i].entryPoint;
+            jobInputDesc.secondaryEntryPoint    = jobs[i].secondaryEntryPoint;
+            jobInputDesc.shaderTarget           = jobs[i].shaderTarget;
+        }
+        jobOutputDescs[i] = PrepareOutputDesc(jobInputDesc, jobs[i].outputDesc, callbackOutputStreams[i]);
+        ValidateArguments(jobInputDesc, jobOutputDescs[i]);
+    }
+
+    /* ----- Pre-processing (shared by all jobs) ----- */
+
+    timePoints_ = StageTimePoints();
+    timePoints_.preprocessor = Time::now();
+
+    std::vector<std::string> definedMacros;
+    auto processedInput = PreProcessSource(inputDesc, true, true, &definedMacros);
+
+    if (!processedInput)
+        return ReturnWithError(R_PreProcessingSourceFailed);
+
+    const auto processedCode = std::string(std::istreambuf_iterator<char>(*processedInput), std::istreambuf_iterator<char>());
+
+    /* ----- Compile each job with the shared pre-processed code ----- */
+
+    bool result = true;
+
+    ProgramPtr          parsedProgram;
+    const ShaderInput*  parsedInputDesc  = nullptr;
+    const ShaderOutput* parsedOutputDesc = nullptr;
+
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+        const auto& jobInputDesc    = jobInputDescs[i];
+        const auto& jobOutputDesc   = jobOutputDescs[i];
+        auto        reflectionData  = jobs[i].reflectionData;
+
+        if (reflectionData)
+            reflectionData->macros = definedMacros;
+
+        bool jobResult = false;
+
+        if (jobOutputDesc.options.preprocessOnly)
+        {
+            /* Write shared pre-processed code to output */
+            (*jobOutputDesc.sourceCode) << processedCode;
+            jobResult = true;
+        }
+        else
+        {
+            /* Pre-processing time is only accounted to the first job */
+            timePoints_.parser = Time::now();
+            if (i > 0)
+                timePoints_.preprocessor = timePoints_.parser;
+
+            auto CompileJob = [&](const ShaderOutput& compileOutputDesc)
+            {
+                ArenaScope arenaScope(MakeArena(compileOutputDesc));
+
+                /* Parse program only once for all jobs with the same parser configuration */
+                if (!parsedProgram || !IsParserConfigEqual(*parsedInputDesc, *parsedOutputDesc, jobInputDesc, jobOutputDesc))
+                {
+                    parsedProgram       = ParseSource(jobInputDesc, jobOutputDesc, std::make_shared<MemoryInputStream>(processedCode.data(), processedCode.size()));
+                    parsedInputDesc     = &jobInputDesc;
+                    parsedOutputDesc    = &jobOutputDesc;
+                }
+
+                if (!parsedProgram)
+                    return ReturnWithError(R_ParsingSourceFailed);
+
+                /* Compile a copy of the parsed program (the last job can take the original, since it won't be used anymore) */
+                auto program = (i + 1 < jobs.size() ? ASTCloner().CloneProgram(*parsedProgram) : parsedProgram);
+                return CompileProgram(*program, jobInputDesc, compileOutputDesc, reflectionData);
+            };
+
+            if (inputDesc.cache && IsShaderCacheable(jobOutputDesc))
+                jobResult = CompileWithCache(*inputDesc.cache, jobInputDesc, jobOutputDesc, reflectionData, processedCode, CompileJob);
+            else
+                jobResult = CompileJob(jobOutputDesc);
+        }
+
+        /* Store job result and time points */
+        if (jobResults)
+            (*jobResults)[i] = jobResult;
+        if (stageTimePoints)
+            (*stageTimePoints)[i] = timePoints_;
+
+        if (!jobResult)
+            result = false;
+    }
+
+    return result;
+}
+
+bool Compiler::CompileShaderPermutations(
+    const ShaderInput&                      inputDesc,
+    const ShaderOutput&                     outputDesc,
+    const std::vector<PermutationMacro>&    macroMatrix,
+    ShaderPermutationResult&                permutationResult)
+{
+    AtomTableScope atomTableScope(atomTable_);
+    atomTable_.Clear();
+
+    permutationResult = ShaderPermutationResult();
+
+    if (!inputDesc.sourceCode)
+        throw std::invalid_argument(R_InputStreamCantBeNull);
+
+    for (const auto& macro : macroMatrix)
+    {
+        if (macro.values.empty() && !macro.undefinedVariant)
+            throw std::invalid_argument(R_PermutationMacroWithoutVariants(macro.ident));
+    }
+
+    /* Read input source only once for all permutations, or borrow it from the memory buffer of the input stream */
+    std::string sourceCodeCopy;
+    const char* sourceCodeData = nullptr;
+    std::size_t sourceCodeSize = 0;
+
+    if (auto memoryInputStream = dynamic_cast<const MemoryInputStream*>(inputDesc.sourceCode.get()))
+    {
+        sourceCodeData = memoryInputStream->Data();
+        sourceCodeSize = memoryInputStream->Size();
+    }
+    else
+    {
+        sourceCodeCopy = std::string(std::istreambuf_iterator<char>(*inputDesc.sourceCode), std::istreambuf_iterator<char>());
+        sourceCodeData = sourceCodeCopy.data();
+        sourceCodeSize = sourceCodeCopy.size();
+    }
+
+    /* Load each included file only once for all permutations */
+    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    if (!inputDesc.includeHandler)
+        stdIncludeHandler = MakeUnique<IncludeHandler>();
+
+    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
+
+    /* Load included files in the background while the first permutation is pre-processed */
+    std::unique_ptr<IncludePrefetcher> includePrefetcher;
+    if (inputDesc.prefetchIncludes && includeHandler->IsThreadSafe())
+    {
+        includePrefetcher = MakeUnique<IncludePrefetcher>(*includeHandler);
+        includePrefetcher->Prefetch(sourceCodeData, sourceCodeSize);
+        includeHandler = includePrefetcher.get();
+    }
+
+    IncludeCache includeCache(*includeHandler);
+
+    auto permInputDesc = inputDesc;
+    permInputDesc.includeHandler = &includeCache;
+
+    /* Prepare output descriptor for all artifacts and validate arguments */
+    std::stringstream outputCode;
+    CallbackOutputStream callbackOutputStream;
+
+    auto permOutputDesc = outputDesc;
+    permOutputDesc.sourceCode = &outputCode;
+    permOutputDesc = PrepareOutputDesc(permInputDesc, permOutputDesc, callbackOutputStream);
+
+    ValidateArguments(permInputDesc, permOutputDesc);
+
+    /* ----- Pre-process all permutations and group them by their pre-processed code ----- */
+
+    auto& permutations  = permutationResult.permutations;
+    auto& outputs       = permutationResult.outputs;
+
+    std::unordered_map<std::string, std::size_t>    outputIndices;
+    std::vector<const std::string*>                 outputCodes;
+    std::vector<std::size_t>                        variants(macroMatrix.size(), 0);
+
+    do
+    {
+        ShaderPermutation permutation;
+
+        /* Append macros of this permutation to the pre-defined macros of the input descriptor */
+        permInputDesc.predefinedMacros = inputDesc.predefinedMacros;
+
+        for (std::size_t i = 0; i < macroMatrix.size(); ++i)
+        {
+            const auto& macro = macroMatrix[i];
+            if (variants[i] < macro.values.size())
+            {
+                const auto& value = macro.values[variants[i]];
+                permutation.macros.push_back({ macro.ident, value });
+                permInputDesc.predefinedMacros.push_back({ macro.ident, value });
+            }
+        }
+
+        permInputDesc.sourceCode = std::make_shared<MemoryInputStream>(sourceCodeData, sourceCodeSize);
+
+        std::vector<std::string> definedMacros;
+        auto processedInput = PreProcessSource(
+            permInputDesc,
+            (!outputDesc.options.preprocessOnly || outputDesc.formatting.lineMarks),
+            (!outputDesc.options.preprocessOnly || IsLanguageHLSL(inputDesc.shaderVersion)),
+            &definedMacros
+        );
+
+        if (processedInput)
+        {
+            auto processedCode = std::string(std::istreambuf_iterator<char>(*processedInput), std::istreambuf_iterator<char>());
+
+            /* Share output artifact with all previous permutations of the same pre-processed code */
+            auto it = outputIndices.find(processedCode);
+            if (it == outputIndices.end())
+            {
+                it = outputIndices.emplace(std::move(processedCode), outputs.size()).first;
+                outputCodes.push_back(&(it->first));
+                outputs.emplace_back();
+                outputs.back().reflectionData.macros = std::move(definedMacros);
+            }
+
+            permutation.outputIndex = it->second;
+        }
+        else
+        {
+            /* Failed permutations get their own (failed) artifact */
+            ReturnWithError(R_PreProcessingSourceFailed);
+            permutation.outputIndex = outputs.size();
+            outputCodes.push_back(nullptr);
+            outputs.emplace_back();
+        }
+
+        permutations.push_back(std::move(permutation));
+    }
+    while (NextPermutation(variants, macroMatrix));
+
+    /* ----- Compile each unique pre-processed code only once ----- */
+
+    bool result = true;
+
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        auto& output = outputs[i];
+
+        if (const auto processedCode = outputCodes[i])
+        {
+            outputCode.str("");
+            outputCode.clear();
+
+            if (permOutputDesc.options.preprocessOnly)
+            {
+                outputCode << *processedCode;
+                output.result = true;
+            }
+            else
+            {
+                auto CompileArtifact = [&](const ShaderOutput& compileOutputDesc)
+                {
+                    ArenaScope arenaScope(MakeArena(compileOutputDesc));
+
+                    auto program = ParseSource(permInputDesc, compileOutputDesc, std::make_shared<MemoryInputStream>(processedCode->data(), processedCode->size()));
+
+                    if (!program)
+                        return ReturnWithError(R_ParsingSourceFailed);
+
+                    return CompileProgram(*program, permInputDesc, compileOutputDesc, &(output.reflectionData));
+                };
+
+                if (inputDesc.cache && IsShaderCacheable(permOutputDesc))
+                    output.result = CompileWithCache(*inputDesc.cache, permInputDesc, permOutputDesc, &(output.reflectionData), *processedCode, CompileArtifact);
+                else
+                    output.result = CompileArtifact(permOutputDesc);
+            }
+
+            if (!permOutputDesc.options.validateOnly)
+                output.sourceCode = outputCode.str();
+        }
+
+        if (!output.result)
+            result = false;
+    }
+
+    return result;
+}
+
 
 /*
  * ======= Private: =======
@@ -132,6 +569,36 @@ void Compiler::ValidateArguments(const ShaderInput& inputDesc, const ShaderOutpu
     #endif
 }
 
+ShaderOutput Compiler::PrepareOutputDesc(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, CallbackOutputStream& callbackOutputStream)
+{
+    auto outputDescCopy = outputDesc;
+
+    if (!IsLanguageHLSL(inputDesc.shaderVersion) && !outputDesc.options.preprocessOnly)
+    {
+        Warning(R_GLSLFrontendIsIncomplete);
+        outputDescCopy.options.validateOnly = true;
+    }
+
+    if (outputDescCopy.options.validateOnly)
+    {
+        /* Discard output code */
+        callbackOutputStream.SetWriter(nullptr);
+        outputDescCopy.sourceCode = &callbackOutputStream;
+    }
+    else if (!outputDescCopy.sourceCode && outputDescCopy.sourceCodeWriter)
+    {
+        /* Pass output code directly to the output callback */
+        callbackOutputStream.SetWriter(outputDescCopy.sourceCodeWriter);
+        outputDescCopy.sourceCode = &callbackOutputStream;
+    }
+
+    /* Implicitly enable 'explicitBinding' option of 'autoBinding' is enabled */
+    if (outputDescCopy.options.autoBinding)
+        outputDescCopy.options.explicitBinding = true;
+
+    return outputDescCopy;
+}
+
 bool Compiler::CompileShaderPrimary(
     const ShaderInput&          inputDesc,
     const ShaderOutput&         outputDesc,
@@ -144,12 +611,105 @@ bool Compiler::CompileShaderPrimary(
 
     timePoints_.preprocessor = Time::now();
 
+    if (IsTokenStreamSupported(inputDesc, outputDesc))
+    {
+        /* Hand over the pre-processor tokens to the parser, without writing and scanning the pre-processed source code */
+        auto processedTokens = PreProcessTokens(
+            inputDesc,
+            (reflectionData != nullptr ? &(reflectionData->macros) : nullptr)
+        );
+
+        if (!processedTokens)
+            return ReturnWithError(R_PreProcessingSourceFailed);
+
+        /* ----- Parsing ----- */
+
+        timePoints_.parser = Time::now();
+
+        auto program = ParseTokens(inputDesc, outputDesc, processedTokens);
+
+        if (!program)
+            return ReturnWithError(R_ParsingSourceFailed);
+
+        return CompileProgram(*program, inputDesc, outputDesc, reflectionData);
+    }
+
+    const bool writeLineMarksInPP = (!outputDesc.options.preprocessOnly || outputDesc.formatting.lineMarks);
+    const bool writeLineMarkFilenamesInPP = (!outputDesc.options.preprocessOnly || IsLanguageHLSL(inputDesc.shaderVersion));
+
+    auto processedInput = PreProcessSource(
+        inputDesc,
+        writeLineMarksInPP,
+        writeLineMarkFilenamesInPP,
+        (reflectionData != nullptr ? &(reflectionData->macros) : nullptr)
+    );
+
+    if (!processedInput)
+        return ReturnWithError(R_PreProcessingSourceFailed);
+
+    if (outputDesc.options.preprocessOnly)
+    {
+        (*outputDesc.sourceCode) << processedInput->rdbuf();
+        return true;
+    }
+
+    /* ----- Shader cache ----- */
+
+    if (inputDesc.cache && IsShaderCacheable(outputDesc))
+    {
+        const auto processedCode = std::string(std::istreambuf_iterator<char>(*processedInput), std::istreambuf_iterator<char>());
+
+        return CompileWithCache(
+            *inputDesc.cache, inputDesc, outputDesc, reflectionData, processedCode,
+            [&](const ShaderOutput& cacheOutputDesc)
+            {
+                timePoints_.parser = Time::now();
+
+                auto program = ParseSource(inputDesc, cacheOutputDesc, std::make_shared<MemoryInputStream>(processedCode.data(), processedCode.size()));
+
+                if (!program)
+                    return ReturnWithError(R_ParsingSourceFailed);
+
+                return CompileProgram(*program, inputDesc, cacheOutputDesc, reflectionData);
+            }
+        );
+    }
+
+    /* ----- Parsing ----- */
+
+    timePoints_.parser = Time::now();
+
+    auto program = ParseSource(inputDesc, outputDesc, std::move(processedInput));
+
+    if (!program)
+        return ReturnWithError(R_ParsingSourceFailed);
+
+    return CompileProgram(*program, inputDesc, outputDesc, reflectionData);
+}
+
+std::unique_ptr<std::iostream> Compiler::PreProcessSource(
+    const ShaderInput&          inputDesc,
+    bool                        writeLineMarks,
+    bool                        writeLineMarkFilenames,
+    std::vector<std::string>*   definedMacros)
+{
     std::unique_ptr<IncludeHandler> stdIncludeHandler;
     if (!inputDesc.includeHandler)
         stdIncludeHandler = std::unique_ptr<IncludeHandler>(new IncludeHandler());
 
     auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
 
+    /* Load included files in the background while the source is pre-processed */
+    auto sourceStream = inputDesc.sourceCode;
+
+    std::unique_ptr<IncludePrefetcher> includePrefetcher;
+    if (inputDesc.prefetchIncludes && includeHandler->IsThreadSafe())
+    {
+        includePrefetcher   = MakeUnique<IncludePrefetcher>(*includeHandler);
+        sourceStream        = includePrefetcher->PrefetchSource(sourceStream);
+        includeHandler      = includePrefetcher.get();
+    }
+
     std::unique_ptr<PreProcessor> preProcessor;
 
     if (IsLanguageHLSL(inputDesc.shaderVersion))
@@ -157,45 +717,115 @@ bool Compiler::CompileShaderPrimary(
     else if (IsLanguageGLSL(inputDesc.shaderVersion))
         preProcessor = MakeUnique<GLSLPreProcessor>(*includeHandler, log_);
 
-    const bool writeLineMarksInPP = (!outputDesc.options.preprocessOnly || outputDesc.formatting.lineMarks);
-    const bool writeLineMarkFilenamesInPP = (!outputDesc.options.preprocessOnly || IsLanguageHLSL(inputDesc.shaderVersion));
+    /* Replace inclusion of the precompiled header, if it was created for the same shader version and line marks */
+    if (auto pch = inputDesc.precompiledHeader)
+    {
+        const auto& pchData = pch->data_->header;
+        const bool isCompatible =
+        (
+            pch->IsValid()                                                      &&
+            pchData.shaderVersion == static_cast<int>(inputDesc.shaderVersion)  &&
+            pchData.writeLineMarks == writeLineMarks                            &&
+            pchData.writeLineMarkFilenames == writeLineMarkFilenames
+        );
+
+        if (isCompatible)
+            preProcessor->UsePrecompiledHeader(&pchData);
+    }
 
     auto processedInput = preProcessor->Process(
-        std::make_shared<SourceCode>(inputDesc.sourceCode),
+        std::make_shared<SourceCode>(sourceStream),
         inputDesc.filename,
-        writeLineMarksInPP,
-        writeLineMarkFilenamesInPP,
-        ((inputDesc.warnings & Warnings::PreProcessor) != 0)
+        writeLineMarks,
+        writeLineMarkFilenames,
+        ((inputDesc.warnings & Warnings::PreProcessor) != 0),
+        inputDesc.predefinedMacros
     );
 
-    if (reflectionData)
-        reflectionData->macros = preProcessor->ListDefinedMacroIdents();
+    timePoints_.skippedIncludes = preProcessor->NumSkippedIncludes();
 
-    if (!processedInput)
-        return ReturnWithError(R_PreProcessingSourceFailed);
+    if (definedMacros)
+        *definedMacros = preProcessor->ListDefinedMacroIdents();
 
-    if (outputDesc.options.preprocessOnly)
+    return processedInput;
+}
+
+bool Compiler::IsTokenStreamSupported(const ShaderInput& inputDesc, const ShaderOutput& outputDesc) const
+{
+    /* Line marks and comments in the output, the shader cache, and precompiled headers require the pre-processed source code */
+    return
+    (
+        IsLanguageHLSL(inputDesc.shaderVersion)             &&
+        inputDesc.precompiledHeader == nullptr              &&
+        !outputDesc.options.preprocessOnly                  &&
+        !outputDesc.options.preserveComments                &&
+        !outputDesc.formatting.lineMarks                    &&
+        !(inputDesc.cache && IsShaderCacheable(outputDesc))
+    );
+}
+
+TokenStreamSourcePtr Compiler::PreProcessTokens(const ShaderInput& inputDesc, std::vector<std::string>* definedMacros)
+{
+    std::unique_ptr<IncludeHandler> stdIncludeHandler;
+    if (!inputDesc.includeHandler)
+        stdIncludeHandler = std::unique_ptr<IncludeHandler>(new IncludeHandler());
+
+    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : stdIncludeHandler.get());
+
+    /* Load included files in the background while the source is pre-processed */
+    auto sourceStream = inputDesc.sourceCode;
+
+    std::unique_ptr<IncludePrefetcher> includePrefetcher;
+    if (inputDesc.prefetchIncludes && includeHandler->IsThreadSafe())
     {
-        (*outputDesc.sourceCode) << processedInput->rdbuf();
-        return true;
+        includePrefetcher   = MakeUnique<IncludePrefetcher>(*includeHandler);
+        sourceStream        = includePrefetcher->PrefetchSource(sourceStream);
+        includeHandler      = includePrefetcher.get();
     }
 
-    /* ----- Parsing ----- */
+    PreProcessor preProcessor(*includeHandler, log_);
 
-    timePoints_.parser = Time::now();
+    auto processedTokens = preProcessor.ProcessTokens(
+        std::make_shared<SourceCode>(sourceStream),
+        inputDesc.filename,
+        ((inputDesc.warnings & Warnings::PreProcessor) != 0),
+        inputDesc.predefinedMacros
+    );
+
+    timePoints_.skippedIncludes = preProcessor.NumSkippedIncludes();
+
+    if (definedMacros)
+        *definedMacros = preProcessor.ListDefinedMacroIdents();
+
+    return processedTokens;
+}
 
-    std::unique_ptr<IntrinsicAdept> intrinsicAdpet;
+void Compiler::EstablishIntrinsicAdept()
+{
+    //TODO: use 'GLSLIntrinsicAdept' for GLSL input code
+    if (!intrinsicAdept_)
+        intrinsicAdept_ = MakeUnique<HLSLIntrinsicAdept>();
+
+    /* Re-activate intrinsic adept, since it might be used across several compilations */
+    intrinsicAdept_->Activate();
+}
+
+ProgramPtr Compiler::ParseSource(
+    const ShaderInput&                      inputDesc,
+    const ShaderOutput&                     outputDesc,
+    const std::shared_ptr<std::istream>&    processedInput)
+{
     ProgramPtr program;
 
+    EstablishIntrinsicAdept();
+
     if (IsLanguageHLSL(inputDesc.shaderVersion))
     {
-        /* Establish intrinsic adept */
-        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
-
         /* Parse HLSL input code */
         HLSLParser parser(log_);
+        EnableLazyFunctionBodies(parser, inputDesc, outputDesc);
         program = parser.ParseSource(
-            std::make_shared<SourceCode>(std::move(processedInput)),
+            std::make_shared<SourceCode>(processedInput),
             outputDesc.nameMangling,
             inputDesc.shaderVersion,
             outputDesc.options.rowMajorAlignment,
@@ -204,25 +834,128 @@ bool Compiler::CompileShaderPrimary(
     }
     else if (IsLanguageGLSL(inputDesc.shaderVersion))
     {
-        /* Establish intrinsic adept */
-        #if 0
-        intrinsicAdpet = MakeUnique<GLSLIntrinsicAdept>();
-        #else //!!!
-        intrinsicAdpet = MakeUnique<HLSLIntrinsicAdept>();
-        #endif
-
         /* Parse GLSL input code */
         GLSLParser parser(log_);
         program = parser.ParseSource(
-            std::make_shared<SourceCode>(std::move(processedInput)),
+            std::make_shared<SourceCode>(processedInput),
             outputDesc.nameMangling,
             inputDesc.shaderVersion,
             ((inputDesc.warnings & Warnings::Syntax) != 0)
         );
     }
 
-    if (!program)
-        return ReturnWithError(R_ParsingSourceFailed);
+    return program;
+}
+
+ProgramPtr Compiler::ParseTokens(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    const TokenStreamSourcePtr& processedTokens)
+{
+    EstablishIntrinsicAdept();
+
+    HLSLParser parser(log_);
+    EnableLazyFunctionBodies(parser, inputDesc, outputDesc);
+    return parser.ParseTokens(
+        processedTokens,
+        outputDesc.nameMangling,
+        inputDesc.shaderVersion,
+        outputDesc.options.rowMajorAlignment,
+        ((inputDesc.warnings & Warnings::Syntax) != 0)
+    );
+}
+
+bool Compiler::CompileWithCache(
+    ShaderCache&                                        cache,
+    const ShaderInput&                                  inputDesc,
+    const ShaderOutput&                                 outputDesc,
+    Reflection::ReflectionData*                         reflectionData,
+    const std::string&                                  processedCode,
+    const std::function<bool(const ShaderOutput&)>&     compileCallback)
+{
+    const auto key = MakeShaderCacheKey(inputDesc, outputDesc, processedCode, (reflectionData != nullptr));
+
+    ShaderCacheEntry entry;
+
+    /* Load compilation result from cache, and skip all further compiler stages */
+    std::string entryData;
+    if (cache.Load(key, entryData) && ReadShaderCacheEntry(entryData, entry))
+    {
+        if (log_)
+        {
+            for (const auto& report : entry.reports)
+                log_->SubmitReport(report);
+        }
+
+        (*outputDesc.sourceCode) << entry.outputCode;
+
+        if (reflectionData && entry.hasReflection)
+        {
+            /* Keep defined macros of the current pre-processing, since they are not part of the cache key */
+            auto definedMacros = std::move(reflectionData->macros);
+            *reflectionData = std::move(entry.reflectionData);
+            reflectionData->macros = std::move(definedMacros);
+        }
+
+        timePoints_.parser      = Time::now();
+        timePoints_.analyzer    = timePoints_.parser;
+        timePoints_.optimizer   = timePoints_.parser;
+        timePoints_.generation  = timePoints_.parser;
+        timePoints_.reflection  = timePoints_.parser;
+
+        return true;
+    }
+
+    /* Compile into temporary output stream and record all reports */
+    std::stringstream outputCode;
+
+    auto cacheOutputDesc = outputDesc;
+    cacheOutputDesc.sourceCode = &outputCode;
+
+    ShaderCacheLog cacheLog(log_, entry.reports);
+
+    auto prevLog = log_;
+    log_ = &cacheLog;
+
+    bool result = false;
+
+    try
+    {
+        result = compileCallback(cacheOutputDesc);
+    }
+    catch (...)
+    {
+        log_ = prevLog;
+        throw;
+    }
+
+    log_ = prevLog;
+
+    /* Only store successful compilations in the cache */
+    entry.outputCode = outputCode.str();
+    (*outputDesc.sourceCode) << entry.outputCode;
+
+    if (result)
+    {
+        if (reflectionData)
+        {
+            entry.hasReflection     = true;
+            entry.reflectionData    = *reflectionData;
+            entry.reflectionData.macros.clear();
+        }
+        cache.Store(key, WriteShaderCacheEntry(entry));
+    }
+
+    return result;
+}
+
+bool Compiler::CompileProgram(
+    Program&                    program,
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Reflection::ReflectionData* reflectionData)
+{
+    EstablishIntrinsicAdept();
 
     /* ----- Context analysis ----- */
 
@@ -232,16 +965,22 @@ bool Compiler::CompileShaderPrimary(
 
     if (IsLanguageHLSL(inputDesc.shaderVersion))
     {
-        /* Analyse HLSL program */
-        HLSLAnalyzer analyzer(log_);
-        analyzerResult = analyzer.DecorateAST(*program, inputDesc, outputDesc);
+        /* Analyse HLSL program with a memo for overload resolution (only valid while the AST is not modified) */
+        OverloadCache overloadCache;
+        {
+            OverloadCacheScope overloadCacheScope(overloadCache);
+            HLSLAnalyzer analyzer(log_);
+            analyzerResult = analyzer.DecorateAST(program, inputDesc, outputDesc);
+        }
+        timePoints_.overloadCacheLookups    = overloadCache.NumLookups();
+        timePoints_.overloadCacheHits       = overloadCache.NumHits();
     }
 
     /* Print AST */
     if (outputDesc.options.showAST)
     {
         ASTPrinter printer;
-        printer.PrintAST(program.get());
+        printer.PrintAST(&program);
     }
 
     if (!analyzerResult)
@@ -253,7 +992,7 @@ bool Compiler::CompileShaderPrimary(
     if (outputDesc.options.optimize)
     {
         Optimizer optimizer;
-        optimizer.Optimize(*program);
+        optimizer.Optimize(program);
     }
 
     /* ----- Code generation ----- */
@@ -266,7 +1005,7 @@ bool Compiler::CompileShaderPrimary(
     {
         /* Generate GLSL output code */
         GLSLGenerator generator(log_);
-        generatorResult = generator.GenerateCode(*program, inputDesc, outputDesc, log_);
+        generatorResult = generator.GenerateCode(program, inputDesc, outputDesc, log_);
     }
 
     if (!generatorResult)
@@ -280,7 +1019,7 @@ bool Compiler::CompileShaderPrimary(
     {
         ReflectionAnalyzer reflectAnalyzer(log_);
         reflectAnalyzer.Reflect(
-            *program, inputDesc.shaderTarget, *reflectionData,
+            program, inputDesc.shaderTarget, *reflectionData,
             ((inputDesc.warnings & Warnings::CodeReflection) != 0)
         );
     }
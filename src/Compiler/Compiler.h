@@ -10,14 +10,21 @@
 
 
 #include <Xsc/Xsc.h>
+#include "Visitor.h"
+#include "TokenStreamSource.h"
+#include "MemoryStream.h"
+#include "Atom.h"
 #include <chrono>
 #include <array>
+#include <functional>
 
 
 namespace Xsc
 {
 
 
+class IntrinsicAdept;
+
 // Compiler driver class.
 class Compiler
 {
@@ -36,9 +43,23 @@ class Compiler
             TimePoint optimizer;
             TimePoint generation;
             TimePoint reflection;
+
+            std::size_t overloadCacheLookups    = 0;    // Number of lookups in the overload resolution cache.
+            std::size_t overloadCacheHits       = 0;    // Number of lookups that have been served by the overload resolution cache.
+            std::size_t skippedIncludes         = 0;    // Number of re-inclusions that have been skipped due to an include guard.
         };
 
         Compiler(Log* log = nullptr);
+        ~Compiler();
+
+        // Sets the output log for all following compilations.
+        void SetLog(Log* log);
+
+        // Establishes the intrinsic adept and initializes all static keyword tables in advance.
+        void WarmUp();
+
+        // Submits the timings of all compiler stages to the specified log.
+        static void PrintStageTimings(Log* log, const StageTimePoints& timePoints);
 
         bool CompileShader(
             const ShaderInput&          inputDesc,
@@ -47,6 +68,22 @@ class Compiler
             StageTimePoints*            stageTimePoints = nullptr
         );
 
+        // Compiles all batch jobs from the same input source, which is pre-processed only once.
+        bool CompileShaderBatch(
+            const ShaderInput&                  inputDesc,
+            const std::vector<ShaderBatchJob>&  jobs,
+            std::vector<bool>*                  jobResults      = nullptr,
+            std::vector<StageTimePoints>*       stageTimePoints = nullptr
+        );
+
+        // Compiles the input source for each permutation of the macro matrix, and compiles each unique pre-processed source only once.
+        bool CompileShaderPermutations(
+            const ShaderInput&                      inputDesc,
+            const ShaderOutput&                     outputDesc,
+            const std::vector<PermutationMacro>&    macroMatrix,
+            ShaderPermutationResult&                permutationResult
+        );
+
     private:
 
         /* === Functions === */
@@ -56,17 +93,81 @@ class Compiler
 
         void ValidateArguments(const ShaderInput& inputDesc, const ShaderOutput& outputDesc);
 
+        // Returns a copy of the output descriptor which is prepared for the compilation (e.g. dummy output stream for validation, or stream for the output callback).
+        ShaderOutput PrepareOutputDesc(const ShaderInput& inputDesc, const ShaderOutput& outputDesc, CallbackOutputStream& callbackOutputStream);
+
         bool CompileShaderPrimary(
             const ShaderInput&          inputDesc,
             const ShaderOutput&         outputDesc,
             Reflection::ReflectionData* reflectionData
         );
 
+        // Pre-processes the input source code and returns the output stream, or null on failure.
+        std::unique_ptr<std::iostream> PreProcessSource(
+            const ShaderInput&          inputDesc,
+            bool                        writeLineMarks,
+            bool                        writeLineMarkFilenames,
+            std::vector<std::string>*   definedMacros   = nullptr
+        );
+
+        // Returns true if the pre-processor tokens can be handed over to the parser directly, i.e. the pre-processed source code is not required.
+        bool IsTokenStreamSupported(const ShaderInput& inputDesc, const ShaderOutput& outputDesc) const;
+
+        // Pre-processes the HLSL input source code and returns the output tokens, or null on failure.
+        TokenStreamSourcePtr PreProcessTokens(
+            const ShaderInput&          inputDesc,
+            std::vector<std::string>*   definedMacros   = nullptr
+        );
+
+        // Creates the intrinsic adept (if not already done) and makes it the active instance for the current thread.
+        void EstablishIntrinsicAdept();
+
+        // Parses the pre-processed source code and returns the program AST, or null on failure.
+        ProgramPtr ParseSource(
+            const ShaderInput&                      inputDesc,
+            const ShaderOutput&                     outputDesc,
+            const std::shared_ptr<std::istream>&    processedInput
+        );
+
+        // Parses the output tokens of the HLSL pre-processor and returns the program AST, or null on failure.
+        ProgramPtr ParseTokens(
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            const TokenStreamSourcePtr& processedTokens
+        );
+
+        /*
+        Loads the compilation result of the pre-processed source code from the shader cache,
+        or compiles it with the specified callback and stores the result in the shader cache.
+        The callback receives a copy of the output descriptor with a temporary output stream.
+        */
+        bool CompileWithCache(
+            ShaderCache&                                        cache,
+            const ShaderInput&                                  inputDesc,
+            const ShaderOutput&                                 outputDesc,
+            Reflection::ReflectionData*                         reflectionData,
+            const std::string&                                  processedCode,
+            const std::function<bool(const ShaderOutput&)>&     compileCallback
+        );
+
+        // Runs context analysis, optimization, code generation, and code reflection on the specified program.
+        bool CompileProgram(
+            Program&                    program,
+            const ShaderInput&          inputDesc,
+            const ShaderOutput&         outputDesc,
+            Reflection::ReflectionData* reflectionData
+        );
+
         /* === Members === */
 
-        Log*            log_        = nullptr;
+        Log*                            log_            = nullptr;
+
+        std::unique_ptr<IntrinsicAdept> intrinsicAdept_;
+
+        // Atom table for all token spellings and identifiers of the current compilation.
+        AtomTable                       atomTable_;
 
-        StageTimePoints timePoints_;
+        StageTimePoints                 timePoints_;
 
 };
 
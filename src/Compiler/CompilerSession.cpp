@@ -0,0 +1,118 @@
+/*
+ * CompilerSession.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/CompilerSession.h>
+#include "Compiler.h"
+
+
+namespace Xsc
+{
+
+
+/*
+ * CompilerSession class
+ */
+
+struct CompilerSession::OpaqueData
+{
+    Compiler                compiler;
+    CachingIncludeHandler   includeHandler;
+};
+
+CompilerSession::CompilerSession() :
+    data_ { new OpaqueData() }
+{
+    data_->compiler.WarmUp();
+}
+
+CompilerSession::~CompilerSession()
+{
+    delete data_;
+}
+
+bool CompilerSession::CompileShader(
+    const ShaderInput&          inputDesc,
+    const ShaderOutput&         outputDesc,
+    Log*                        log,
+    Reflection::ReflectionData* reflectionData)
+{
+    /* Use default include handler of this session */
+    auto inputDescCopy = inputDesc;
+    if (!inputDescCopy.includeHandler)
+        inputDescCopy.includeHandler = &(data_->includeHandler);
+
+    /* Compile shader with persistent compiler driver */
+    Compiler::StageTimePoints timePoints;
+
+    data_->compiler.SetLog(log);
+
+    auto result = data_->compiler.CompileShader(
+        inputDescCopy,
+        outputDesc,
+        reflectionData,
+        &timePoints
+    );
+
+    /* Show timings */
+    if (outputDesc.options.showTimes && log)
+        Compiler::PrintStageTimings(log, timePoints);
+
+    return result;
+}
+
+bool CompilerSession::CompileShaderBatch(
+    const ShaderInput&                  inputDesc,
+    const std::vector<ShaderBatchJob>&  jobs,
+    Log*                                log,
+    std::vector<bool>*                  jobResults)
+{
+    /* Use default include handler of this session */
+    auto inputDescCopy = inputDesc;
+    if (!inputDescCopy.includeHandler)
+        inputDescCopy.includeHandler = &(data_->includeHandler);
+
+    /* Compile all jobs with persistent compiler driver */
+    std::vector<Compiler::StageTimePoints> timePoints;
+
+    data_->compiler.SetLog(log);
+
+    auto result = data_->compiler.CompileShaderBatch(
+        inputDescCopy,
+        jobs,
+        jobResults,
+        &timePoints
+    );
+
+    /* Show timings of each job */
+    if (log)
+    {
+        for (std::size_t i = 0; i < jobs.size() && i < timePoints.size(); ++i)
+        {
+            if (jobs[i].outputDesc.options.showTimes)
+                Compiler::PrintStageTimings(log, timePoints[i]);
+        }
+    }
+
+    return result;
+}
+
+IncludeHandler& CompilerSession::GetIncludeHandler()
+{
+    return data_->includeHandler;
+}
+
+void CompilerSession::ClearIncludeCache()
+{
+    data_->includeHandler.Clear();
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
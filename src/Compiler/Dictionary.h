@@ -9,7 +9,7 @@
 #define XSC_DICTIONARY_H
 
 
-#include <map>
+#include "PerfectHashMap.h"
 #include <string>
 #include <vector>
 #include <initializer_list>
@@ -31,7 +31,7 @@ class Dictionary
         Dictionary(const Dictionary&) = default;
 
         Dictionary(const std::initializer_list<std::pair<std::string, T>>& stringToEnumPairs) :
-            stringToEnum_ { stringToEnumPairs.begin(), stringToEnumPairs.end() }
+            stringToEnum_ { stringToEnumPairs }
         {
             /* Reserve container memory in advance */
             std::size_t maxIndex = 0;
@@ -39,17 +39,17 @@ class Dictionary
             for (const auto& pair : stringToEnumPairs)
                 maxIndex = std::max(maxIndex, static_cast<std::size_t>(pair.second));
 
-            enumToString_.resize(maxIndex + 1, nullptr);
+            enumToString_.resize(maxIndex + 1, invalidIndex);
 
-            /* Insert references to strings in map */
+            /* Insert indices of strings in map (the first string of an enumeration entry is used) */
             for (const auto& pair : stringToEnumPairs)
             {
                 const auto idx = static_cast<std::size_t>(pair.second);
-                if (enumToString_[idx] == nullptr)
+                if (enumToString_[idx] == invalidIndex)
                 {
                     auto it = stringToEnum_.find(pair.first);
                     if (it != stringToEnum_.end())
-                        enumToString_[idx] = &(it->first);
+                        enumToString_[idx] = static_cast<std::size_t>(it - stringToEnum_.begin());
                 }
             }
         }
@@ -78,8 +78,8 @@ class Dictionary
         const std::string* EnumToString(const T& e) const
         {
             const auto idx = static_cast<std::size_t>(e);
-            if (idx < enumToString_.size())
-                return enumToString_[idx];
+            if (idx < enumToString_.size() && enumToString_[idx] != invalidIndex)
+                return &(stringToEnum_.begin()[enumToString_[idx]].first);
             else
                 return nullptr;
         }
@@ -88,21 +88,24 @@ class Dictionary
         std::string EnumToStringOrDefault(const T& e, const std::string& defaultString) const
         {
             const auto idx = static_cast<std::size_t>(e);
-            if (idx < enumToString_.size())
-            {
-                if (auto s = enumToString_[idx])
-                    return *s;
-            }
-            return defaultString;
+            if (idx < enumToString_.size() && enumToString_[idx] != invalidIndex)
+                return stringToEnum_.begin()[enumToString_[idx]].first;
+            else
+                return defaultString;
         }
 
     private:
 
-        std::map<std::string, T>        stringToEnum_;
-        std::vector<const std::string*> enumToString_;
+        static const std::size_t invalidIndex = ~std::size_t(0);
+
+        PerfectHashMap<T>           stringToEnum_;
+        std::vector<std::size_t>    enumToString_;  // Index of the first string in 'stringToEnum_' for each enumeration entry.
 
 };
 
+template <typename T>
+const std::size_t Dictionary<T>::invalidIndex;
+
 
 } // /namespace Xsc
 
@@ -132,7 +132,7 @@ void Analyzer::CloseScope()
     symTable_.CloseScope(std::bind(&Analyzer::OnReleaseSymbol, this, std::placeholders::_1));
 }
 
-void Analyzer::Register(const std::string& ident, AST* ast)
+void Analyzer::Register(const Atom& ident, AST* ast)
 {
     try
     {
@@ -153,7 +153,7 @@ void Analyzer::Register(const std::string& ident, AST* ast)
 }
 
 //TODO: first fetch from local scope, then structure, then global scope
-AST* Analyzer::Fetch(const std::string& ident, const AST* ast)
+AST* Analyzer::Fetch(const Atom& ident, const AST* ast)
 {
     try
     {
@@ -179,7 +179,7 @@ AST* Analyzer::Fetch(const std::string& ident, const AST* ast)
     return nullptr;
 }
 
-AST* Analyzer::FetchFromCurrentScopeOrNull(const std::string& ident) const
+AST* Analyzer::FetchFromCurrentScopeOrNull(const Atom& ident) const
 {
     /* Fetch symbol from current scope of global symbol table */
     if (auto symbol = symTable_.FetchFromCurrentScope(ident))
@@ -188,7 +188,7 @@ AST* Analyzer::FetchFromCurrentScopeOrNull(const std::string& ident) const
         return nullptr;
 }
 
-Decl* Analyzer::FetchDecl(const std::string& ident, const AST* ast)
+Decl* Analyzer::FetchDecl(const Atom& ident, const AST* ast)
 {
     if (auto symbol = Fetch(ident, ast))
     {
@@ -200,7 +200,7 @@ Decl* Analyzer::FetchDecl(const std::string& ident, const AST* ast)
     return nullptr;
 }
 
-Decl* Analyzer::FetchType(const std::string& ident, const AST* ast)
+Decl* Analyzer::FetchType(const Atom& ident, const AST* ast)
 {
     try
     {
@@ -216,7 +216,7 @@ Decl* Analyzer::FetchType(const std::string& ident, const AST* ast)
     return nullptr;
 }
 
-VarDecl* Analyzer::FetchVarDecl(const std::string& ident, const AST* ast)
+VarDecl* Analyzer::FetchVarDecl(const Atom& ident, const AST* ast)
 {
     try
     {
@@ -232,7 +232,7 @@ VarDecl* Analyzer::FetchVarDecl(const std::string& ident, const AST* ast)
     return nullptr;
 }
 
-FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const std::vector<ExprPtr>& args, const AST* ast)
+FunctionDecl* Analyzer::FetchFunctionDecl(const Atom& ident, const std::vector<ExprPtr>& args, const AST* ast)
 {
     try
     {
@@ -269,7 +269,7 @@ FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const std::v
     return nullptr;
 }
 
-FunctionDecl* Analyzer::FetchFunctionDecl(const std::string& ident, const AST* ast)
+FunctionDecl* Analyzer::FetchFunctionDecl(const Atom& ident, const AST* ast)
 {
     try
     {
@@ -342,7 +342,7 @@ FunctionDecl* Analyzer::FetchFunctionDeclFromStruct(
     return nullptr;
 }
 
-StructDecl* Analyzer::FetchStructDeclFromIdent(const std::string& ident, const AST* ast)
+StructDecl* Analyzer::FetchStructDeclFromIdent(const Atom& ident, const AST* ast)
 {
     if (auto symbol = FetchType(ident, ast))
     {
@@ -448,7 +448,7 @@ void Analyzer::AnalyzeAliasTypeDenoter(TypeDenoterPtr& typeDenoter, const AST* a
                 if (auto structDecl = symbol->As<StructDecl>())
                 {
                     /* Replace type denoter by a struct type denoter */
-                    typeDenoter = std::make_shared<StructTypeDenoter>(structDecl);
+                    typeDenoter = MakeShared<StructTypeDenoter>(structDecl);
                 }
                 else if (auto aliasDecl = symbol->As<AliasDecl>())
                 {
@@ -81,28 +81,28 @@ class Analyzer : protected VisitorTracker
         void CloseScope();
 
         // Registers the AST node in the current scope with the specified identifier.
-        void Register(const std::string& ident, AST* ast);
+        void Register(const Atom& ident, AST* ast);
 
         // Tries to fetch an AST node with the specified identifier from the symbol table and reports an error on failure.
-        AST* Fetch(const std::string& ident, const AST* ast = nullptr);
+        AST* Fetch(const Atom& ident, const AST* ast = nullptr);
 
         // Tries to fetch an AST node with the specified identifier from the current scope of the symbol table and returns null on failure.
-        AST* FetchFromCurrentScopeOrNull(const std::string& ident) const;
+        AST* FetchFromCurrentScopeOrNull(const Atom& ident) const;
 
         // Tries to fetch a declaration node with the specified identifier from the symbol table and reports an error on failure.
-        Decl* FetchDecl(const std::string& ident, const AST* ast = nullptr);
+        Decl* FetchDecl(const Atom& ident, const AST* ast = nullptr);
 
         // Tries to fetch a 'StructDecl' or 'AliasDecl' with the specified identifier from the symbol table and reports an error on failure.
-        Decl* FetchType(const std::string& ident, const AST* ast = nullptr);
+        Decl* FetchType(const Atom& ident, const AST* ast = nullptr);
 
         // Tries to fetch a 'VarDecl' with the specified identifier from the symbol table and reports an error on failure.
-        VarDecl* FetchVarDecl(const std::string& ident, const AST* ast = nullptr);
+        VarDecl* FetchVarDecl(const Atom& ident, const AST* ast = nullptr);
 
         // Tries to fetch a 'FunctionDecl' with the specified identifier and arguments from the symbol table and reports an error on failure.
-        FunctionDecl* FetchFunctionDecl(const std::string& ident, const std::vector<ExprPtr>& args, const AST* ast = nullptr);
+        FunctionDecl* FetchFunctionDecl(const Atom& ident, const std::vector<ExprPtr>& args, const AST* ast = nullptr);
 
         // Tries to fetch a 'FunctionDecl' with the specified identifier from the symbol table and reports an error on failure (used for patch-constant-function).
-        FunctionDecl* FetchFunctionDecl(const std::string& ident, const AST* ast = nullptr);
+        FunctionDecl* FetchFunctionDecl(const Atom& ident, const AST* ast = nullptr);
 
         // Tries to fetch a 'VarDecl' with the specified identifier from the structure type denoter and reports an error on failure.
         VarDecl* FetchVarDeclFromStruct(const StructTypeDenoter& structTypeDenoter, const std::string& ident, const AST* ast = nullptr);
@@ -112,7 +112,7 @@ class Analyzer : protected VisitorTracker
             const std::vector<ExprPtr>& args, const AST* ast = nullptr
         );
 
-        StructDecl* FetchStructDeclFromIdent(const std::string& ident, const AST* ast = nullptr);
+        StructDecl* FetchStructDeclFromIdent(const Atom& ident, const AST* ast = nullptr);
         StructDecl* FetchStructDeclFromTypeDenoter(const TypeDenoter& typeDenoter);
 
         // Tries to find a type compatible structure declaration within the current scope.
@@ -10,6 +10,7 @@
 #include "Helper.h"
 #include "ReportIdents.h"
 #include "Exception.h"
+#include <map>
 
 
 namespace Xsc
@@ -903,7 +903,7 @@ StmntPtr GLSLParser::ParseStmntWithIdent()
         auto ast = Make<VarDeclStmnt>();
 
         ast->typeSpecifier              = Make<TypeSpecifier>();
-        ast->typeSpecifier->typeDenoter = ParseTypeDenoterWithArrayOpt(std::make_shared<StructTypeDenoter>(objectExpr->ident));
+        ast->typeSpecifier->typeDenoter = ParseTypeDenoterWithArrayOpt(MakeShared<StructTypeDenoter>(objectExpr->ident));
 
         UpdateSourceArea(ast->typeSpecifier, objectExpr.get());
 
@@ -1312,7 +1312,7 @@ TypeDenoterPtr GLSLParser::ParseTypeDenoter(bool allowVoidType, StructDeclPtr* s
         if (Is(Tokens::LParen))
         {
             /* Make array type denoter */
-            typeDenoter = std::make_shared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
+            typeDenoter = MakeShared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
         }
 
         return typeDenoter;
@@ -1350,7 +1350,7 @@ TypeDenoterPtr GLSLParser::ParseTypeDenoterWithStructDeclOpt(StructDeclPtr& stru
 VoidTypeDenoterPtr GLSLParser::ParseVoidTypeDenoter()
 {
     Accept(Tokens::Void);
-    return std::make_shared<VoidTypeDenoter>();
+    return VoidTypeDenoter::GetCanonical();
 }
 
 BaseTypeDenoterPtr GLSLParser::ParseBaseTypeDenoter()
@@ -1360,8 +1360,7 @@ BaseTypeDenoterPtr GLSLParser::ParseBaseTypeDenoter()
         auto keyword = AcceptIt()->Spell();
 
         /* Make base type denoter by data type keyword */
-        auto typeDenoter = std::make_shared<BaseTypeDenoter>();
-        typeDenoter->dataType = ParseDataType(keyword);
+        auto typeDenoter = BaseTypeDenoter::GetCanonical(ParseDataType(keyword));
         return typeDenoter;
     }
     ErrorUnexpected(R_ExpectedBaseTypeDen, nullptr, true);
@@ -1372,14 +1371,14 @@ BufferTypeDenoterPtr GLSLParser::ParseBufferTypeDenoter()
 {
     /* Make buffer type denoter */
     Accept(Tokens::StorageBuffer);
-    return std::make_shared<BufferTypeDenoter>(BufferType::GenericBuffer);
+    return MakeShared<BufferTypeDenoter>(BufferType::GenericBuffer);
 }
 
 SamplerTypeDenoterPtr GLSLParser::ParseSamplerTypeDenoter()
 {
     /* Make sampler type denoter */
     auto samplerType = ParseSamplerType();
-    return std::make_shared<SamplerTypeDenoter>(samplerType);
+    return MakeShared<SamplerTypeDenoter>(samplerType);
 }
 
 StructTypeDenoterPtr GLSLParser::ParseStructTypeDenoter()
@@ -1392,7 +1391,7 @@ StructTypeDenoterPtr GLSLParser::ParseStructTypeDenoter()
     auto ident = ParseIdent();
 
     /* Make struct type denoter */
-    auto typeDenoter = std::make_shared<StructTypeDenoter>(ident);
+    auto typeDenoter = MakeShared<StructTypeDenoter>(ident);
 
     return typeDenoter;
 }
@@ -1408,7 +1407,7 @@ StructTypeDenoterPtr GLSLParser::ParseStructTypeDenoterWithStructDeclOpt(StructD
         structDecl = ParseStructDecl(false);
 
         /* Make struct type denoter with reference to the structure of this alias decl */
-        return std::make_shared<StructTypeDenoter>(structDecl.get());
+        return MakeShared<StructTypeDenoter>(structDecl.get());
     }
     else
     {
@@ -1421,12 +1420,12 @@ StructTypeDenoterPtr GLSLParser::ParseStructTypeDenoterWithStructDeclOpt(StructD
             structDecl = ParseStructDecl(false, structIdentTkn);
 
             /* Make struct type denoter with reference to the structure of this alias decl */
-            return std::make_shared<StructTypeDenoter>(structDecl.get());
+            return MakeShared<StructTypeDenoter>(structDecl.get());
         }
         else
         {
             /* Make struct type denoter without struct decl */
-            return std::make_shared<StructTypeDenoter>(structIdentTkn->Spell());
+            return MakeShared<StructTypeDenoter>(structIdentTkn->Spell());
         }
     }
 }
@@ -11,6 +11,7 @@
 #include "Exception.h"
 #include "Helper.h"
 #include "ReportIdents.h"
+#include "FuncReachabilityAnalyzer.h"
 
 
 namespace Xsc
@@ -59,6 +60,10 @@ void HLSLAnalyzer::DecorateASTPrimary(
     extensions_             = inputDesc.extensions;
     #endif // XSC_ENABLE_LANGUAGE_EXT
 
+    /* Only analyze the functions that can be reached from the entry point, unless all functions are validated */
+    if (!outputDesc.options.validateAll && !entryPoint_.empty())
+        DiscardUnreachableFunctionBodies(program);
+
     /* Decorate program AST */
     program_ = &program;
 
@@ -83,6 +88,18 @@ void HLSLAnalyzer::ErrorIfAttributeNotFound(bool found, const std::string& attri
         Error(R_MissingAttributeForEntryPoint(attribDesc), nullptr);
 }
 
+void HLSLAnalyzer::DiscardUnreachableFunctionBodies(Program& program)
+{
+    std::vector<std::string> entryPoints { entryPoint_ };
+    if (!secondaryEntryPoint_.empty())
+        entryPoints.push_back(secondaryEntryPoint_);
+
+    /* Unreachable functions remain as forward declarations, which are neither analyzed nor generated */
+    FuncReachabilityAnalyzer reachabilityAnalyzer;
+    for (auto funcDecl : reachabilityAnalyzer.FindUnreachableFunctions(program, entryPoints))
+        funcDecl->codeBlock.reset();
+}
+
 bool HLSLAnalyzer::IsD3D9ShaderModel() const
 {
     return (versionIn_ <= InputShaderVersion::HLSL3);
@@ -55,6 +55,9 @@ class HLSLAnalyzer : public Analyzer
 
         void ErrorIfAttributeNotFound(bool found, const std::string& attribDesc);
 
+        // Discards the bodies of all global functions that can not be reached from the entry points.
+        void DiscardUnreachableFunctionBodies(Program& program);
+
         // Returns true, if the input shader version if either HLSL3 or Cg.
         bool IsD3D9ShaderModel() const;
 
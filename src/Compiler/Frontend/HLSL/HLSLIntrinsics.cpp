@@ -339,7 +339,7 @@ TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const std::vector<Expr
         /* Return fixed base type denoter */
         const auto returnTypeFixed = IntrinsicReturnTypeToDataType(returnType);
         if (returnTypeFixed != DataType::Undefined)
-            return std::make_shared<BaseTypeDenoter>(returnTypeFixed);
+            return BaseTypeDenoter::GetCanonical(returnTypeFixed);
 
         /* Take type denoter from argument */
         const auto returnTypeByArgIndex = IntrinsicReturnTypeToArgIndex(returnType);
@@ -348,7 +348,7 @@ TypeDenoterPtr IntrinsicSignature::GetTypeDenoterWithArgs(const std::vector<Expr
     }
 
     /* Return default void type denoter */
-    return std::make_shared<VoidTypeDenoter>();
+    return VoidTypeDenoter::GetCanonical();
 }
 
 static std::map<Intrinsic, IntrinsicSignature> GenerateIntrinsicSignatureMap()
@@ -809,7 +809,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
         if (type1->IsVector())
         {
             auto baseDataType0 = BaseDataType(static_cast<BaseTypeDenoter&>(*type0).dataType);
-            return std::make_shared<BaseTypeDenoter>(baseDataType0);
+            return BaseTypeDenoter::GetCanonical(baseDataType0);
         }
 
         /* Vector x Matrix = Vector */
@@ -818,7 +818,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto dataType1      = static_cast<BaseTypeDenoter&>(*type1).dataType;
             auto baseDataType1  = BaseDataType(dataType1);
             auto matrixTypeDim1 = MatrixTypeDim(dataType1);
-            return std::make_shared<BaseTypeDenoter>(VectorDataType(baseDataType1, matrixTypeDim1.second));
+            return BaseTypeDenoter::GetCanonical(VectorDataType(baseDataType1, matrixTypeDim1.second));
         }
     }
 
@@ -834,7 +834,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto dataType0      = static_cast<BaseTypeDenoter&>(*type0).dataType;
             auto baseDataType0  = BaseDataType(dataType0);
             auto matrixTypeDim0 = MatrixTypeDim(dataType0);
-            return std::make_shared<BaseTypeDenoter>(VectorDataType(baseDataType0, matrixTypeDim0.first));
+            return BaseTypeDenoter::GetCanonical(VectorDataType(baseDataType0, matrixTypeDim0.first));
         }
 
         /* Matrix x Matrix = Matrix */
@@ -850,7 +850,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeMulPrimary(const std::vector<
             auto matrixTypeDim1 = MatrixTypeDim(dataType1);
 
             /* Return matrix type with dimension NxM */
-            return std::make_shared<BaseTypeDenoter>(MatrixDataType(baseDataType0, matrixTypeDim0.first, matrixTypeDim1.second));
+            return BaseTypeDenoter::GetCanonical(MatrixDataType(baseDataType0, matrixTypeDim0.first, matrixTypeDim1.second));
         }
     }
 
@@ -871,7 +871,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTranspose(const std::vector<E
         auto arg0DataType       = static_cast<const BaseTypeDenoter&>(arg0TypeDen).dataType;
         auto arg0BaseDataType   = BaseDataType(arg0DataType);
         auto arg0MatrixTypeDim  = MatrixTypeDim(arg0DataType);
-        return std::make_shared<BaseTypeDenoter>(MatrixDataType(arg0BaseDataType, arg0MatrixTypeDim.second, arg0MatrixTypeDim.first));
+        return BaseTypeDenoter::GetCanonical(MatrixDataType(arg0BaseDataType, arg0MatrixTypeDim.second, arg0MatrixTypeDim.first));
     }
 
     RuntimeErr(R_InvalidIntrinsicArgs("transpose"));
@@ -888,7 +888,7 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeVectorCompare(const std::vect
     if (auto arg0BaseTypeDen = arg0TypeDen->As<BaseTypeDenoter>())
     {
         const auto vecTypeSize = VectorTypeDim(arg0BaseTypeDen->dataType);
-        return std::make_shared<BaseTypeDenoter>(VectorDataType(DataType::Bool, vecTypeSize));
+        return BaseTypeDenoter::GetCanonical(VectorDataType(DataType::Bool, vecTypeSize));
     }
 
     return arg0TypeDen;
@@ -905,21 +905,21 @@ TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureSample(const BaseTypeD
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureSampleCmp(const BaseTypeDenoterPtr& /*genericTypeDenoter*/) const
 {
     /* Always return single float type */
-    return std::make_shared<BaseTypeDenoter>(DataType::Float);
+    return BaseTypeDenoter::GetCanonical(DataType::Float);
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/bb944003(v=vs.85).aspx
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureGather(const BaseTypeDenoterPtr& genericTypeDenoter) const
 {
     /* Always return 4D-vector of generic data type */
-    return std::make_shared<BaseTypeDenoter>(VectorDataType(BaseDataType(genericTypeDenoter->dataType), 4));
+    return BaseTypeDenoter::GetCanonical(VectorDataType(BaseDataType(genericTypeDenoter->dataType), 4));
 }
 
 // see https://msdn.microsoft.com/en-us/library/windows/desktop/ff471530(v=vs.85).aspx
 TypeDenoterPtr HLSLIntrinsicAdept::DeriveReturnTypeTextureGatherCmp(const BaseTypeDenoterPtr& genericTypeDenoter) const
 {
     /* Always return 4D-vector of float type */
-    return std::make_shared<BaseTypeDenoter>(DataType::Float4);
+    return BaseTypeDenoter::GetCanonical(DataType::Float4);
 }
 
 /*
@@ -1023,7 +1023,7 @@ void HLSLIntrinsicAdept::DeriveParameterTypesFirstBit(std::vector<TypeDenoterPtr
             {
                 /* Convert vector component type to int */
                 const auto intVectorType = VectorDataType(DataType::Int, VectorTypeDim(baseDataType));
-                type0 = std::make_shared<BaseTypeDenoter>(intVectorType);
+                type0 = BaseTypeDenoter::GetCanonical(intVectorType);
             }
             paramTypeDenoters.push_back(type0);
         }
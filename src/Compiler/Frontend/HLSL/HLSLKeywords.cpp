@@ -11,6 +11,7 @@
 #include "ReportIdents.h"
 #include "Exception.h"
 #include "CiString.h"
+#include <map>
 
 
 namespace Xsc
@@ -12,6 +12,9 @@
 #include "ASTFactory.h"
 #include "ReportIdents.h"
 #include "Exception.h"
+#include "FuncCallCollector.h"
+#include <unordered_map>
+#include <unordered_set>
 
 
 namespace Xsc
@@ -42,6 +45,34 @@ HLSLParser::HLSLParser(Log* log) :
 
 ProgramPtr HLSLParser::ParseSource(
     const SourceCodePtr& source, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool rowMajorAlignment, bool enableWarnings)
+{
+    return ParseSourcePrimary(source, nullptr, nameMangling, versionIn, rowMajorAlignment, enableWarnings);
+}
+
+ProgramPtr HLSLParser::ParseTokens(
+    const TokenStreamSourcePtr& source, const NameMangling& nameMangling, const InputShaderVersion versionIn, bool rowMajorAlignment, bool enableWarnings)
+{
+    return ParseSourcePrimary(source, &(source->GetTokens()), nameMangling, versionIn, rowMajorAlignment, enableWarnings);
+}
+
+void HLSLParser::EnableLazyFunctionBodies(const std::vector<std::string>& entryPoints)
+{
+    lazyFunctionBodies_ = true;
+    lazyEntryPoints_    = entryPoints;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+ProgramPtr HLSLParser::ParseSourcePrimary(
+    const SourceCodePtr&        source,
+    const TokenPtrString*       preProcessedTokens,
+    const NameMangling&         nameMangling,
+    const InputShaderVersion    versionIn,
+    bool                        rowMajorAlignment,
+    bool                        enableWarnings)
 {
     /* Copy parameters */
     useD3D10Semantics_  = (versionIn >= InputShaderVersion::HLSL4);
@@ -53,7 +84,15 @@ ProgramPtr HLSLParser::ParseSource(
     GetNameMangling() = nameMangling;
 
     /* Start scanning source code */
-    PushScannerSource(source);
+    if (preProcessedTokens)
+    {
+        /* Convert pre-processor tokens, which are then read instead of the source code */
+        HLSLScanner scanner(enableCgKeywords_, GetLog());
+        tokenStream_ = scanner.ConvertPreProcessedTokens(*preProcessedTokens);
+        PushScannerTokenString(source, tokenStream_);
+    }
+    else
+        PushScannerSource(source);
 
     try
     {
@@ -70,11 +109,6 @@ ProgramPtr HLSLParser::ParseSource(
     return nullptr;
 }
 
-
-/*
- * ======= Private: =======
- */
-
 ScannerPtr HLSLParser::MakeScanner()
 {
     return std::make_shared<HLSLScanner>(enableCgKeywords_, GetLog());
@@ -122,7 +156,7 @@ TypeSpecifierPtr HLSLParser::MakeTypeSpecifierIfLhsOfCastExpr(const ExprPtr& exp
         if (IsRegisteredTypeName(objectExpr->ident))
         {
             /* Convert the variable access into a type specifier */
-            return ASTFactory::MakeTypeSpecifier(std::make_shared<AliasTypeDenoter>(objectExpr->ident));
+            return ASTFactory::MakeTypeSpecifier(MakeShared<AliasTypeDenoter>(objectExpr->ident));
         }
     }
 
@@ -275,6 +309,87 @@ TypeSpecifierPtr HLSLParser::MakeTypeSpecifierWithPackAlignment()
     return ast;
 }
 
+/* ------- Lazy function bodies ------- */
+
+void HLSLParser::DeferFunctionBody(FunctionDecl& funcDecl)
+{
+    DeferredFunctionBody body;
+    body.funcDecl = (&funcDecl);
+
+    /* Record all tokens from the opening to the matching closing curly bracket */
+    std::size_t depth = 0;
+
+    do
+    {
+        if (Is(Tokens::LCurly))
+            ++depth;
+        else if (Is(Tokens::RCurly))
+            --depth;
+        body.tokens.PushBack(AcceptIt());
+    }
+    while (depth > 0);
+
+    /* Terminate token string, so the parser never reads beyond the function body */
+    body.tokens.PushBack(std::make_shared<Token>(GetScanner().PreviousToken()->Pos(), Tokens::EndOfStream));
+
+    deferredFunctionBodies_.push_back(std::move(body));
+}
+
+void HLSLParser::ParseReachableFunctionBodies(Program& program)
+{
+    if (deferredFunctionBodies_.empty())
+        return;
+
+    /* Map function identifiers to their deferred function bodies */
+    std::unordered_map<std::string, std::vector<DeferredFunctionBody*>> bodiesByIdent;
+
+    for (auto& body : deferredFunctionBodies_)
+        bodiesByIdent[body.funcDecl->ident.Original()].push_back(&body);
+
+    /* Start with the entry points and all functions that are called outside of the deferred function bodies */
+    std::vector<std::string> pendingIdents = lazyEntryPoints_;
+
+    FuncCallCollector collector;
+    collector.Collect(&program, pendingIdents);
+
+    /* Parse function bodies as long as new functions are reached */
+    std::unordered_set<std::string> reachedIdents;
+
+    while (!pendingIdents.empty())
+    {
+        auto ident = std::move(pendingIdents.back());
+        pendingIdents.pop_back();
+
+        if (!reachedIdents.insert(ident).second)
+            continue;
+
+        auto it = bodiesByIdent.find(ident);
+        if (it == bodiesByIdent.end())
+            continue;
+
+        for (auto body : it->second)
+        {
+            auto funcDecl = body->funcDecl;
+
+            GetReportHandler().PushContextDesc(funcDecl->ToString(false));
+            {
+                PushTokenString(body->tokens);
+                {
+                    funcDecl->codeBlock = ParseCodeBlock();
+                }
+                PopTokenString();
+            }
+            GetReportHandler().PopContextDesc();
+
+            /* Continue with all functions that are called within the new function body */
+            collector.Collect(funcDecl->codeBlock.get(), pendingIdents);
+        }
+    }
+
+    /* Bodies of unreachable functions are dropped, so these functions remain forward declarations */
+    deferredFunctionBodies_.clear();
+}
+
 /* ------- Parse functions ------- */
 
 ProgramPtr HLSLParser::ParseProgram(const SourceCodePtr& source)
@@ -282,6 +397,7 @@ ProgramPtr HLSLParser::ParseProgram(const SourceCodePtr& source)
     auto ast = Make<Program>();
 
     OpenScope();
+    globalScopeLevel_ = typeNameSymbolTable_.ScopeLevel();
 
     /* Generate pre-defined typedef-statements */
     GeneratePreDefinedTypeAliases(*ast);
@@ -302,6 +418,9 @@ ProgramPtr HLSLParser::ParseProgram(const SourceCodePtr& source)
         ParseStmntWithCommentOpt(ast->globalStmnts, std::bind(&HLSLParser::ParseGlobalStmnt, this));
     }
 
+    /* Parse deferred function bodies while all global type names are still registered */
+    ParseReachableFunctionBodies(*ast);
+
     CloseScope();
 
     return ast;
@@ -705,7 +824,7 @@ AliasDeclPtr HLSLParser::ParseAliasDecl(TypeDenoterPtr typeDenoter)
     if (Is(Tokens::LParen))
     {
         /* Make array type denoter and use input as sub type denoter */
-        typeDenoter = std::make_shared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
+        typeDenoter = MakeShared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
     }
 
     /* Store final type denoter in alias declaration */
@@ -758,6 +877,8 @@ FunctionDeclPtr HLSLParser::ParseFunctionDecl(BasicDeclStmnt* declStmntRef, cons
     /* Parse optional function body */
     if (Is(Tokens::Semicolon))
         AcceptIt();
+    else if (lazyFunctionBodies_ && Is(Tokens::LCurly) && typeNameSymbolTable_.ScopeLevel() == globalScopeLevel_)
+        DeferFunctionBody(*ast);
     else
     {
         GetReportHandler().PushContextDesc(ast->ToString(false));
@@ -1114,9 +1235,6 @@ StmntPtr HLSLParser::ParseStmntWithStructDecl()
     auto ast = Make<BasicDeclStmnt>();
 
     auto structDecl = ParseStructDecl();
-    structDecl->declStmntRef = ast.get();
-
-    ast->declObject = structDecl;
 
     if (!Is(Tokens::Semicolon))
     {
@@ -1134,6 +1252,10 @@ StmntPtr HLSLParser::ParseStmntWithStructDecl()
     else
         Semi();
 
+    /* Only refer to the declaration statement if it is not discarded */
+    structDecl->declStmntRef = ast.get();
+    ast->declObject = structDecl;
+
     return ast;
 }
 
@@ -1718,7 +1840,7 @@ TypeDenoterPtr HLSLParser::ParseTypeDenoter(bool allowVoidType, StructDeclPtr* s
         if (Is(Tokens::LParen))
         {
             /* Make array type denoter */
-            typeDenoter = std::make_shared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
+            typeDenoter = MakeShared<ArrayTypeDenoter>(typeDenoter, ParseArrayDimensionList());
         }
 
         return typeDenoter;
@@ -1762,7 +1884,7 @@ TypeDenoterPtr HLSLParser::ParseTypeDenoterWithStructDeclOpt(StructDeclPtr& stru
 VoidTypeDenoterPtr HLSLParser::ParseVoidTypeDenoter()
 {
     Accept(Tokens::Void);
-    return std::make_shared<VoidTypeDenoter>();
+    return VoidTypeDenoter::GetCanonical();
 }
 
 BaseTypeDenoterPtr HLSLParser::ParseBaseTypeDenoter()
@@ -1772,8 +1894,7 @@ BaseTypeDenoterPtr HLSLParser::ParseBaseTypeDenoter()
         auto keyword = AcceptIt()->Spell();
 
         /* Make base type denoter by data type keyword */
-        auto typeDenoter = std::make_shared<BaseTypeDenoter>();
-        typeDenoter->dataType = ParseDataType(keyword);
+        auto typeDenoter = BaseTypeDenoter::GetCanonical(ParseDataType(keyword));
         return typeDenoter;
     }
     ErrorUnexpected(R_ExpectedBaseTypeDen, nullptr, true);
@@ -1811,8 +1932,7 @@ BaseTypeDenoterPtr HLSLParser::ParseBaseVectorTypeDenoter()
         vectorType = "float4";
 
     /* Make base type denoter by data type keyword */
-    auto typeDenoter = std::make_shared<BaseTypeDenoter>();
-    typeDenoter->dataType = ParseDataType(vectorType);
+    auto typeDenoter = BaseTypeDenoter::GetCanonical(ParseDataType(vectorType));
 
     return typeDenoter;
 }
@@ -1851,8 +1971,7 @@ BaseTypeDenoterPtr HLSLParser::ParseBaseMatrixTypeDenoter()
         matrixType = "float4x4";
 
     /* Make base type denoter by data type keyword */
-    auto typeDenoter = std::make_shared<BaseTypeDenoter>();
-    typeDenoter->dataType = ParseDataType(matrixType);
+    auto typeDenoter = BaseTypeDenoter::GetCanonical(ParseDataType(matrixType));
 
     return typeDenoter;
 }
@@ -1860,7 +1979,7 @@ BaseTypeDenoterPtr HLSLParser::ParseBaseMatrixTypeDenoter()
 BufferTypeDenoterPtr HLSLParser::ParseBufferTypeDenoter()
 {
     /* Make buffer type denoter */
-    auto typeDenoter = std::make_shared<BufferTypeDenoter>();
+    auto typeDenoter = MakeShared<BufferTypeDenoter>();
 
     /* Parse buffer type */
     auto bufferTypeTkn = Tkn();
@@ -1920,7 +2039,7 @@ SamplerTypeDenoterPtr HLSLParser::ParseSamplerTypeDenoter()
 {
     /* Make sampler type denoter */
     auto samplerType = ParseSamplerType();
-    return std::make_shared<SamplerTypeDenoter>(samplerType);
+    return MakeShared<SamplerTypeDenoter>(samplerType);
 }
 
 StructTypeDenoterPtr HLSLParser::ParseStructTypeDenoter()
@@ -1933,7 +2052,7 @@ StructTypeDenoterPtr HLSLParser::ParseStructTypeDenoter()
     auto ident = ParseIdent();
 
     /* Make struct type denoter */
-    auto typeDenoter = std::make_shared<StructTypeDenoter>(ident);
+    auto typeDenoter = MakeShared<StructTypeDenoter>(ident);
 
     return typeDenoter;
 }
@@ -1958,7 +2077,7 @@ StructTypeDenoterPtr HLSLParser::ParseStructTypeDenoterWithStructDeclOpt(StructD
         structDecl->isClass = isClass;
 
         /* Make struct type denoter with reference to the structure of this alias decl */
-        return std::make_shared<StructTypeDenoter>(structDecl.get());
+        return MakeShared<StructTypeDenoter>(structDecl.get());
     }
     else
     {
@@ -1972,12 +2091,12 @@ StructTypeDenoterPtr HLSLParser::ParseStructTypeDenoterWithStructDeclOpt(StructD
             structDecl->isClass = isClass;
 
             /* Make struct type denoter with reference to the structure of this alias decl */
-            return std::make_shared<StructTypeDenoter>(structDecl.get());
+            return MakeShared<StructTypeDenoter>(structDecl.get());
         }
         else
         {
             /* Make struct type denoter without struct decl */
-            return std::make_shared<StructTypeDenoter>(structIdentTkn->Spell());
+            return MakeShared<StructTypeDenoter>(structIdentTkn->Spell());
         }
     }
 }
@@ -1989,7 +2108,7 @@ AliasTypeDenoterPtr HLSLParser::ParseAliasTypeDenoter(std::string ident)
         ident = ParseIdent();
 
     /* Make alias type denoter per default (change this to a struct type later) */
-    return std::make_shared<AliasTypeDenoter>(ident);
+    return MakeShared<AliasTypeDenoter>(ident);
 }
 
 void HLSLParser::ParseAndIgnoreTechniquesAndNullStmnts()
@@ -12,6 +12,7 @@
 #include "SLParser.h"
 #include "HLSLScanner.h"
 #include "SymbolTable.h"
+#include "TokenStreamSource.h"
 #include <map>
 
 
@@ -35,12 +36,37 @@ class HLSLParser : public SLParser
             bool                        enableWarnings      = false
         );
 
+        // Parses the output tokens of the pre-processor directly, instead of scanning the pre-processed source code.
+        ProgramPtr ParseTokens(
+            const TokenStreamSourcePtr& source,
+            const NameMangling&         nameMangling,
+            const InputShaderVersion    versionIn,
+            bool                        rowMajorAlignment   = false,
+            bool                        enableWarnings      = false
+        );
+
+        /*
+        Enables lazy parsing of function bodies: the token range of each global function body is only recorded,
+        and a body is only parsed if the function can be reached from one of the specified entry points.
+        */
+        void EnableLazyFunctionBodies(const std::vector<std::string>& entryPoints);
+
     private:
 
         /* === Functions === */
 
         ScannerPtr MakeScanner() override;
 
+        // Parses the source code, or the specified pre-processor tokens if they are not null.
+        ProgramPtr ParseSourcePrimary(
+            const SourceCodePtr&        source,
+            const TokenPtrString*       preProcessedTokens,
+            const NameMangling&         nameMangling,
+            const InputShaderVersion    versionIn,
+            bool                        rowMajorAlignment,
+            bool                        enableWarnings
+        );
+
         // Returns true if the current token is a data type.
         bool IsDataType() const;
 
@@ -90,6 +116,14 @@ class HLSLParser : public SLParser
         // Creates a new var-decl statement with the current matrix pack alignment type modifier.
         TypeSpecifierPtr MakeTypeSpecifierWithPackAlignment();
 
+        /* ----- Lazy function bodies ----- */
+
+        // Records the brace-balanced tokens of the function body that follows, instead of parsing it.
+        void DeferFunctionBody(FunctionDecl& funcDecl);
+
+        // Parses all deferred function bodies that can be reached from the entry points or the specified program.
+        void ParseReachableFunctionBodies(Program& program);
+
         /* ----- Parsing ----- */
 
         ProgramPtr                      ParseProgram(const SourceCodePtr& source);
@@ -191,6 +225,15 @@ class HLSLParser : public SLParser
 
         bool                            ParseModifiers(TypeSpecifier* typeSpecifier, bool allowPrimitiveType = false);
 
+        /* === Structures === */
+
+        // Function declaration with the recorded tokens of its function body.
+        struct DeferredFunctionBody
+        {
+            FunctionDecl*   funcDecl;
+            TokenPtrString  tokens;
+        };
+
         /* === Members === */
 
         using TypeNameSymbolTable = SymbolTable<bool>;
@@ -198,6 +241,9 @@ class HLSLParser : public SLParser
         // Symbol table for type name (i.e. structure and typedef identifiers) to detect cast expression, which are not context free.
         TypeNameSymbolTable typeNameSymbolTable_;
 
+        // Converted output tokens of the pre-processor (only for "ParseTokens").
+        TokenPtrString      tokenStream_;
+
         // True, if semantics are parsed for D3D10+ shader.
         bool                useD3D10Semantics_      = true;
 
@@ -207,6 +253,18 @@ class HLSLParser : public SLParser
         // True, if matrix packing is globally set to row major.
         bool                rowMajorAlignment_      = false;
 
+        // True, if function bodies are only parsed when they are reachable from the entry points.
+        bool                lazyFunctionBodies_     = false;
+
+        // Scope level of the type name symbol table for global declarations.
+        std::size_t         globalScopeLevel_       = 0;
+
+        // Entry points to determine the reachable functions (only for lazy function bodies).
+        std::vector<std::string>            lazyEntryPoints_;
+
+        // Function bodies that have been recorded but not parsed yet (only for lazy function bodies).
+        std::vector<DeferredFunctionBody>   deferredFunctionBodies_;
+
 };
 
 
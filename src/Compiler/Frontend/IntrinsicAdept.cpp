@@ -24,7 +24,8 @@ IntrinsicAdept::IntrinsicAdept()
 
 IntrinsicAdept::~IntrinsicAdept()
 {
-    g_intrinsicAdeptInstance = nullptr;
+    if (g_intrinsicAdeptInstance == this)
+        g_intrinsicAdeptInstance = nullptr;
 }
 
 const IntrinsicAdept& IntrinsicAdept::Get()
@@ -32,6 +33,11 @@ const IntrinsicAdept& IntrinsicAdept::Get()
     return *g_intrinsicAdeptInstance;
 }
 
+void IntrinsicAdept::Activate()
+{
+    g_intrinsicAdeptInstance = this;
+}
+
 const std::string& IntrinsicAdept::GetIntrinsicIdent(const Intrinsic intrinsic) const
 {
     static const std::string unknwonIntrinsic = R_Undefined();
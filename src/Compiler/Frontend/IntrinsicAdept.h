@@ -37,6 +37,9 @@ class IntrinsicAdept
         // Returns the active intrinsic adept instance.
         static const IntrinsicAdept& Get();
 
+        // Makes this the active intrinsic adept instance for the current thread.
+        void Activate();
+
         // Returns the identifier of the specified intrinsic or "<undefined>" if the input ID is out of range.
         const std::string& GetIntrinsicIdent(const Intrinsic intrinsic) const;
 
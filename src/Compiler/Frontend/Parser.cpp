@@ -119,26 +119,12 @@ void Parser::EnableWarnings(bool enable)
 
 void Parser::PushScannerSource(const SourceCodePtr& source, const std::string& filename)
 {
-    /* Add current token to previous scanner */
-    if (!scannerStack_.empty())
-        scannerStack_.top().nextToken = tkn_;
-
-    /* Make a new token scanner */
-    auto scanner = MakeScanner();
-    if (!scanner)
-        RuntimeErr(R_FailedToCreateScanner);
-
-    scannerStack_.push({ scanner, filename, nullptr });
-
-    /* Start scanning */
-    if (!scanner->ScanSource(source))
-        RuntimeErr(R_FailedToScanSource);
-
-    /* Set initial source origin for scanner */
-    scanner->Source()->NextSourceOrigin(filename, 0);
+    PushScannerSourcePrimary(source, filename, nullptr);
+}
 
-    /* Accept first token */
-    AcceptIt();
+void Parser::PushScannerTokenString(const SourceCodePtr& source, const TokenPtrString& tokenString)
+{
+    PushScannerSourcePrimary(source, "", &tokenString);
 }
 
 bool Parser::PopScannerSource()
@@ -202,8 +188,9 @@ TokenPtr Parser::AcceptIt()
 
 void Parser::PushTokenString(const TokenPtrString& tokenString)
 {
-    /* Push token string onto stack in the scanner and accept first token */
+    /* Push token string onto stack in the scanner and accept first token (the current token is replaced, even at the end of stream) */
     GetScanner().PushTokenString(tokenString);
+    tkn_ = nullptr;
     AcceptIt();
 }
 
@@ -455,6 +442,35 @@ const std::string* Parser::FindNameManglingPrefix(const std::string& ident) cons
  * ======= Private: =======
  */
 
+void Parser::PushScannerSourcePrimary(const SourceCodePtr& source, const std::string& filename, const TokenPtrString* tokenString)
+{
+    /* Add current token to previous scanner */
+    if (!scannerStack_.empty())
+        scannerStack_.top().nextToken = tkn_;
+
+    /* Make a new token scanner */
+    auto scanner = MakeScanner();
+    if (!scanner)
+        RuntimeErr(R_FailedToCreateScanner);
+
+    scannerStack_.push({ scanner, filename, nullptr });
+
+    /* Start scanning */
+    if (!scanner->ScanSource(source))
+        RuntimeErr(R_FailedToScanSource);
+
+    /* Set initial source origin for scanner */
+    scanner->Source()->NextSourceOrigin(filename, 0);
+
+    /* Read tokens from token string first */
+    if (tokenString)
+        scanner->PushTokenString(*tokenString);
+
+    /* Accept first token */
+    AcceptIt();
+}
+
+
 ExprPtr Parser::BuildBinaryExprTree(
     std::vector<ExprPtr>& exprs, std::vector<BinaryOp>& ops, std::vector<SourcePosition>& opsPos)
 {
@@ -74,6 +74,9 @@ class Parser
         virtual void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "");
         virtual bool PopScannerSource();
 
+        // Pushes a new scanner for the specified source, which reads all tokens from the specified token string first (e.g. the output tokens of the pre-processor).
+        void PushScannerTokenString(const SourceCodePtr& source, const TokenPtrString& tokenString);
+
         ParsingState ActiveParsingState() const;
 
         // Returns the current token scanner.
@@ -183,11 +186,11 @@ class Parser
         // Returns a pointer to the name mangling prefix the specified identifier conflicts with, or null if no conflict exists.
         const std::string* FindNameManglingPrefix(const std::string& ident) const;
 
-        // Makes a new shared pointer of the specified AST node class.
+        // Makes a new shared pointer of the specified AST node class (in the active memory arena, see MakeShared).
         template <typename T, typename... Args>
         std::shared_ptr<T> Make(Args&&... args)
         {
-            return std::make_shared<T>(GetScanner().Pos(), std::forward<Args>(args)...);
+            return MakeShared<T>(GetScanner().Pos(), std::forward<Args>(args)...);
         }
 
         // Returns the current token.
@@ -227,6 +230,8 @@ class Parser
 
         /* === Functions === */
 
+        void PushScannerSourcePrimary(const SourceCodePtr& source, const std::string& filename, const TokenPtrString* tokenString);
+
         // Builds a left-to-right binary-expression tree hierarchy for the specified list of expressions.
         ExprPtr BuildBinaryExprTree(
             std::vector<ExprPtr>& exprs,
@@ -13,6 +13,8 @@
 #include "ReportIdents.h"
 #include "Exception.h"
 #include <sstream>
+#include <iterator>
+#include <algorithm>
 
 
 namespace Xsc
@@ -26,28 +28,103 @@ PreProcessor::PreProcessor(IncludeHandler& includeHandler, Log* log) :
 }
 
 std::unique_ptr<std::iostream> PreProcessor::Process(
-    const SourceCodePtr& input, const std::string& filename, bool writeLineMarks, bool writeLineMarkFilenames, bool enableWarnings)
+    const SourceCodePtr&                input,
+    const std::string&                  filename,
+    bool                                writeLineMarks,
+    bool                                writeLineMarkFilenames,
+    bool                                enableWarnings,
+    const std::vector<PredefinedMacro>& predefinedMacros)
 {
     output_                 = MakeUnique<std::stringstream>();
     writeLineMarks_         = writeLineMarks;
     writeLineMarkFilenames_ = writeLineMarkFilenames;
 
-    EnableWarnings(enableWarnings);
+    if (ProcessPrimary(input, filename, enableWarnings, predefinedMacros))
+        return std::move(output_);
 
-    PushScannerSource(input, filename);
+    return nullptr;
+}
 
-    try
-    {
-        ParseProgram();
-        return (GetReportHandler().HasErrors() ? nullptr : std::move(output_));
-    }
-    catch (const Report& err)
+TokenStreamSourcePtr PreProcessor::ProcessTokens(
+    const SourceCodePtr&                input,
+    const std::string&                  filename,
+    bool                                enableWarnings,
+    const std::vector<PredefinedMacro>& predefinedMacros)
+{
+    /* Line marks are not required, since all output tokens keep their positions within the original source files */
+    output_                 = MakeUnique<std::stringstream>();
+    tokenOutput_            = std::make_shared<TokenStreamSource>();
+    writeLineMarks_         = false;
+    writeLineMarkFilenames_ = false;
+
+    auto result = ProcessPrimary(input, filename, enableWarnings, predefinedMacros);
+
+    auto tokenOutput = std::move(tokenOutput_);
+    return (result ? tokenOutput : nullptr);
+}
+
+bool PreProcessor::ProcessPrecompiledHeader(
+    const SourceCodePtr&                input,
+    const std::string&                  filename,
+    bool                                writeLineMarks,
+    bool                                writeLineMarkFilenames,
+    bool                                enableWarnings,
+    const std::vector<PredefinedMacro>& predefinedMacros,
+    PrecompiledHeaderData&              pch)
+{
+    output_                 = MakeUnique<std::stringstream>();
+    writeLineMarks_         = writeLineMarks;
+    writeLineMarkFilenames_ = writeLineMarkFilenames;
+
+    pch.headerName              = filename;
+    pch.writeLineMarks          = writeLineMarks;
+    pch.writeLineMarkFilenames  = writeLineMarkFilenames;
+    pch.dependencies.clear();
+
+    /* Pre-process header file and record its dependencies */
+    pchOutput_ = &pch;
+    auto result = ProcessPrimary(input, filename, enableWarnings, predefinedMacros);
+    pchOutput_ = nullptr;
+
+    if (!result)
+        return false;
+
+    /* Store pre-processed source code and final macro table */
+    pch.processedCode = output_->str();
+
+    pch.macros.clear();
+    pch.macros.reserve(macros_.size());
+
+    for (const auto& it : macros_)
     {
-        if (GetLog())
-            GetLog()->SubmitReport(err);
+        const auto& macro = *(it.second);
+
+        PrecompiledHeaderData::Macro pchMacro;
+        {
+            pchMacro.ident          = it.first;
+            pchMacro.parameters     = macro.parameters;
+            pchMacro.varArgs        = macro.varArgs;
+            pchMacro.stdMacro       = macro.stdMacro;
+            pchMacro.emptyParamList = macro.emptyParamList;
+
+            for (const auto& tkn : macro.tokenString.GetTokens())
+                pchMacro.tokens.push_back({ static_cast<int>(tkn->Type()), tkn->Spell() });
+        }
+        pch.macros.push_back(std::move(pchMacro));
     }
 
-    return nullptr;
+    pch.onceIncluded.assign(onceIncluded_.begin(), onceIncluded_.end());
+
+    pch.includeGuards.clear();
+    for (const auto& it : includeGuards_)
+        pch.includeGuards.push_back({ it.first, it.second });
+
+    return true;
+}
+
+void PreProcessor::UsePrecompiledHeader(const PrecompiledHeaderData* pch)
+{
+    precompiledHeader_ = pch;
 }
 
 std::vector<std::string> PreProcessor::ListDefinedMacroIdents() const
@@ -133,7 +210,49 @@ void PreProcessor::DefineMacro(const Macro& macro)
         }
 
         /* Create new macro and register symbol */
-        macros_[ident] = std::make_shared<Macro>(macro);
+        auto newMacro = std::make_shared<Macro>(macro);
+        newMacro->BuildReplacements();
+        macros_[ident] = newMacro;
+    }
+}
+
+void PreProcessor::DefinePredefinedMacros(const std::vector<PredefinedMacro>& predefinedMacros)
+{
+    for (const auto& predefinedMacro : predefinedMacros)
+    {
+        auto identTkn = std::make_shared<Token>(SourcePosition::ignore, Tokens::Ident, predefinedMacro.ident);
+
+        TokenPtrString valueTokenString;
+
+        if (!predefinedMacro.value.empty())
+        {
+            /* Scan macro value with a separate scanner, since it is not part of the source code */
+            PreProcessorScanner scanner(GetLog());
+
+            if (scanner.ScanSource(std::make_shared<SourceCode>(predefinedMacro.value.data(), predefinedMacro.value.size())))
+            {
+                for (auto tkn = scanner.Next(); tkn->Type() != Tokens::EndOfStream; tkn = scanner.Next())
+                {
+                    if (tkn->Type() == Tokens::Ident)
+                    {
+                        /* Expand previous macros without parameters (like in a '#define'-directive) */
+                        auto it = macros_.find(tkn->Spell());
+                        if (it != macros_.end() && !it->second->HasParameterList())
+                        {
+                            valueTokenString.PushBack(it->second->tokenString);
+                            continue;
+                        }
+                    }
+                    if (tkn->Type() != Tokens::NewLine)
+                        valueTokenString.PushBack(tkn);
+                }
+            }
+
+            valueTokenString.TrimFront();
+            valueTokenString.TrimBack();
+        }
+
+        DefineMacro({ identTkn, valueTokenString });
     }
 }
 
@@ -230,7 +349,7 @@ bool PreProcessor::OnSubstitueStdMacro(const Token& identTkn, TokenPtrString& to
     return false;
 }
 
-Variant PreProcessor::EvaluateExpr(const TokenPtrString& tokenString, const Token* tkn)
+Variant PreProcessor::EvaluateExpr(const TokenPtrString& tokenString, const Token* tkn, ConstExprProgram* program)
 {
     /* Evalutate condExpr */
     Variant value;
@@ -257,6 +376,10 @@ Variant PreProcessor::EvaluateExpr(const TokenPtrString& tokenString, const Toke
             Error(e.what(), tkn);
         }
 
+        /* Compile expression for the next evaluation */
+        if (program && conditionExpr)
+            program->Compile(*conditionExpr);
+
         #if 0
         /* Check if token string has reached the end */
         auto tokenStringIt = GetScanner().TopTokenStringIterator();
@@ -282,12 +405,14 @@ Variant PreProcessor::ParseAndEvaluateExpr(const Token* tkn)
     tokenString.PushBack(ParseDirectiveTokenString(true));
     tokenString.PushBack(Make<Token>(Tokens::RBracket, ")"));
 
-    return EvaluateExpr(tokenString, tkn);
+    return EvaluateCachedExpr(tokenString, tkn);
 }
 
 Variant PreProcessor::ParseAndEvaluateArgumentExpr(const Token* tkn)
 {
-    return EvaluateExpr(ParseArgumentTokenString(), tkn);
+    TokenPtrString tokenString;
+    ParseArgumentTokenString(tokenString);
+    return EvaluateExpr(tokenString, tkn);
 }
 
 
@@ -300,6 +425,36 @@ ScannerPtr PreProcessor::MakeScanner()
     return std::make_shared<PreProcessorScanner>(GetLog());
 }
 
+bool PreProcessor::ProcessPrimary(
+    const SourceCodePtr&                input,
+    const std::string&                  filename,
+    bool                                enableWarnings,
+    const std::vector<PredefinedMacro>& predefinedMacros)
+{
+    EnableWarnings(enableWarnings);
+
+    PushScannerSource(input, filename);
+
+    try
+    {
+        DefinePredefinedMacros(predefinedMacros);
+
+        /* Store macro state, which must match wherever the precompiled header is included */
+        if (pchOutput_)
+            pchOutput_->macroStateHash = MacroStateHash();
+
+        ParseProgram();
+        return !GetReportHandler().HasErrors();
+    }
+    catch (const Report& err)
+    {
+        if (GetLog())
+            GetLog()->SubmitReport(err);
+    }
+
+    return false;
+}
+
 void PreProcessor::PushScannerSource(const SourceCodePtr& source, const std::string& filename)
 {
     static const std::size_t includeCounterLimit = 500;
@@ -313,8 +468,22 @@ void PreProcessor::PushScannerSource(const SourceCodePtr& source, const std::str
 
     /* Push scanner for new source file */
     Parser::PushScannerSource(source, filename);
+
+    IncludeGuard includeGuard;
+    {
+        includeGuard.filename       = filename;
+        includeGuard.ifBlockDepth   = ifBlockStack_.size();
+    }
+    includeGuardStack_.push_back(std::move(includeGuard));
     GetScanner().Source()->NextSourceOrigin(filename, 0);
 
+    /* Register source code for the origins of all output tokens from this source */
+    if (tokenOutput_)
+    {
+        tokenOutput_->AddOrigin(Tkn()->Pos(), source);
+        tokenOutput_->AddOrigin(GetScanner().Source()->Pos(), source);
+    }
+
     /* Write new line directive for current position */
     WritePosToLineDirective();
 }
@@ -330,6 +499,19 @@ bool PreProcessor::PopScannerSource()
             --counter;
     }
 
+    /* Store include guard of current file, if the entire file was enclosed by the '#ifndef'-block */
+    if (!includeGuardStack_.empty())
+    {
+        const auto& includeGuard = includeGuardStack_.back();
+        if ( !includeGuard.filename.empty()                             &&
+             includeGuard.state == IncludeGuard::States::End            &&
+             includeGuard.ifBlockDepth == ifBlockStack_.size() )
+        {
+            includeGuards_[includeGuard.filename] = includeGuard.ident;
+        }
+        includeGuardStack_.pop_back();
+    }
+
     /* Pop scanner from stack */
     if (Parser::PopScannerSource())
     {
@@ -384,100 +566,366 @@ PreProcessor::IfBlock PreProcessor::TopIfBlock() const
     return (ifBlockStack_.empty() ? IfBlock() : ifBlockStack_.top());
 }
 
-TokenPtrString PreProcessor::ExpandMacro(const Macro& macro, const std::vector<TokenPtrString>& arguments)
+void PreProcessor::DetectIncludeGuard(const Token& tkn)
 {
-    TokenPtrString expandedString;
+    if (includeGuardStack_.empty())
+        return;
 
-    if (macro.parameters.size() > arguments.size())
-        return expandedString;
+    /* Any code before the '#ifndef'-directive or after its '#endif'-directive invalidates the include guard */
+    auto& includeGuard = includeGuardStack_.back();
+    if (includeGuard.state == IncludeGuard::States::Start || includeGuard.state == IncludeGuard::States::End)
+    {
+        switch (tkn.Type())
+        {
+            case Tokens::WhiteSpace:
+            case Tokens::NewLine:
+            case Tokens::Comment:
+            case Tokens::Directive:
+                break;
+            default:
+                includeGuard.state = IncludeGuard::States::Invalid;
+                break;
+        }
+    }
+}
 
-    auto ExpandTokenString = [&](TokenPtrString::Container::const_iterator& tknIt, const TokenPtrString::Container::const_iterator& tknItEnd) -> bool
+void PreProcessor::DetectIncludeGuard(const std::string& directive)
+{
+    if (includeGuardStack_.empty())
+        return;
+
+    auto& includeGuard = includeGuardStack_.back();
+    switch (includeGuard.state)
     {
-        const auto& tkn = **tknIt;
+        case IncludeGuard::States::Start:
+        {
+            /* Only '#ifndef' can start an include guard (the state is changed when the directive is parsed) */
+            if (directive != "ifndef")
+                includeGuard.state = IncludeGuard::States::Invalid;
+        }
+        break;
 
-        /* Check if current token is an identifier which matches one of the parameters of the macro */
-        switch (tkn.Type())
+        case IncludeGuard::States::Inside:
         {
-            case Tokens::Ident:
+            /* Check for directives of the '#ifndef'-block itself */
+            if (ifBlockStack_.size() == includeGuard.ifBlockDepth + 1)
             {
-                auto ident = tkn.Spell();
-                if (ident == "__VA_ARGS__")
-                {
-                    /* Replace '__VA_ARGS__' identifier with all variadic arguments (i.e. all after the number of parameters) */
-                    for (std::size_t i = macro.parameters.size(); i < arguments.size(); ++i)
-                    {
-                        expandedString.PushBack(arguments[i]);
-                        if (i + 1 < arguments.size())
-                            expandedString.PushBack(Make<Token>(Tokens::Comma, ","));
-                    }
-                    return true;
-                }
-                else
-                {
-                    for (std::size_t i = 0; i < macro.parameters.size(); ++i)
-                    {
-                        if (ident == macro.parameters[i])
-                        {
-                            /* Expand identifier by argument token string */
-                            expandedString.PushBack(arguments[i]);
-                            return true;
-                        }
-                    }
-                }
+                if (directive == "endif")
+                    includeGuard.state = IncludeGuard::States::End;
+                else if (directive == "else" || directive == "elif")
+                    includeGuard.state = IncludeGuard::States::Invalid;
+            }
+        }
+        break;
+
+        case IncludeGuard::States::End:
+        {
+            includeGuard.state = IncludeGuard::States::Invalid;
+        }
+        break;
+
+        default:
+        break;
+    }
+}
+
+void PreProcessor::ExpandMacro(TokenPtrString& tokenString, const Macro& macro, std::size_t firstArgument, std::size_t numArguments)
+{
+    using Replacement = Macro::Replacement;
+
+    if (macro.parameters.size() > numArguments)
+        return;
+
+    auto& tokens = tokenString.GetTokens();
+    const auto& valueTokens = macro.tokenString.GetTokens();
+
+    auto GetArgument = [&](std::size_t index) -> const TokenPtrString&
+    {
+        return macroArguments_[firstArgument + index];
+    };
+
+    /* Reserve storage for the entire expansion at once */
+    std::size_t expandedSize = tokens.size();
+
+    for (const auto& replacement : macro.replacements)
+    {
+        switch (replacement.type)
+        {
+            case Replacement::Types::Argument:
+                expandedSize += GetArgument(replacement.index).GetTokens().size();
+                break;
+            case Replacement::Types::VarArgs:
+                for (std::size_t i = macro.parameters.size(); i < numArguments; ++i)
+                    expandedSize += GetArgument(i).GetTokens().size() + 1;
+                break;
+            case Replacement::Types::Concat:
+                break;
+            default:
+                ++expandedSize;
+                break;
+        }
+    }
+
+    if (expandedSize > tokens.capacity())
+        tokens.reserve(std::max(expandedSize, tokens.capacity() * 2));
+
+    /* Append replacements of all value tokens */
+    const auto expansionBegin = tokens.size();
+
+    for (const auto& replacement : macro.replacements)
+    {
+        switch (replacement.type)
+        {
+            case Replacement::Types::Token:
+            {
+                tokens.push_back(valueTokens[replacement.index]);
             }
             break;
 
-            case Tokens::Directive:
+            case Replacement::Types::Argument:
             {
-                auto ident = tkn.Spell();
-                for (std::size_t i = 0; i < macro.parameters.size(); ++i)
+                /* Expand identifier by argument token string */
+                tokenString.PushBack(GetArgument(replacement.index));
+            }
+            break;
+
+            case Replacement::Types::Stringize:
+            {
+                /* Expand identifier by converting argument token string to string literal */
+                std::string stringLiteral;
+                stringLiteral += '\"';
+                for (const auto& tkn : GetArgument(replacement.index).GetTokens())
+                    stringLiteral += tkn->Spell();
+                stringLiteral += '\"';
+                tokens.push_back(Make<Token>(Tokens::StringLiteral, std::move(stringLiteral)));
+            }
+            break;
+
+            case Replacement::Types::VarArgs:
+            {
+                /* Replace '__VA_ARGS__' identifier with all variadic arguments (i.e. all after the number of parameters) */
+                for (std::size_t i = macro.parameters.size(); i < numArguments; ++i)
                 {
-                    if (ident == macro.parameters[i])
-                    {
-                        /* Expand identifier by converting argument token string to string literal */
-                        std::stringstream stringLiteral;
-                        stringLiteral << '\"' << arguments[i] << '\"';
-                        expandedString.PushBack(Make<Token>(Tokens::StringLiteral, stringLiteral.str()));
-                        return true;
-                    }
+                    tokenString.PushBack(GetArgument(i));
+                    if (i + 1 < numArguments)
+                        tokens.push_back(Make<Token>(Tokens::Comma, ","));
                 }
             }
             break;
 
-            case Tokens::DirectiveConcat:
+            case Replacement::Types::Concat:
             {
-                /* Rremove previous white spaces and comments */
-                expandedString.TrimBack();
+                /* Remove previous white spaces and comments of this expansion */
+                while (tokens.size() > expansionBegin && !DefaultTokenOfInterestFunctor::IsOfInterest(tokens.back()))
+                    tokens.pop_back();
+            }
+            break;
+        }
+    }
+}
 
-                /* Ignore concatenation token */
-                ++tknIt;
+TokenPtrString& PreProcessor::PushMacroArgument()
+{
+    /* Reuse token storage of previous macro arguments */
+    if (numMacroArguments_ == macroArguments_.size())
+        macroArguments_.emplace_back();
 
-                /* Ignore following white spaces and comments */
-                while (tknIt != tknItEnd && !DefaultTokenOfInterestFunctor::IsOfInterest(*tknIt))
-                    ++tknIt;
+    auto& argument = macroArguments_[numMacroArguments_++];
+    argument.GetTokens().clear();
 
-                /* Iterate one token back since it will be incremented in the outer for-loop */
-                --tknIt;
-                return true;
-            }
-            break;
+    return argument;
+}
 
-            default:
-            break;
+Variant PreProcessor::EvaluateCachedExpr(const TokenPtrString& tokenString, const Token* tkn)
+{
+    /* Only cache token strings without identifiers */
+    if (!BuildExprCacheKey(tokenString, exprCacheKey_))
+        return EvaluateExpr(tokenString, tkn);
+
+    auto it = exprCache_.find(exprCacheKey_);
+    if (it == exprCache_.end())
+    {
+        /* Evaluate expression and compile it for the next evaluation of the same token string */
+        return EvaluateExpr(tokenString, tkn, &(exprCache_[exprCacheKey_]));
+    }
+
+    const auto& program = it->second;
+    if (!program.IsValid())
+        return EvaluateExpr(tokenString, tkn);
+
+    /* Accept all tokens of the token string like the expression parser, but without building the expression tree */
+    PushTokenString(tokenString);
+    {
+        for (auto tknIt = tokenString.Begin(); !tknIt.ReachedEnd(); ++tknIt)
+            AcceptIt();
+    }
+    PopTokenString();
+
+    /* Execute compiled expression */
+    Variant value;
+
+    try
+    {
+        value = program.Execute(exprStack_);
+    }
+    catch (const std::exception& e)
+    {
+        Error(e.what(), tkn);
+    }
+
+    return value;
+}
+
+bool PreProcessor::BuildExprCacheKey(const TokenPtrString& tokenString, std::string& key)
+{
+    key.clear();
+
+    for (auto it = tokenString.Begin(); !it.ReachedEnd(); ++it)
+    {
+        const auto& tkn = **it;
+
+        /* Identifiers can not be cached (e.g. 'defined' is evaluated with the current macros) */
+        if (tkn.Type() == Tokens::Ident)
+            return false;
+
+        key += static_cast<char>(tkn.Type());
+        key += tkn.Spell();
+        key += '\0';
+    }
+
+    return true;
+}
+
+std::uint64_t PreProcessor::MacroStateHash() const
+{
+    std::string state;
+
+    for (const auto& it : macros_)
+    {
+        const auto& macro = *(it.second);
+
+        state += it.first;
+        state += '(';
+
+        for (const auto& param : macro.parameters)
+        {
+            state += param;
+            state += ',';
+        }
+
+        state += (macro.varArgs ? 'v' : '-');
+        state += (macro.stdMacro ? 's' : '-');
+        state += (macro.emptyParamList ? 'e' : '-');
+        state += ')';
+
+        for (const auto& tkn : macro.tokenString.GetTokens())
+        {
+            state += std::to_string(static_cast<int>(tkn->Type()));
+            state += ':';
+            state += tkn->Spell();
+            state += '\0';
         }
 
-        /* Return false -> meaning this function has not added any tokens to the expanded string */
+        state += '\n';
+    }
+
+    for (const auto& filename : onceIncluded_)
+    {
+        state += filename;
+        state += '\n';
+    }
+
+    return HashFNV1a64(state);
+}
+
+std::unique_ptr<std::istream> PreProcessor::RecordPrecompiledHeaderDependency(
+    std::unique_ptr<std::istream>&& includeStream,
+    const std::string&              filename,
+    bool                            useSearchPaths)
+{
+    std::string content;
+    if (includeStream)
+        content = std::string(std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>());
+
+    PrecompiledHeaderData::Dependency dependency;
+    {
+        dependency.filename         = filename;
+        dependency.useSearchPaths   = useSearchPaths;
+        dependency.size             = content.size();
+        dependency.hash             = HashFNV1a64(content);
+    }
+    pchOutput_->dependencies.push_back(std::move(dependency));
+
+    return MakeUnique<std::stringstream>(std::move(content));
+}
+
+bool PreProcessor::IncludePrecompiledHeader(const std::string& headerContent)
+{
+    const auto& pch = *precompiledHeader_;
+
+    /* Validate precompiled header against the header file and the current macros */
+    if (pch.headerSize != headerContent.size() || pch.headerHash != HashFNV1a64(headerContent))
         return false;
-    };
 
-    const auto& tokens = macro.tokenString.GetTokens();
-    for (auto it = tokens.begin(); it != tokens.end(); ++it)
+    if (pch.macroStateHash != MacroStateHash())
+        return false;
+
+    /* Validate precompiled header against all files that were included by the header */
+    for (const auto& dependency : pch.dependencies)
     {
-        if (!ExpandTokenString(it, tokens.end()))
-            expandedString.PushBack(*it);
+        std::unique_ptr<std::istream> includeStream;
+
+        try
+        {
+            includeStream = includeHandler_.Include(dependency.filename, dependency.useSearchPaths);
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        if (!includeStream)
+            return false;
+
+        auto content = std::string(std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>());
+        if (dependency.size != content.size() || dependency.hash != HashFNV1a64(content))
+            return false;
     }
 
-    return expandedString;
+    /* Replace macro table by the macros after the header has been pre-processed */
+    macros_.clear();
+
+    for (const auto& pchMacro : pch.macros)
+    {
+        TokenPtrString tokenString;
+        for (const auto& tkn : pchMacro.tokens)
+            tokenString.PushBack(std::make_shared<Token>(SourcePosition::ignore, static_cast<Tokens>(tkn.type), tkn.spell));
+
+        auto macro = std::make_shared<Macro>(
+            std::make_shared<Token>(SourcePosition::ignore, Tokens::Ident, pchMacro.ident),
+            tokenString,
+            pchMacro.parameters,
+            pchMacro.varArgs,
+            pchMacro.stdMacro,
+            pchMacro.emptyParamList
+        );
+        macro->BuildReplacements();
+        macros_[pchMacro.ident] = macro;
+    }
+
+    onceIncluded_.insert(pch.onceIncluded.begin(), pch.onceIncluded.end());
+
+    /* Take over include guards, so further inclusions of the header are skipped like after pre-processing it */
+    for (const auto& includeGuard : pch.includeGuards)
+        includeGuards_[includeGuard.filename] = includeGuard.ident;
+
+    pchIncluded_ = true;
+
+    /* Write pre-processed header and continue with the current file */
+    Out() << pch.processedCode;
+    WritePosToLineDirective();
+
+    return true;
 }
 
 void PreProcessor::WritePosToLineDirective()
@@ -489,6 +937,35 @@ void PreProcessor::WritePosToLineDirective()
     }
 }
 
+void PreProcessor::WriteToken(const TokenPtr& tkn)
+{
+    if (tokenOutput_)
+        tokenOutput_->GetTokens().PushBack(tkn);
+    else
+        Out() << tkn->Spell();
+}
+
+void PreProcessor::WriteIdentTokenString(const TokenPtr& identTkn, const TokenPtrString& tokenString)
+{
+    if (tokenOutput_)
+    {
+        const auto& tokens = tokenString.GetTokens();
+        if (tokens.size() == 1 && tokens.front() == identTkn)
+        {
+            /* Append identifier which is not a macro */
+            tokenOutput_->GetTokens().PushBack(identTkn);
+        }
+        else
+        {
+            /* Append macro expansion with the position of the identifier, like in the output source code */
+            for (const auto& tkn : tokens)
+                tokenOutput_->GetTokens().PushBack(std::make_shared<Token>(identTkn->Pos(), tkn->Type(), tkn->Spell()));
+        }
+    }
+    else
+        Out() << tokenString;
+}
+
 /* === Parse functions === */
 
 void PreProcessor::ParseProgram()
@@ -500,6 +977,8 @@ void PreProcessor::ParseProgram()
         {
             if (TopIfBlock().active)
             {
+                DetectIncludeGuard(*Tkn());
+
                 /* Parse active block */
                 switch (TknType())
                 {
@@ -547,18 +1026,21 @@ void PreProcessor::ParseProgram()
 
 void PreProcessor::ParesComment()
 {
-    Out() << Accept(Tokens::Comment)->Spell();
+    WriteToken(Accept(Tokens::Comment));
 }
 
 void PreProcessor::ParseIdent()
 {
-    Out() << ParseIdentAsTokenString();
+    auto identTkn = Tkn();
+
+    /* Reuse token storage for all identifiers */
+    ParseIdentAsTokenString(identTokenString_);
+    WriteIdentTokenString(identTkn, identTokenString_);
+    identTokenString_.GetTokens().clear();
 }
 
-TokenPtrString PreProcessor::ParseIdentAsTokenString()
+void PreProcessor::ParseIdentAsTokenString(TokenPtrString& tokenString)
 {
-    TokenPtrString tokenString;
-
     /* Parse identifier */
     auto identTkn = Accept(Tokens::Ident);
 
@@ -574,7 +1056,7 @@ TokenPtrString PreProcessor::ParseIdentAsTokenString()
             if (macro.HasParameterList())
             {
                 /* Replace identifier to macro with arguments */
-                tokenString.PushBack(ParseIdentArgumentsForMacro(identTkn, macro));
+                ParseIdentArgumentsForMacro(tokenString, identTkn, macro);
             }
             else if (macro.tokenString.Empty())
             {
@@ -590,11 +1072,9 @@ TokenPtrString PreProcessor::ParseIdentAsTokenString()
         else
             tokenString.PushBack(identTkn);
     }
-
-    return tokenString;
 }
 
-TokenPtrString PreProcessor::ParseIdentArgumentsForMacro(const TokenPtr& identToken, const Macro& macro)
+void PreProcessor::ParseIdentArgumentsForMacro(TokenPtrString& tokenString, const TokenPtr& identToken, const Macro& macro)
 {
     /* Parse argument list begin */
     IgnoreWhiteSpaces();
@@ -606,28 +1086,26 @@ TokenPtrString PreProcessor::ParseIdentArgumentsForMacro(const TokenPtr& identTo
         if the macro has parameters, but the macro usage has no arguments.
         Also append single blank, due to previously ignored white spaces.
         */
-        TokenPtrString tokenStr;
-        tokenStr.PushBack(identToken);
-        tokenStr.PushBack(Make<Token>(Tokens::WhiteSpace, " "));
-        return tokenStr;
+        tokenString.PushBack(identToken);
+        tokenString.PushBack(Make<Token>(Tokens::WhiteSpace, " "));
+        return;
     }
 
     AcceptIt();
     IgnoreWhiteSpaces();
 
-    /* Parse all arguments */
-    std::vector<TokenPtrString> arguments;
+    /* Parse all arguments onto the argument stack (nested macro expansions push their arguments on top) */
+    const auto firstArgument = numMacroArguments_;
 
     while (!Is(Tokens::RBracket))
     {
-        auto arg = ParseArgumentTokenString();
+        auto& arg = PushMacroArgument();
+        ParseArgumentTokenString(arg);
 
         /* Remove white spaces and comments from argument */
         arg.TrimBack();
         arg.TrimFront();
 
-        arguments.push_back(arg);
-
         /* Parse comma separator */
         if (Is(Tokens::Comma))
         {
@@ -635,48 +1113,53 @@ TokenPtrString PreProcessor::ParseIdentArgumentsForMacro(const TokenPtr& identTo
 
             /* Check if the last argument was empty (e.g. "Macro(,)") */
             if (Is(Tokens::RBracket))
-                arguments.push_back({});
+                PushMacroArgument();
         }
     }
 
     AcceptIt();
 
+    auto numArguments = numMacroArguments_ - firstArgument;
+
     /* Check compatability of parameter count to macro */
-    if ( ( !macro.varArgs && arguments.size() != macro.parameters.size() ) ||
-         ( macro.varArgs && arguments.size() < macro.parameters.size() ) )
+    if ( ( !macro.varArgs && numArguments != macro.parameters.size() ) ||
+         ( macro.varArgs && numArguments < macro.parameters.size() ) )
     {
-        if (macro.parameters.size() == 1 && arguments.size() == 0)
+        if (macro.parameters.size() == 1 && numArguments == 0)
         {
             /* Append empty argument for a single parameter */
-            arguments.push_back({});
+            PushMacroArgument();
+            ++numArguments;
         }
         else
         {
             /* Report error of mismatch is number of parameters and arguments */
             std::string errorMsg;
 
-            if (arguments.size() > macro.parameters.size())
-                errorMsg = R_TooManyArgsForMacro(identToken->Spell(), macro.parameters.size(), arguments.size());
-            if (arguments.size() < macro.parameters.size())
-                errorMsg = R_TooFewArgsForMacro(identToken->Spell(), macro.parameters.size(), arguments.size());
+            if (numArguments > macro.parameters.size())
+                errorMsg = R_TooManyArgsForMacro(identToken->Spell(), macro.parameters.size(), numArguments);
+            if (numArguments < macro.parameters.size())
+                errorMsg = R_TooFewArgsForMacro(identToken->Spell(), macro.parameters.size(), numArguments);
 
             Error(errorMsg, identToken.get());
         }
     }
 
-    /* Perform macro expansion */
-    return ExpandMacro(macro, arguments);
+    /* Perform macro expansion and pop arguments from the stack */
+    ExpandMacro(tokenString, macro, firstArgument, numArguments);
+    numMacroArguments_ = firstArgument;
 }
 
 void PreProcessor::ParseMisc()
 {
-    Out() << AcceptIt()->Spell();
+    WriteToken(AcceptIt());
 }
 
 void PreProcessor::ParseDirective()
 {
     /* Parse pre-processor directive */
     const auto directive = Accept(Tokens::Directive)->Spell();
+    DetectIncludeGuard(directive);
     ParseDirective(directive, true);
 }
 
@@ -819,6 +1302,14 @@ void PreProcessor::ParseDirectiveInclude()
         filename = Accept(Tokens::StringLiteral)->SpellContent();
     }
 
+    /* Check if the include guard of the file is still defined, so the file can be skipped without scanning it again */
+    auto includeGuardIt = includeGuards_.find(filename);
+    if (includeGuardIt != includeGuards_.end() && IsDefined(includeGuardIt->second))
+    {
+        ++numSkippedIncludes_;
+        return;
+    }
+
     /* Check if filename has already been marked as 'once included' */
     if (onceIncluded_.find(filename) == onceIncluded_.end())
     {
@@ -834,6 +1325,25 @@ void PreProcessor::ParseDirectiveInclude()
             Error(e.what());
         }
 
+        if (includeStream)
+        {
+            if (pchOutput_)
+            {
+                /* Record included file to validate the precompiled header */
+                includeStream = RecordPrecompiledHeaderDependency(std::move(includeStream), filename, useSearchPaths);
+            }
+            else if (precompiledHeader_ && !pchIncluded_ && filename == precompiledHeader_->headerName)
+            {
+                /* Use precompiled header instead of pre-processing the header file again */
+                auto content = std::string(std::istreambuf_iterator<char>(*includeStream), std::istreambuf_iterator<char>());
+                if (IncludePrecompiledHeader(content))
+                    return;
+
+                Warning(R_PrecompiledHeaderOutdated(filename));
+                includeStream = MakeUnique<std::stringstream>(std::move(content));
+            }
+        }
+
         /* Push scanner soruce for include file */
         auto sourceCode = std::make_shared<SourceCode>(std::move(includeStream));
         PushScannerSource(sourceCode, filename);
@@ -878,7 +1388,24 @@ void PreProcessor::ParseDirectiveIfndef(bool skipEvaluation)
     auto ident = Accept(Tokens::Ident)->Spell();
 
     /* Push new if-block activation (with 'not defined' condExpr) */
-    PushIfBlock(tkn, !IsDefined(ident));
+    const bool active = !IsDefined(ident);
+    PushIfBlock(tkn, active);
+
+    /* Check if this directive starts the include guard of the current file */
+    if (!skipEvaluation && !includeGuardStack_.empty())
+    {
+        auto& includeGuard = includeGuardStack_.back();
+        if (includeGuard.state == IncludeGuard::States::Start)
+        {
+            if (active)
+            {
+                includeGuard.ident = ident;
+                includeGuard.state = IncludeGuard::States::Inside;
+            }
+            else
+                includeGuard.state = IncludeGuard::States::Invalid;
+        }
+    }
 }
 
 // '#' 'elif CONSTANT-EXPRESSION'
@@ -998,7 +1525,20 @@ void PreProcessor::ParseDirectivePragma()
                     /* Write pragma out */
                     auto alignment = alignmentTkn->Spell();
                     if (alignment == "row_major" || alignment == "column_major")
-                        Out() << "#pragma pack_matrix(" << alignment << ")";
+                    {
+                        if (tokenOutput_)
+                        {
+                            /* Append pragma tokens like they are scanned by the parser */
+                            const auto& pos = alignmentTkn->Pos();
+                            WriteToken(std::make_shared<Token>(tkn->Pos(), Tokens::Directive, "pragma"));
+                            WriteToken(std::make_shared<Token>(pos, Tokens::Ident, "pack_matrix"));
+                            WriteToken(std::make_shared<Token>(pos, Tokens::LBracket, "("));
+                            WriteToken(alignmentTkn);
+                            WriteToken(std::make_shared<Token>(pos, Tokens::RBracket, ")"));
+                        }
+                        else
+                            Out() << "#pragma pack_matrix(" << alignment << ")";
+                    }
                     else
                         Warning(R_UnknownMatrixPackAlignment(alignment), alignmentTkn.get());
                 }
@@ -1032,20 +1572,31 @@ void PreProcessor::ParseDirectiveLine()
 {
     /* Parse line number */
     IgnoreWhiteSpaces();
-    auto lineNumber = Accept(Tokens::IntLiteral)->Spell();
-
-    Out() << "#line " << lineNumber;
+    auto lineNumberTkn = Accept(Tokens::IntLiteral);
 
     /* Parse optional filename */
     IgnoreWhiteSpaces();
 
+    TokenPtr filenameTkn;
     if (Is(Tokens::StringLiteral))
+        filenameTkn = AcceptIt();
+
+    if (tokenOutput_)
     {
-        auto filename = AcceptIt()->SpellContent();
-        Out() << " \"" << filename << '\"';
+        /* Set new line number and filename for all following tokens, since the parser does not see this directive */
+        auto filename = (filenameTkn ? filenameTkn->SpellContent() : GetScanner().Source()->Filename());
+        auto currentLine = static_cast<int>(lineNumberTkn->Pos().Row());
+        GetScanner().Source()->NextSourceOrigin(filename, (ParseIntLiteral(lineNumberTkn) - currentLine - 1));
+        tokenOutput_->AddOrigin(GetScanner().Source()->Pos(), GetScanner().GetSharedSource());
+    }
+    else
+    {
+        /* Write directive out for the parser */
+        Out() << "#line " << lineNumberTkn->Spell();
+        if (filenameTkn)
+            Out() << " \"" << filenameTkn->SpellContent() << '\"';
+        Out() << std::endl;
     }
-
-    Out() << std::endl;
 }
 
 // '#' 'error' TOKEN-STRING
@@ -1164,7 +1715,7 @@ TokenPtrString PreProcessor::ParseDirectiveTokenString(bool expandDefinedDirecti
                 else
                 {
                     /* Append identifier with macro expansion */
-                    tokenString.PushBack(ParseIdentAsTokenString());
+                    ParseIdentAsTokenString(tokenString);
                 }
             }
             break;
@@ -1189,12 +1740,10 @@ TokenPtrString PreProcessor::ParseDirectiveTokenString(bool expandDefinedDirecti
     return tokenString;
 }
 
-// Parse next argument as token string
+// Parse next argument and append it to the token string
 // --> Parse until the closing ')' token or until the next ',' token for the next argument appears
-TokenPtrString PreProcessor::ParseArgumentTokenString()
+void PreProcessor::ParseArgumentTokenString(TokenPtrString& tokenString)
 {
-    TokenPtrString tokenString;
-
     int bracketLevel = 0;
 
     /* Parse tokens until the closing bracket ')' appears */
@@ -1208,12 +1757,10 @@ TokenPtrString PreProcessor::ParseArgumentTokenString()
 
         /* Add token to token string */
         if (Is(Tokens::Ident))
-            tokenString.PushBack(ParseIdentAsTokenString());
+            ParseIdentAsTokenString(tokenString);
         else
             tokenString.PushBack(AcceptIt());
     }
-
-    return tokenString;
 }
 
 std::string PreProcessor::ParseDefinedMacro()
@@ -1277,6 +1824,77 @@ bool PreProcessor::Macro::HasParameterList() const
     return (!parameters.empty() || emptyParamList);
 }
 
+void PreProcessor::Macro::BuildReplacements()
+{
+    replacements.clear();
+
+    if (!HasParameterList())
+        return;
+
+    auto FindParameter = [this](const std::string& ident, std::size_t& index) -> bool
+    {
+        for (index = 0; index < parameters.size(); ++index)
+        {
+            if (ident == parameters[index])
+                return true;
+        }
+        return false;
+    };
+
+    const auto& tokens = tokenString.GetTokens();
+    replacements.reserve(tokens.size());
+
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+    {
+        const auto& tkn = *tokens[i];
+        std::size_t paramIndex = 0;
+
+        /* Check if current token is an identifier which matches one of the parameters of the macro */
+        switch (tkn.Type())
+        {
+            case Tokens::Ident:
+            {
+                if (tkn.Spell() == "__VA_ARGS__")
+                {
+                    replacements.push_back({ Replacement::Types::VarArgs, 0 });
+                    continue;
+                }
+                if (FindParameter(tkn.Spell(), paramIndex))
+                {
+                    replacements.push_back({ Replacement::Types::Argument, paramIndex });
+                    continue;
+                }
+            }
+            break;
+
+            case Tokens::Directive:
+            {
+                if (FindParameter(tkn.Spell(), paramIndex))
+                {
+                    replacements.push_back({ Replacement::Types::Stringize, paramIndex });
+                    continue;
+                }
+            }
+            break;
+
+            case Tokens::DirectiveConcat:
+            {
+                /* Ignore concatenation token and the following white spaces and comments */
+                replacements.push_back({ Replacement::Types::Concat, 0 });
+                while (i + 1 < tokens.size() && !DefaultTokenOfInterestFunctor::IsOfInterest(tokens[i + 1]))
+                    ++i;
+                continue;
+            }
+            break;
+
+            default:
+            break;
+        }
+
+        replacements.push_back({ Replacement::Types::Token, i });
+    }
+}
+
 
 /*
  * IfBlock structure
@@ -16,12 +16,17 @@
 #include "ASTEnums.h"
 #include "Parser.h"
 #include "SourceCode.h"
+#include "TokenStreamSource.h"
+#include "PrecompiledHeaderData.h"
+#include "ConstExprProgram.h"
 #include <iostream>
 #include <functional>
 #include <initializer_list>
 #include <stack>
+#include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 
 namespace Xsc
@@ -43,21 +48,69 @@ class PreProcessor : public Parser
         PreProcessor(IncludeHandler& includeHandler, Log* log = nullptr);
 
         std::unique_ptr<std::iostream> Process(
-            const SourceCodePtr&    input,
-            const std::string&      filename = "",
-            bool                    writeLineMarks = true,
-            bool                    writeLineMarkFilenames = true,
-            bool                    enableWarnings = false
+            const SourceCodePtr&                input,
+            const std::string&                  filename = "",
+            bool                                writeLineMarks = true,
+            bool                                writeLineMarkFilenames = true,
+            bool                                enableWarnings = false,
+            const std::vector<PredefinedMacro>& predefinedMacros = {}
         );
 
+        // Pre-processes the input source like "Process", but returns the output tokens for the parser instead of the output source code.
+        TokenStreamSourcePtr ProcessTokens(
+            const SourceCodePtr&                input,
+            const std::string&                  filename = "",
+            bool                                enableWarnings = false,
+            const std::vector<PredefinedMacro>& predefinedMacros = {}
+        );
+
+        /*
+        Pre-processes the input source as header file for a precompiled header, and stores the resulting pre-processor state in 'pch'.
+        Returns false on failure.
+        */
+        bool ProcessPrecompiledHeader(
+            const SourceCodePtr&                input,
+            const std::string&                  filename,
+            bool                                writeLineMarks,
+            bool                                writeLineMarkFilenames,
+            bool                                enableWarnings,
+            const std::vector<PredefinedMacro>& predefinedMacros,
+            PrecompiledHeaderData&              pch
+        );
+
+        // Sets the precompiled header, which replaces the inclusion of its header file while it is up to date. By default null.
+        void UsePrecompiledHeader(const PrecompiledHeaderData* pch);
+
         // Returns a list of all defined macro identifiers after pre-processing.
         std::vector<std::string> ListDefinedMacroIdents() const;
 
+        // Returns the number of '#include'-directives that have been skipped, because the include guard of the file was still defined.
+        inline std::size_t NumSkippedIncludes() const
+        {
+            return numSkippedIncludes_;
+        }
+
     protected:
 
         // Macro object structure.
         struct Macro
         {
+            // Replacement of a single token of the macro value, which is determined once when the macro is defined.
+            struct Replacement
+            {
+                enum class Types
+                {
+                    Token,      // Copy value token at 'index'
+                    Argument,   // Insert argument at 'index'
+                    Stringize,  // Insert argument at 'index' as string literal
+                    VarArgs,    // Insert all variadic arguments separated by commas
+                    Concat,     // Remove previous white spaces and comments
+                };
+
+                Types       type;
+                std::size_t index;
+            };
+
             Macro() = default;
             Macro(const Macro&) = default;
             Macro& operator = (const Macro&) = default;
@@ -76,12 +129,16 @@ class PreProcessor : public Parser
 
             bool HasParameterList() const;
 
+            // Determines the replacements of the macro value tokens by the parameters (only for macros with parameter list).
+            void BuildReplacements();
+
             TokenPtr                    identTkn;                   // Macro identifier token
             TokenPtrString              tokenString;                // Macro definition value as token string
             std::vector<std::string>    parameters;                 // Parameter identifiers
             bool                        varArgs         = false;    // Specifies whether the macro supports variadic arguments
             bool                        stdMacro        = false;    // Specifies whether the macro is a standard macro (i.e. part of the language) or not
             bool                        emptyParamList  = false;    // Macro has an empty parameter list
+            std::vector<Replacement>    replacements;               // Replacements of the value tokens (see BuildReplacements)
         };
 
         // Parses the specified directive, that is not part of the standard pre-processor directive (e.g. "version" or "extension" for GLSL).
@@ -96,6 +153,9 @@ class PreProcessor : public Parser
         // Defines a macro with the specified identifier, value token string, and parameters.
         void DefineMacro(const Macro& macro);
 
+        // Defines the specified pre-defined macros (i.e. not part of the source code), whose values are scanned as token strings.
+        void DefinePredefinedMacros(const std::vector<PredefinedMacro>& predefinedMacros);
+
         // Defines a standard macro (i.e. not part of the source code) with value set to integer literal '1'.
         void DefineStandardMacro(const std::string& ident, int intValue = 1);
 
@@ -117,8 +177,8 @@ class PreProcessor : public Parser
         // Callback function when the standard macro must be substituted (e.g. __FILE__ to string literal).
         virtual bool OnSubstitueStdMacro(const Token& identTkn, TokenPtrString& tokenString);
 
-        // Evaluate the expression of the specified token string.
-        Variant EvaluateExpr(const TokenPtrString& tokenString, const Token* tkn = nullptr);
+        // Evaluate the expression of the specified token string. If 'program' is non-null, the expression is also compiled into this program.
+        Variant EvaluateExpr(const TokenPtrString& tokenString, const Token* tkn = nullptr, ConstExprProgram* program = nullptr);
 
         // Parse a token string and evaluate it as expression.
         Variant ParseAndEvaluateExpr(const Token* tkn = nullptr);
@@ -148,12 +208,40 @@ class PreProcessor : public Parser
             bool            elseAllowed     = true;     // Is an else-block allowed?
         };
 
+        /*
+        Include guard detection of a source file (i.e. the entire file is enclosed by '#ifndef GUARD' ... '#endif'),
+        to skip the file on re-inclusion while the guard macro is defined, like the multiple-include optimization of GCC and Clang.
+        */
+        struct IncludeGuard
+        {
+            enum class States
+            {
+                Start,      // Expecting '#ifndef GUARD' (only white spaces and comments so far)
+                Inside,     // Inside the '#ifndef'-block
+                End,        // After the '#endif' of the '#ifndef'-block (only white spaces and comments so far)
+                Invalid,    // The file has no include guard
+            };
+
+            std::string filename;
+            std::string ident;                          // Identifier of the guard macro
+            std::size_t ifBlockDepth    = 0;            // Size of the if-block stack when the file was entered
+            States      state           = States::Start;
+        };
+
         using MacroPtr = std::shared_ptr<Macro>;
 
         /* === Functions === */
 
         ScannerPtr MakeScanner() override;
 
+        // Pre-processes the input source into the output stream or output tokens. Returns false on failure.
+        bool ProcessPrimary(
+            const SourceCodePtr&                input,
+            const std::string&                  filename,
+            bool                                enableWarnings,
+            const std::vector<PredefinedMacro>& predefinedMacros
+        );
+
         void PushScannerSource(const SourceCodePtr& source, const std::string& filename = "") override;
         bool PopScannerSource() override;
 
@@ -164,23 +252,58 @@ class PreProcessor : public Parser
         // Returns the if-block state from the top of the stack. If the stack is empty, the default state is returned.
         IfBlock TopIfBlock() const;
 
+        // Updates the include guard detection of the current source file for the specified active token or directive.
+        void DetectIncludeGuard(const Token& tkn);
+        void DetectIncludeGuard(const std::string& directive);
+
+        /*
+        Appends the macro value to the token string, and replaces all parameters by the respective arguments.
+        The arguments are taken from the argument stack at index 'firstArgument' (see PushMacroArgument).
+        */
+        void ExpandMacro(TokenPtrString& tokenString, const Macro& macro, std::size_t firstArgument, std::size_t numArguments);
+
+        // Pushes a new empty token string onto the macro argument stack, whose token storage is reused for all macro expansions.
+        TokenPtrString& PushMacroArgument();
+
         /*
-        Replaces all identifiers (specified by 'macro.parameters') in the token string (specified by 'macro.tokenString')
-        by the respective replacement (specified by 'arguments'). The number of identifiers and the number of replacements must be equal.
+        Evaluates the expression of the specified token string like "EvaluateExpr", but executes the compiled expression
+        from a previous evaluation of the same token string. The entire token string must be an expression in brackets.
         */
-        TokenPtrString ExpandMacro(const Macro& macro, const std::vector<TokenPtrString>& arguments);
+        Variant EvaluateCachedExpr(const TokenPtrString& tokenString, const Token* tkn);
+
+        // Builds the key of the expression cache for the specified token string. Returns false if the token string contains identifiers.
+        static bool BuildExprCacheKey(const TokenPtrString& tokenString, std::string& key);
+
+        // Returns the hash of all macro definitions and 'once included' files, to validate a precompiled header.
+        std::uint64_t MacroStateHash() const;
+
+        // Reads the entire include stream, and records it as dependency of the precompiled header that is currently created.
+        std::unique_ptr<std::istream> RecordPrecompiledHeaderDependency(
+            std::unique_ptr<std::istream>&& includeStream,
+            const std::string&              filename,
+            bool                            useSearchPaths
+        );
+
+        // Writes the precompiled header instead of the specified header content, and returns false if the precompiled header is outdated.
+        bool IncludePrecompiledHeader(const std::string& headerContent);
 
         // Writes a '#line'-directive to the output with the current source position and filename.
         void WritePosToLineDirective();
 
+        // Writes the specified token to the output stream, or appends it to the output tokens.
+        void WriteToken(const TokenPtr& tkn);
+
+        // Writes the token string of the specified identifier (i.e. the identifier itself or its macro expansion) to the output.
+        void WriteIdentTokenString(const TokenPtr& identTkn, const TokenPtrString& tokenString);
+
         /* ----- Parsing ----- */
 
         void            ParseProgram();
 
         void            ParesComment();
         void            ParseIdent();
-        TokenPtrString  ParseIdentAsTokenString();
-        TokenPtrString  ParseIdentArgumentsForMacro(const TokenPtr& identToken, const Macro& macro);
+        void            ParseIdentAsTokenString(TokenPtrString& tokenString);
+        void            ParseIdentArgumentsForMacro(TokenPtrString& tokenString, const TokenPtr& identToken, const Macro& macro);
         void            ParseMisc();
 
         void            ParseDirective();
@@ -203,7 +326,7 @@ class PreProcessor : public Parser
         ExprPtr         ParsePrimaryExpr() override;
 
         TokenPtrString  ParseDirectiveTokenString(bool expandDefinedDirective = false, bool ignoreComments = false);
-        TokenPtrString  ParseArgumentTokenString();
+        void            ParseArgumentTokenString(TokenPtrString& tokenString);
 
         std::string     ParseDefinedMacro();
 
@@ -212,11 +335,32 @@ class PreProcessor : public Parser
         IncludeHandler&                     includeHandler_;
 
         std::unique_ptr<std::stringstream>  output_;
+        TokenStreamSourcePtr                tokenOutput_;       // Output tokens (only if pre-processed with "ProcessTokens")
 
         std::map<std::string, MacroPtr>     macros_;
+        std::deque<TokenPtrString>          macroArguments_;            // Stack of macro arguments (only grows, to keep the token storage)
+        std::size_t                         numMacroArguments_  = 0;    // Number of used macro arguments on the stack
+        TokenPtrString                      identTokenString_;          // Token string of the current identifier (see ParseIdent)
+
+        /*
+        Compiled expressions (e.g. of '#if'-directives) for each token string after macro expansion.
+        Programs that failed to compile are cached as well, so the expression is only compiled once.
+        */
+        std::unordered_map<std::string, ConstExprProgram>   exprCache_;
+        std::string                                         exprCacheKey_;
+        std::vector<Variant>                                exprStack_;
+
         std::set<std::string>               onceIncluded_;
         std::map<std::string, std::size_t>  includeCounter_; // Counter for each included file
 
+        std::vector<IncludeGuard>           includeGuardStack_;         // Include guard detection for each source file on the scanner stack
+        std::map<std::string, std::string>  includeGuards_;             // Guard macro identifier for each included file with an include guard
+        std::size_t                         numSkippedIncludes_ = 0;
+
+        const PrecompiledHeaderData*        precompiledHeader_  = nullptr;  // Precompiled header to use
+        bool                                pchIncluded_        = false;    // Was the precompiled header already included? (then the header is pre-processed again)
+        PrecompiledHeaderData*              pchOutput_          = nullptr;  // Precompiled header to create (only during "ProcessPrecompiledHeader")
+
         /*
         Stack to store the info which if-block in the hierarchy is active.
         Once an if-block is inactive, all subsequent if-blocks are inactive, too.
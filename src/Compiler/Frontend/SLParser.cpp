@@ -470,7 +470,7 @@ TypeDenoterPtr SLParser::ParseTypeDenoterWithArrayOpt(const TypeDenoterPtr& base
 {
     if (Is(Tokens::LParen))
     {
-        auto arrayTypeDenoter = std::make_shared<ArrayTypeDenoter>(baseTypeDenoter);
+        auto arrayTypeDenoter = MakeShared<ArrayTypeDenoter>(baseTypeDenoter);
 
         /* Parse array dimension list */
         arrayTypeDenoter->arrayDims = ParseArrayDimensionList();
@@ -483,7 +483,7 @@ TypeDenoterPtr SLParser::ParseTypeDenoterWithArrayOpt(const TypeDenoterPtr& base
 VoidTypeDenoterPtr SLParser::ParseVoidTypeDenoter()
 {
     Accept(Tokens::Void);
-    return std::make_shared<VoidTypeDenoter>();
+    return VoidTypeDenoter::GetCanonical();
 }
 
 Variant SLParser::ParseAndEvaluateConstExpr()
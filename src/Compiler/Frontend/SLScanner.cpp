@@ -6,6 +6,7 @@
  */
 
 #include "SLScanner.h"
+#include "ReportIdents.h"
 #include <cctype>
 
 
@@ -13,6 +14,86 @@ namespace Xsc
 {
 
 
+/*
+ * Internal functions
+ */
+
+struct Punctuation
+{
+    const char*     spell;
+    std::size_t     length;
+    Token::Types    type;
+};
+
+// Operators and punctuation of the shading languages, with the longest ones first.
+static const Punctuation g_punctuations[] =
+{
+    { "<<=", 3, Token::Types::AssignOp  },
+    { ">>=", 3, Token::Types::AssignOp  },
+    { "==",  2, Token::Types::BinaryOp  },
+    { "!=",  2, Token::Types::BinaryOp  },
+    { "<=",  2, Token::Types::BinaryOp  },
+    { ">=",  2, Token::Types::BinaryOp  },
+    { "<<",  2, Token::Types::BinaryOp  },
+    { ">>",  2, Token::Types::BinaryOp  },
+    { "&&",  2, Token::Types::BinaryOp  },
+    { "||",  2, Token::Types::BinaryOp  },
+    { "++",  2, Token::Types::UnaryOp   },
+    { "--",  2, Token::Types::UnaryOp   },
+    { "+=",  2, Token::Types::AssignOp  },
+    { "-=",  2, Token::Types::AssignOp  },
+    { "*=",  2, Token::Types::AssignOp  },
+    { "/=",  2, Token::Types::AssignOp  },
+    { "%=",  2, Token::Types::AssignOp  },
+    { "&=",  2, Token::Types::AssignOp  },
+    { "|=",  2, Token::Types::AssignOp  },
+    { "^=",  2, Token::Types::AssignOp  },
+    { "::",  2, Token::Types::DColon    },
+    { "=",   1, Token::Types::AssignOp  },
+    { "!",   1, Token::Types::UnaryOp   },
+    { "~",   1, Token::Types::UnaryOp   },
+    { "<",   1, Token::Types::BinaryOp  },
+    { ">",   1, Token::Types::BinaryOp  },
+    { "&",   1, Token::Types::BinaryOp  },
+    { "|",   1, Token::Types::BinaryOp  },
+    { "^",   1, Token::Types::BinaryOp  },
+    { "%",   1, Token::Types::BinaryOp  },
+    { "*",   1, Token::Types::BinaryOp  },
+    { "+",   1, Token::Types::BinaryOp  },
+    { "-",   1, Token::Types::BinaryOp  },
+    { "/",   1, Token::Types::BinaryOp  },
+    { ":",   1, Token::Types::Colon     },
+    { ";",   1, Token::Types::Semicolon },
+    { ",",   1, Token::Types::Comma     },
+    { "?",   1, Token::Types::TernaryOp },
+    { "(",   1, Token::Types::LBracket  },
+    { ")",   1, Token::Types::RBracket  },
+    { "{",   1, Token::Types::LCurly    },
+    { "}",   1, Token::Types::RCurly    },
+    { "[",   1, Token::Types::LParen    },
+    { "]",   1, Token::Types::RParen    },
+};
+
+// Returns the length of the longest operator or punctuation at the specified offset, or 0 if there is none.
+static std::size_t MatchPunctuation(const std::string& s, std::size_t offset, Token::Types& type)
+{
+    for (const auto& punctuation : g_punctuations)
+    {
+        if (s.compare(offset, punctuation.length, punctuation.spell) == 0)
+        {
+            type = punctuation.type;
+            return punctuation.length;
+        }
+    }
+    return 0;
+}
+
+
+/*
+ * SLScanner class
+ */
+
+
 SLScanner::SLScanner(Log* log) :
     Scanner { log }
 {
@@ -23,6 +104,88 @@ TokenPtr SLScanner::Next()
     return NextToken(false, false);
 }
 
+TokenPtrString SLScanner::ConvertPreProcessedTokens(const TokenPtrString& tokens)
+{
+    TokenPtrString output;
+
+    /* Collect adjacent tokens (i.e. without white spaces in between), since they are merged in the pre-processed source code */
+    std::vector<TokenPtr> adjacentTokens;
+    bool adjacentWords = false;
+
+    auto ConvertAdjacentTokens = [&]()
+    {
+        if (!adjacentTokens.empty())
+        {
+            if (adjacentWords)
+                ConvertWordTokens(adjacentTokens, output);
+            else
+                ConvertPunctuationTokens(adjacentTokens, output);
+            adjacentTokens.clear();
+        }
+    };
+
+    for (const auto& tkn : tokens.GetTokens())
+    {
+        switch (tkn->Type())
+        {
+            /* Ignore separators */
+            case Tokens::WhiteSpace:
+            case Tokens::NewLine:
+            case Tokens::Comment:
+                ConvertAdjacentTokens();
+                break;
+
+            /* Collect identifiers and literals */
+            case Tokens::Ident:
+            case Tokens::IntLiteral:
+            case Tokens::FloatLiteral:
+                if (!adjacentWords)
+                    ConvertAdjacentTokens();
+                adjacentWords = true;
+                adjacentTokens.push_back(tkn);
+                break;
+
+            /* Collect operators and punctuation */
+            case Tokens::AssignOp:
+            case Tokens::BinaryOp:
+            case Tokens::UnaryOp:
+            case Tokens::TernaryOp:
+            case Tokens::Colon:
+            case Tokens::Comma:
+            case Tokens::LBracket:
+            case Tokens::RBracket:
+            case Tokens::Misc:
+                if (adjacentWords)
+                    ConvertAdjacentTokens();
+                adjacentWords = false;
+                adjacentTokens.push_back(tkn);
+                break;
+
+            /* Keep tokens which are scanned equally */
+            case Tokens::StringLiteral:
+            case Tokens::Dot:
+            case Tokens::VarArg:
+            case Tokens::Directive:
+                ConvertAdjacentTokens();
+                output.PushBack(tkn);
+                break;
+
+            default:
+                ConvertAdjacentTokens();
+                ErrorUnexpectedToken(*tkn);
+                break;
+        }
+    }
+
+    ConvertAdjacentTokens();
+
+    /* Append end-of-stream token */
+    const auto& tokenList = tokens.GetTokens();
+    output.PushBack(std::make_shared<Token>((tokenList.empty() ? SourcePosition() : tokenList.back()->Pos()), Tokens::EndOfStream));
+
+    return output;
+}
+
 
 /*
  * ======= Private: =======
@@ -229,6 +392,87 @@ TokenPtr SLScanner::ScanMinusOp()
     return Make(Tokens::BinaryOp, spell);
 }
 
+void SLScanner::ConvertWordTokens(const std::vector<TokenPtr>& tokens, TokenPtrString& output)
+{
+    const auto& firstTkn = tokens.front();
+
+    std::string spell;
+    for (const auto& tkn : tokens)
+        spell += tkn->Spell();
+
+    StoreStartPos(firstTkn->Pos());
+
+    try
+    {
+        if (std::isalpha(static_cast<unsigned char>(spell.front())) || spell.front() == '_')
+            output.PushBack(ScanIdentifierOrKeyword(std::move(spell)));
+        else if (tokens.size() == 1)
+            output.PushBack(firstTkn);
+        else
+            output.PushBack(Make(firstTkn->Type(), spell));
+    }
+    catch (const Report& err)
+    {
+        if (GetLog())
+            GetLog()->SubmitReport(err);
+    }
+}
+
+void SLScanner::ConvertPunctuationTokens(const std::vector<TokenPtr>& tokens, TokenPtrString& output)
+{
+    std::string spell;
+    for (const auto& tkn : tokens)
+        spell += tkn->Spell();
+
+    std::size_t tknIndex = 0, tknOffset = 0;
+
+    for (std::size_t i = 0; i < spell.size();)
+    {
+        /* Find source position of the current character within its pre-processor token */
+        while (i >= tknOffset + tokens[tknIndex]->Spell().size())
+            tknOffset += tokens[tknIndex++]->Spell().size();
+
+        auto pos = tokens[tknIndex]->Pos();
+        for (auto j = tknOffset; j < i; ++j)
+            pos.IncColumn();
+
+        StoreStartPos(pos);
+
+        try
+        {
+            /* Take the longest operator or punctuation */
+            Token::Types type = Tokens::Undefined;
+            if (auto length = MatchPunctuation(spell, i, type))
+            {
+                auto opSpell = spell.substr(i, length);
+                output.PushBack(Make(type, opSpell));
+                i += length;
+            }
+            else
+                Error(R_UnexpectedChar(std::string(1, spell[i++])));
+        }
+        catch (const Report& err)
+        {
+            if (GetLog())
+                GetLog()->SubmitReport(err);
+        }
+    }
+}
+
+void SLScanner::ErrorUnexpectedToken(const Token& tkn)
+{
+    StoreStartPos(tkn.Pos());
+    try
+    {
+        Error(R_UnexpectedChar(tkn.Spell().substr(0, 1)));
+    }
+    catch (const Report& err)
+    {
+        if (GetLog())
+            GetLog()->SubmitReport(err);
+    }
+}
+
 
 } // /namespace Xsc
 
@@ -10,6 +10,7 @@
 
 
 #include "Scanner.h"
+#include <vector>
 
 
 namespace Xsc
@@ -27,6 +28,12 @@ class SLScanner : public Scanner
         // Scanns the next token.
         TokenPtr Next() override;
 
+        /*
+        Converts the output tokens of the pre-processor into the tokens of this scanner, which are terminated by an end-of-stream token.
+        Adjacent tokens are merged as they would be scanned from the pre-processed source code (e.g. '+' and '=' to '+=').
+        */
+        TokenPtrString ConvertPreProcessedTokens(const TokenPtrString& tokens);
+
     protected:
 
         virtual TokenPtr ScanIdentifierOrKeyword(std::string&& spell) = 0;
@@ -43,6 +50,15 @@ class SLScanner : public Scanner
         TokenPtr ScanPlusOp();
         TokenPtr ScanMinusOp();
 
+        // Converts adjacent identifiers and literals into a single identifier, keyword, or literal.
+        void ConvertWordTokens(const std::vector<TokenPtr>& tokens, TokenPtrString& output);
+
+        // Converts adjacent operators and punctuation by taking the longest match first.
+        void ConvertPunctuationTokens(const std::vector<TokenPtr>& tokens, TokenPtrString& output);
+
+        // Submits an 'unexpected character' error for the specified token, which can not be converted.
+        void ErrorUnexpectedToken(const Token& tkn);
+
 };
 
 
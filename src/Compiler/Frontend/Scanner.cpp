@@ -82,6 +82,7 @@ TokenPtr Scanner::NextToken(bool scanComments, bool scanWhiteSpaces)
             /* Scan next token from token string */
             auto& tokenStringIt = tokenStringItStack_.back();
             tkn = *(tokenStringIt++);
+            nextStartPos_ = tkn->Pos();
             break;
         }
     }
@@ -189,6 +190,11 @@ void Scanner::StoreStartPos()
     nextStartPos_ = source_->Pos();
 }
 
+void Scanner::StoreStartPos(const SourcePosition& pos)
+{
+    nextStartPos_ = pos;
+}
+
 char Scanner::Take(char chr)
 {
     if (chr_ != chr)
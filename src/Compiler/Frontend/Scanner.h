@@ -86,6 +86,9 @@ class Scanner
 
         void StoreStartPos();
 
+        // Stores the specified source position as start position for the next token (e.g. for tokens that are not scanned from characters).
+        void StoreStartPos(const SourcePosition& pos);
+
         virtual TokenPtr ScanToken() = 0;
 
         char Take(char chr);
@@ -132,6 +135,12 @@ class Scanner
 
         /* ----- Helper functions ----- */
 
+        // Returns the output log (may also be null).
+        inline Log* GetLog() const
+        {
+            return log_;
+        }
+
         // Returns true if the next character is a new-line character (i.e. '\n' or '\r').
         inline bool IsNewLine() const
         {
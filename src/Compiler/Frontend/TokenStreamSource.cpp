@@ -0,0 +1,40 @@
+/*
+ * TokenStreamSource.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TokenStreamSource.h"
+#include <sstream>
+
+
+namespace Xsc
+{
+
+
+TokenStreamSource::TokenStreamSource() :
+    SourceCode { std::make_shared<std::stringstream>() }
+{
+}
+
+bool TokenStreamSource::FetchLineMarker(const SourceArea& area, std::string& line, std::string& marker)
+{
+    auto it = originSources_.find(area.Pos().GetOrigin());
+    if (it != originSources_.end())
+        return it->second.source->FetchLineMarker(area, line, marker);
+    return false;
+}
+
+void TokenStreamSource::AddOrigin(const SourcePosition& pos, const SourceCodePtr& source)
+{
+    if (auto origin = pos.GetOrigin())
+        originSources_[origin] = { pos, source };
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,69 @@
+/*
+ * TokenStreamSource.h
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_TOKEN_STREAM_SOURCE_H
+#define XSC_TOKEN_STREAM_SOURCE_H
+
+
+#include "SourceCode.h"
+#include "TokenString.h"
+#include <map>
+
+
+namespace Xsc
+{
+
+
+/*
+Source code of the output tokens from the pre-processor, which are handed over to the parser directly.
+This avoids writing the pre-processed source as text, which would be scanned a second time by the parser.
+All tokens keep their positions within the original source files, whose source codes are kept for the line markers of reports.
+*/
+class TokenStreamSource final : public SourceCode
+{
+
+    public:
+
+        TokenStreamSource();
+
+        // Fetches the line with the marker string from the original source code of the specified source area.
+        bool FetchLineMarker(const SourceArea& area, std::string& line, std::string& marker) override;
+
+        // Registers the original source code for all source positions with the same origin as the specified position.
+        void AddOrigin(const SourcePosition& pos, const SourceCodePtr& source);
+
+        // Returns the output tokens of the pre-processor.
+        inline TokenPtrString& GetTokens()
+        {
+            return tokens_;
+        }
+
+    private:
+
+        // Original source code of a source origin.
+        struct OriginSource
+        {
+            SourcePosition  pos;    // Keeps the origin alive, since it is used as key
+            SourceCodePtr   source;
+        };
+
+        TokenPtrString                              tokens_;
+        std::map<const SourceOrigin*, OriginSource> originSources_;
+
+};
+
+using TokenStreamSourcePtr = std::shared_ptr<TokenStreamSource>;
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
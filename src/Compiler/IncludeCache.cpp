@@ -0,0 +1,48 @@
+/*
+ * IncludeCache.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "IncludeCache.h"
+#include "Helper.h"
+#include "MemoryStream.h"
+#include <iterator>
+
+
+namespace Xsc
+{
+
+
+IncludeCache::IncludeCache(IncludeHandler& includeHandler) :
+    includeHandler_ { includeHandler }
+{
+}
+
+std::unique_ptr<std::istream> IncludeCache::Include(const std::string& filename, bool useSearchPathsFirst)
+{
+    const FileKey key { filename, useSearchPathsFirst };
+
+    auto it = fileContents_.find(key);
+    if (it == fileContents_.end())
+    {
+        /* Load file from the underlying include handler (failures are not cached) */
+        auto file = includeHandler_.Include(filename, useSearchPathsFirst);
+        if (!file)
+            return nullptr;
+
+        auto content = std::string(std::istreambuf_iterator<char>(*file), std::istreambuf_iterator<char>());
+        it = fileContents_.emplace(key, std::move(content)).first;
+    }
+
+    /* Borrow cached file content, which is kept until this include cache is destroyed */
+    return MakeUnique<MemoryInputStream>(it->second.data(), it->second.size());
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,48 @@
+/*
+ * IncludeCache.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_INCLUDE_CACHE_H
+#define XSC_INCLUDE_CACHE_H
+
+
+#include <Xsc/IncludeHandler.h>
+#include <map>
+#include <string>
+
+
+namespace Xsc
+{
+
+
+// Include handler which loads each included file only once from another include handler, and keeps its content.
+class IncludeCache final : public IncludeHandler
+{
+
+    public:
+
+        IncludeCache(IncludeHandler& includeHandler);
+
+        std::unique_ptr<std::istream> Include(const std::string& filename, bool useSearchPathsFirst) override;
+
+    private:
+
+        using FileKey = std::pair<std::string, bool>;
+
+        IncludeHandler&                 includeHandler_;
+        std::map<FileKey, std::string>  fileContents_;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -8,7 +8,8 @@
 #include <Xsc/IncludeHandler.h>
 #include "ReportIdents.h"
 #include "Exception.h"
-#include <fstream>
+#include "MemoryStream.h"
+#include <typeinfo>
 
 
 namespace Xsc
@@ -32,8 +33,8 @@ IncludeHandler::~IncludeHandler()
 
 static std::unique_ptr<std::istream> ReadFile(const std::string& filename)
 {
-    auto stream = std::unique_ptr<std::istream>(new std::ifstream(filename));
-    return (stream->good() ? std::move(stream) : nullptr);
+    /* Read file into memory, so its source code is scanned directly from the memory buffer */
+    return MemoryInputStream::ReadFile(filename);
 }
 
 std::unique_ptr<std::istream> IncludeHandler::Include(const std::string& filename, bool useSearchPathsFirst)
@@ -72,6 +73,12 @@ std::unique_ptr<std::istream> IncludeHandler::Include(const std::string& filenam
     RuntimeErr(R_FailedToIncludeFile(filename));
 }
 
+bool IncludeHandler::IsThreadSafe() const
+{
+    /* Only the default implementation is known to be thread-safe */
+    return (typeid(*this) == typeid(IncludeHandler));
+}
+
 std::vector<std::string>& IncludeHandler::GetSearchPaths()
 {
     return data_->searchPaths;
@@ -0,0 +1,324 @@
+/*
+ * IncludePrefetcher.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "IncludePrefetcher.h"
+#include "MemoryStream.h"
+#include <iterator>
+#include <algorithm>
+#include <cstring>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Maximal number of files, which are loaded in the background for a single input source.
+static const std::size_t g_maxPrefetchedFiles = 256;
+
+static bool IsBlank(char c)
+{
+    return (c == ' ' || c == '\t');
+}
+
+/*
+Scans the specified source code for '#include'-directives at the beginning of a line, and passes each filename to the callback.
+Comments and '#if'-blocks are ignored, since the included files are only loaded speculatively.
+*/
+template <typename TCallback>
+static void ScanIncludeDirectives(const char* data, std::size_t size, TCallback callback)
+{
+    static const char       directive[]     = "include";
+    static const std::size_t directiveLen   = sizeof(directive) - 1;
+
+    const char* end = data + size;
+
+    for (auto s = data; s < end;)
+    {
+        /* Parse '#' 'include' at the beginning of the line */
+        while (s < end && IsBlank(*s))
+            ++s;
+
+        if (s < end && *s == '#')
+        {
+            ++s;
+            while (s < end && IsBlank(*s))
+                ++s;
+
+            if (static_cast<std::size_t>(end - s) > directiveLen && std::strncmp(s, directive, directiveLen) == 0)
+            {
+                s += directiveLen;
+                while (s < end && IsBlank(*s))
+                    ++s;
+
+                /* Parse filename in quotes or angle brackets */
+                if (s < end && (*s == '\"' || *s == '<'))
+                {
+                    const bool useSearchPathsFirst  = (*s == '<');
+                    const char terminator           = (useSearchPathsFirst ? '>' : '\"');
+                    const char* filenameBegin       = ++s;
+
+                    while (s < end && *s != terminator && *s != '\n')
+                        ++s;
+
+                    if (s < end && *s == terminator && s > filenameBegin)
+                        callback(std::string(filenameBegin, s), useSearchPathsFirst);
+                }
+            }
+        }
+
+        /* Skip remaining line */
+        while (s < end && *s != '\n')
+            ++s;
+        if (s < end)
+            ++s;
+    }
+}
+
+
+/*
+ * IncludePrefetcher class
+ */
+
+IncludePrefetcher::IncludePrefetcher(IncludeHandler& includeHandler, std::size_t numThreads) :
+    includeHandler_ { includeHandler                         },
+    numThreads_     { std::max<std::size_t>(numThreads, 1u) }
+{
+}
+
+IncludePrefetcher::~IncludePrefetcher()
+{
+    /* Stop all workers (files that are currently loaded are still finished) */
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+        stop_ = true;
+        queue_.clear();
+    }
+    queueCondition_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+std::unique_ptr<std::istream> IncludePrefetcher::Include(const std::string& filename, bool useSearchPathsFirst)
+{
+    const FileKey key { filename, useSearchPathsFirst };
+
+    {
+        std::unique_lock<std::mutex> lock { mutex_ };
+
+        auto it = files_.find(key);
+        if (it != files_.end())
+        {
+            auto& entry = it->second;
+
+            /* Wait until the file has been loaded in the background */
+            loadCondition_.wait(lock, [&entry]() { return (entry.state != FileEntry::States::Loading); });
+
+            if (entry.state == FileEntry::States::Loaded)
+            {
+                if (entry.prefetched)
+                    ++numPrefetchHits_;
+                return MakeContentStream(entry.content);
+            }
+
+            /* Load queued or failed file on the calling thread (the workers skip files that are not queued anymore) */
+            entry.state = FileEntry::States::Loading;
+        }
+        else
+            files_[key].state = FileEntry::States::Loading;
+    }
+
+    /* Load file on the calling thread, so failures are reported by the other include handler */
+    FileContent content;
+
+    try
+    {
+        content = LoadFile(key);
+    }
+    catch (...)
+    {
+        StoreFile(key, nullptr, false);
+        throw;
+    }
+
+    StoreFile(key, &content, false);
+
+    return (content.owner ? MakeContentStream(content) : nullptr);
+}
+
+void IncludePrefetcher::Prefetch(const char* data, std::size_t size)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    ScanIncludeDirectives(
+        data, size,
+        [this](const std::string& filename, bool useSearchPathsFirst)
+        {
+            Enqueue(filename, useSearchPathsFirst);
+        }
+    );
+
+    if (!queue_.empty())
+    {
+        /* Start workers on demand, i.e. only for sources with '#include'-directives */
+        while (workers_.size() < numThreads_)
+            workers_.emplace_back(&IncludePrefetcher::WorkerThread, this);
+
+        queueCondition_.notify_all();
+    }
+}
+
+std::shared_ptr<std::istream> IncludePrefetcher::PrefetchSource(const std::shared_ptr<std::istream>& stream)
+{
+    if (!stream)
+        return stream;
+
+    /* Scan memory stream directly */
+    if (auto memoryInputStream = dynamic_cast<const MemoryInputStream*>(stream.get()))
+    {
+        Prefetch(memoryInputStream->Data(), memoryInputStream->Size());
+        return stream;
+    }
+
+    /* Read entire source into memory */
+    auto content = std::make_shared<std::string>(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    Prefetch(content->data(), content->size());
+
+    return std::make_shared<MemoryInputStream>(content->data(), content->size(), content);
+}
+
+std::size_t IncludePrefetcher::NumPrefetchHits() const
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    return numPrefetchHits_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+IncludePrefetcher::FileContent IncludePrefetcher::LoadFile(const FileKey& key)
+{
+    FileContent content;
+
+    auto stream = includeHandler_.Include(key.first, key.second);
+    if (!stream)
+        return content;
+
+    if (auto memoryInputStream = dynamic_cast<MemoryInputStream*>(stream.get()))
+    {
+        /* Keep memory stream (e.g. the content of a file) as owner of its buffer */
+        content.data    = memoryInputStream->Data();
+        content.size    = memoryInputStream->Size();
+        content.owner   = std::shared_ptr<const void>(std::move(stream));
+    }
+    else
+    {
+        /* Read entire stream into memory */
+        auto buffer = std::make_shared<std::string>(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+        content.data    = buffer->data();
+        content.size    = buffer->size();
+        content.owner   = std::move(buffer);
+    }
+
+    return content;
+}
+
+void IncludePrefetcher::StoreFile(const FileKey& key, const FileContent* content, bool prefetched)
+{
+    {
+        std::lock_guard<std::mutex> guard { mutex_ };
+
+        auto& entry = files_[key];
+
+        if (content && content->owner)
+        {
+            entry.state         = FileEntry::States::Loaded;
+            entry.content       = *content;
+            entry.prefetched    = prefetched;
+        }
+        else
+            entry.state = FileEntry::States::Failed;
+    }
+
+    loadCondition_.notify_all();
+
+    /* Load files that are included by this file */
+    if (content && content->owner)
+        Prefetch(content->data, content->size);
+}
+
+void IncludePrefetcher::Enqueue(const std::string& filename, bool useSearchPathsFirst)
+{
+    if (files_.size() < g_maxPrefetchedFiles)
+    {
+        FileKey key { filename, useSearchPathsFirst };
+        if (files_.find(key) == files_.end())
+        {
+            files_[key].state = FileEntry::States::Queued;
+            queue_.push_back(std::move(key));
+        }
+    }
+}
+
+void IncludePrefetcher::WorkerThread()
+{
+    while (true)
+    {
+        FileKey key;
+
+        /* Wait for next queued file */
+        {
+            std::unique_lock<std::mutex> lock { mutex_ };
+
+            queueCondition_.wait(lock, [this]() { return (stop_ || !queue_.empty()); });
+
+            if (stop_)
+                return;
+
+            key = std::move(queue_.front());
+            queue_.pop_front();
+
+            /* Skip file if it is already loaded on the calling thread */
+            auto& entry = files_[key];
+            if (entry.state != FileEntry::States::Queued)
+                continue;
+
+            entry.state = FileEntry::States::Loading;
+        }
+
+        /* Load file in the background; failures are ignored until the file is actually included */
+        FileContent content;
+
+        try
+        {
+            content = LoadFile(key);
+        }
+        catch (...)
+        {
+        }
+
+        StoreFile(key, &content, true);
+    }
+}
+
+std::unique_ptr<std::istream> IncludePrefetcher::MakeContentStream(const FileContent& content)
+{
+    return std::unique_ptr<std::istream>(new MemoryInputStream(content.data, content.size, content.owner));
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,118 @@
+/*
+ * IncludePrefetcher.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_INCLUDE_PREFETCHER_H
+#define XSC_INCLUDE_PREFETCHER_H
+
+
+#include <Xsc/IncludeHandler.h>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <map>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Include handler which loads included files from another include handler on background threads, before they are included.
+Each loaded file (and the input source) is quickly scanned for '#include'-directives, whose files are loaded next,
+so the pre-processor finds most included files already in memory. The other include handler must be thread-safe (see IncludeHandler::IsThreadSafe).
+Files that can not be loaded in the background (e.g. inside of an inactive '#if'-block) are ignored until they are actually included.
+*/
+class IncludePrefetcher final : public IncludeHandler
+{
+
+    public:
+
+        IncludePrefetcher(IncludeHandler& includeHandler, std::size_t numThreads = 4);
+        ~IncludePrefetcher();
+
+        std::unique_ptr<std::istream> Include(const std::string& filename, bool useSearchPathsFirst) override;
+
+        // Starts loading all files, which are included by the specified source code.
+        void Prefetch(const char* data, std::size_t size);
+
+        /*
+        Returns an input stream for the entire content of the specified source stream, and starts loading all files it includes.
+        The source is read into memory first, unless it is already a memory stream.
+        */
+        std::shared_ptr<std::istream> PrefetchSource(const std::shared_ptr<std::istream>& stream);
+
+        // Returns the number of includes that have been served from files, which were loaded in the background.
+        std::size_t NumPrefetchHits() const;
+
+    private:
+
+        using FileKey = std::pair<std::string, bool>;
+
+        // Content of a loaded file, which is kept alive by its owner (e.g. the memory mapping of the file).
+        struct FileContent
+        {
+            std::shared_ptr<const void> owner;
+            const char*                 data    = nullptr;
+            std::size_t                 size    = 0;
+        };
+
+        struct FileEntry
+        {
+            enum class States
+            {
+                Queued,
+                Loading,
+                Loaded,
+                Failed,
+            };
+
+            States      state       = States::Queued;
+            FileContent content;
+            bool        prefetched  = false;    // Was the file loaded in the background?
+        };
+
+        // Loads the specified file from the other include handler. Exceptions are passed to the caller.
+        FileContent LoadFile(const FileKey& key);
+
+        // Stores the loaded file content, or marks the file as failed if the content is null, and wakes up all waiting threads.
+        void StoreFile(const FileKey& key, const FileContent* content, bool prefetched);
+
+        // Queues the specified file for loading in the background, if it is not known yet. The mutex must be locked.
+        void Enqueue(const std::string& filename, bool useSearchPathsFirst);
+
+        void WorkerThread();
+
+        static std::unique_ptr<std::istream> MakeContentStream(const FileContent& content);
+
+        IncludeHandler&                 includeHandler_;
+        std::size_t                     numThreads_         = 0;
+
+        mutable std::mutex              mutex_;
+        std::condition_variable         queueCondition_;    // Signaled when a file is queued or the workers must stop
+        std::condition_variable         loadCondition_;     // Signaled when a file has been loaded or has failed
+        std::map<FileKey, FileEntry>    files_;
+        std::deque<FileKey>             queue_;
+        std::vector<std::thread>        workers_;
+        bool                            stop_               = false;
+        std::size_t                     numPrefetchHits_    = 0;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,100 @@
+/*
+ * MemoryArena.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryArena.h"
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Memory arena of the current thread.
+thread_local static std::shared_ptr<MemoryArena> g_activeArena;
+
+// Returns the specified pointer aligned to the next multiple of the specified alignment (must be a power of two).
+static char* AlignPtr(char* ptr, std::size_t alignment)
+{
+    const auto mask = static_cast<std::uintptr_t>(alignment - 1);
+    return reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(ptr) + mask) & ~mask);
+}
+
+
+/*
+ * MemoryArena class
+ */
+
+MemoryArena::MemoryArena(std::size_t chunkSize) :
+    chunkSize_ { chunkSize }
+{
+}
+
+void* MemoryArena::Allocate(std::size_t size, std::size_t alignment)
+{
+    ++numAllocations_;
+
+    /* Allocate large blocks in their own chunk, to keep the remainder of the current chunk */
+    if (size + alignment > chunkSize_ / 4)
+        return AlignPtr(AllocateChunk(size + alignment), alignment);
+
+    /* Continue with a new chunk if the current chunk is exhausted */
+    auto ptr = (chunkPos_ != nullptr ? AlignPtr(chunkPos_, alignment) : nullptr);
+
+    if (ptr == nullptr || ptr > chunkEnd_ || static_cast<std::size_t>(chunkEnd_ - ptr) < size)
+    {
+        chunkPos_ = AllocateChunk(chunkSize_);
+        chunkEnd_ = chunkPos_ + chunkSize_;
+        ptr = AlignPtr(chunkPos_, alignment);
+    }
+
+    chunkPos_ = ptr + size;
+
+    return ptr;
+}
+
+const std::shared_ptr<MemoryArena>& MemoryArena::Active()
+{
+    return g_activeArena;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+char* MemoryArena::AllocateChunk(std::size_t size)
+{
+    chunks_.emplace_back(new char[size]);
+    return chunks_.back().get();
+}
+
+
+/*
+ * ArenaScope class
+ */
+
+ArenaScope::ArenaScope(const std::shared_ptr<MemoryArena>& arena) :
+    prevArena_ { g_activeArena }
+{
+    g_activeArena = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    g_activeArena = prevArena_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
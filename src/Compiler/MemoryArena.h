@@ -0,0 +1,156 @@
+/*
+ * MemoryArena.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_MEMORY_ARENA_H
+#define XSC_MEMORY_ARENA_H
+
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Memory arena which allocates memory blocks from large chunks, and releases all chunks at once.
+Memory blocks are never released individually. This class is not thread-safe.
+*/
+class MemoryArena
+{
+
+    public:
+
+        MemoryArena(std::size_t chunkSize = (64u << 10));
+
+        MemoryArena(const MemoryArena&) = delete;
+        MemoryArena& operator = (const MemoryArena&) = delete;
+
+        // Allocates a memory block with the specified size and alignment.
+        void* Allocate(std::size_t size, std::size_t alignment);
+
+        // Returns the number of memory blocks that have been allocated.
+        inline std::size_t NumAllocations() const
+        {
+            return numAllocations_;
+        }
+
+        // Returns the number of chunks that have been allocated on the heap.
+        inline std::size_t NumChunks() const
+        {
+            return chunks_.size();
+        }
+
+        // Returns the memory arena of the current thread (see ArenaScope), or null if no memory arena is active.
+        static const std::shared_ptr<MemoryArena>& Active();
+
+    private:
+
+        // Allocates a new chunk with at least the specified size, and returns its start.
+        char* AllocateChunk(std::size_t size);
+
+        std::size_t                             chunkSize_      = 0;
+        std::vector<std::unique_ptr<char[]>>    chunks_;
+        char*                                   chunkPos_       = nullptr;
+        char*                                   chunkEnd_       = nullptr;
+        std::size_t                             numAllocations_ = 0;
+
+};
+
+// Standard allocator which allocates memory from a memory arena, and keeps the arena alive as long as the allocated objects.
+template <typename T>
+class ArenaAllocator
+{
+
+    public:
+
+        using value_type = T;
+
+        ArenaAllocator(const std::shared_ptr<MemoryArena>& arena) :
+            arena_ { arena }
+        {
+        }
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& rhs) :
+            arena_ { rhs.GetArena() }
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+            return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, std::size_t)
+        {
+            // dummy (memory is released with the arena)
+        }
+
+        inline const std::shared_ptr<MemoryArena>& GetArena() const
+        {
+            return arena_;
+        }
+
+    private:
+
+        std::shared_ptr<MemoryArena> arena_;
+
+};
+
+template <typename T, typename U>
+bool operator == (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return (lhs.GetArena() == rhs.GetArena());
+}
+
+template <typename T, typename U>
+bool operator != (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+    return (lhs.GetArena() != rhs.GetArena());
+}
+
+// Activates the specified memory arena for the current thread during the lifetime of this scope (null to allocate on the heap).
+class ArenaScope
+{
+
+    public:
+
+        ArenaScope(const std::shared_ptr<MemoryArena>& arena);
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope&) = delete;
+        ArenaScope& operator = (const ArenaScope&) = delete;
+
+    private:
+
+        std::shared_ptr<MemoryArena> prevArena_;
+
+};
+
+// Makes a new shared pointer of the specified class in the active memory arena, or on the heap if no memory arena is active.
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeShared(Args&&... args)
+{
+    const auto& arena = MemoryArena::Active();
+    if (arena)
+        return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+    else
+        return std::make_shared<T>(std::forward<Args>(args)...);
+}
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,144 @@
+/*
+ * MemoryStream.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryStream.h"
+#include <fstream>
+#include <iterator>
+
+
+namespace Xsc
+{
+
+
+/*
+ * MemoryStreamBuffer class
+ */
+
+MemoryStreamBuffer::MemoryStreamBuffer(const char* data, std::size_t size)
+{
+    auto begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if ((which & std::ios_base::in) == 0)
+        return pos_type(off_type(-1));
+
+    /* Determine new read position */
+    char* pos = nullptr;
+
+    switch (dir)
+    {
+        case std::ios_base::beg:
+            pos = eback() + off;
+            break;
+        case std::ios_base::cur:
+            pos = gptr() + off;
+            break;
+        case std::ios_base::end:
+            pos = egptr() + off;
+            break;
+        default:
+            return pos_type(off_type(-1));
+    }
+
+    if (pos < eback() || pos > egptr())
+        return pos_type(off_type(-1));
+
+    setg(eback(), pos, egptr());
+
+    return pos_type(off_type(pos - eback()));
+}
+
+MemoryStreamBuffer::pos_type MemoryStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+
+/*
+ * MemoryInputStream class
+ */
+
+MemoryInputStream::MemoryInputStream(const char* data, std::size_t size, const std::shared_ptr<const void>& owner) :
+    std::istream { nullptr     },
+    buffer_      { data, size  },
+    owner_       { owner       }
+{
+    rdbuf(&buffer_);
+}
+
+std::unique_ptr<MemoryInputStream> MemoryInputStream::ReadFile(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.good())
+        return nullptr;
+
+    /* Read file into a single buffer, whose capacity is reserved by the file size */
+    auto content = std::make_shared<std::string>();
+
+    std::uint64_t modificationTime = 0, size = 0;
+    if (QueryFileStatus(filename, modificationTime, size))
+        content->reserve(static_cast<std::size_t>(size));
+
+    content->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    return std::unique_ptr<MemoryInputStream>(new MemoryInputStream(content->data(), content->size(), content));
+}
+
+
+/*
+ * CallbackStreamBuffer class
+ */
+
+void CallbackStreamBuffer::SetWriter(const SourceCodeWriter& writer)
+{
+    writer_ = writer;
+}
+
+CallbackStreamBuffer::int_type CallbackStreamBuffer::overflow(int_type chr)
+{
+    if (!traits_type::eq_int_type(chr, traits_type::eof()))
+    {
+        const auto c = traits_type::to_char_type(chr);
+        if (writer_)
+            writer_(&c, 1);
+        return chr;
+    }
+    return traits_type::not_eof(chr);
+}
+
+std::streamsize CallbackStreamBuffer::xsputn(const char* data, std::streamsize size)
+{
+    if (writer_ && size > 0)
+        writer_(data, static_cast<std::size_t>(size));
+    return size;
+}
+
+
+/*
+ * CallbackOutputStream class
+ */
+
+CallbackOutputStream::CallbackOutputStream() :
+    std::ostream { nullptr }
+{
+    rdbuf(&buffer_);
+}
+
+void CallbackOutputStream::SetWriter(const SourceCodeWriter& writer)
+{
+    buffer_.SetWriter(writer);
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
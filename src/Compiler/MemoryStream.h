@@ -0,0 +1,145 @@
+/*
+ * MemoryStream.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_MEMORY_STREAM_H
+#define XSC_MEMORY_STREAM_H
+
+
+#include <Xsc/Xsc.h>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+// Stream buffer which reads directly from a contiguous memory buffer.
+class MemoryStreamBuffer final : public std::streambuf
+{
+
+    public:
+
+        MemoryStreamBuffer(const char* data, std::size_t size);
+
+        // Returns the remaining characters, which have not been read yet.
+        inline const char* Data() const
+        {
+            return gptr();
+        }
+
+        // Returns the number of remaining characters.
+        inline std::size_t Size() const
+        {
+            return static_cast<std::size_t>(egptr() - gptr());
+        }
+
+    protected:
+
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+};
+
+/*
+Input stream which reads from a memory buffer without copying it, e.g. from the content of a file or a caller-owned buffer.
+The source code of this stream is scanned directly from the memory buffer (see SourceCode).
+*/
+class MemoryInputStream final : public std::istream
+{
+
+    public:
+
+        // Borrows the specified memory buffer, which is kept alive by the optional owner.
+        MemoryInputStream(const char* data, std::size_t size, const std::shared_ptr<const void>& owner = nullptr);
+
+        /*
+        Reads the entire specified file into a single buffer, which is owned by the stream. Returns null if the file can not be opened.
+        The file is not mapped into memory, since the stream may be kept alive while the file is modified (which would raise a bus error).
+        */
+        static std::unique_ptr<MemoryInputStream> ReadFile(const std::string& filename);
+
+        // Returns the remaining characters, which have not been read yet.
+        inline const char* Data() const
+        {
+            return buffer_.Data();
+        }
+
+        // Returns the number of remaining characters.
+        inline std::size_t Size() const
+        {
+            return buffer_.Size();
+        }
+
+    private:
+
+        MemoryStreamBuffer          buffer_;
+        std::shared_ptr<const void> owner_;
+
+};
+
+// Unbuffered stream buffer which passes all written characters directly to an output callback.
+class CallbackStreamBuffer final : public std::streambuf
+{
+
+    public:
+
+        CallbackStreamBuffer() = default;
+
+        // Sets the output callback. If this is null, all written characters are discarded.
+        void SetWriter(const SourceCodeWriter& writer);
+
+    protected:
+
+        int_type overflow(int_type chr) override;
+        std::streamsize xsputn(const char* data, std::streamsize size) override;
+
+    private:
+
+        SourceCodeWriter writer_;
+
+};
+
+// Output stream which passes the output code directly to an output callback (see ShaderOutput::sourceCodeWriter).
+class CallbackOutputStream final : public std::ostream
+{
+
+    public:
+
+        // Constructs the output stream without callback, i.e. all output is discarded (e.g. for the 'validateOnly' option).
+        CallbackOutputStream();
+
+        // Sets the output callback. If this is null, all output is discarded.
+        void SetWriter(const SourceCodeWriter& writer);
+
+    private:
+
+        CallbackStreamBuffer buffer_;
+
+};
+
+// Queries the modification time and size of the specified file, and returns false if it is not a readable file (implemented per platform).
+bool QueryFileStatus(const std::string& filename, std::uint64_t& modificationTime, std::uint64_t& size);
+
+// Lists the names of all entries in the specified directory, and returns false if the directory can not be read (implemented per platform).
+bool ListDirectoryEntries(const std::string& path, std::vector<std::string>& names);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,237 @@
+/*
+ * OverloadCache.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "OverloadCache.h"
+#include "AST.h"
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Overload cache of the current thread.
+thread_local static OverloadCache* g_activeOverloadCache = nullptr;
+
+static void AppendKeyInt(std::string& key, std::size_t value)
+{
+    key += std::to_string(value);
+    key += ',';
+}
+
+static void AppendKeyPtr(std::string& key, const void* ptr)
+{
+    AppendKeyInt(key, reinterpret_cast<std::size_t>(ptr));
+}
+
+// Appends the canonical form of the specified type denoter to the key, or returns false if the type has no canonical form.
+static bool AppendKeyType(std::string& key, const TypeDenoter* typeDen)
+{
+    if (typeDen == nullptr)
+    {
+        key += '0';
+        return true;
+    }
+
+    switch (typeDen->Type())
+    {
+        case TypeDenoter::Types::Void:
+        {
+            key += 'v';
+        }
+        break;
+
+        case TypeDenoter::Types::Null:
+        {
+            key += 'n';
+        }
+        break;
+
+        case TypeDenoter::Types::Base:
+        {
+            auto baseTypeDen = static_cast<const BaseTypeDenoter*>(typeDen);
+            key += 'b';
+            AppendKeyInt(key, static_cast<std::size_t>(baseTypeDen->dataType));
+            #ifdef XSC_ENABLE_LANGUAGE_EXT
+            if (baseTypeDen->vectorSpace.IsSpecified())
+            {
+                key += baseTypeDen->vectorSpace.ToString();
+                key += ',';
+            }
+            #endif
+        }
+        break;
+
+        case TypeDenoter::Types::Buffer:
+        {
+            auto bufferTypeDen = static_cast<const BufferTypeDenoter*>(typeDen);
+            key += 'B';
+            AppendKeyInt(key, static_cast<std::size_t>(bufferTypeDen->bufferType));
+            AppendKeyInt(key, static_cast<std::size_t>(bufferTypeDen->genericSize));
+            AppendKeyPtr(key, bufferTypeDen->bufferDeclRef);
+            if (!AppendKeyType(key, bufferTypeDen->genericTypeDenoter.get()))
+                return false;
+        }
+        break;
+
+        case TypeDenoter::Types::Sampler:
+        {
+            auto samplerTypeDen = static_cast<const SamplerTypeDenoter*>(typeDen);
+            key += 's';
+            AppendKeyInt(key, static_cast<std::size_t>(samplerTypeDen->samplerType));
+            AppendKeyPtr(key, samplerTypeDen->samplerDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Struct:
+        {
+            key += 'S';
+            AppendKeyPtr(key, static_cast<const StructTypeDenoter*>(typeDen)->structDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Alias:
+        {
+            key += 'A';
+            AppendKeyPtr(key, static_cast<const AliasTypeDenoter*>(typeDen)->aliasDeclRef);
+        }
+        break;
+
+        case TypeDenoter::Types::Array:
+        {
+            auto arrayTypeDen = static_cast<const ArrayTypeDenoter*>(typeDen);
+            key += '[';
+            for (const auto& dim : arrayTypeDen->arrayDims)
+            {
+                if (dim == nullptr)
+                    return false;
+                AppendKeyInt(key, static_cast<std::size_t>(dim->size));
+            }
+            if (!AppendKeyType(key, arrayTypeDen->subTypeDenoter.get()))
+                return false;
+            key += ']';
+        }
+        break;
+
+        default:
+        {
+            /* Function types are not cached */
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+ * OverloadCache class
+ */
+
+FunctionDecl* OverloadCache::FetchFunctionDecl(
+    const AST*                          firstDeclRef,
+    std::size_t                         numOverloads,
+    const std::vector<TypeDenoterPtr>&  argTypeDenoters,
+    const ResolveFunctionProc&          resolveProc)
+{
+    ++numLookups_;
+
+    /* Make key from symbol and argument types */
+    std::string key;
+    AppendKeyPtr(key, firstDeclRef);
+    AppendKeyInt(key, numOverloads);
+
+    for (const auto& typeDen : argTypeDenoters)
+    {
+        if (!AppendKeyType(key, typeDen.get()))
+            return resolveProc();
+    }
+
+    /* Find previous result */
+    auto it = funcDecls_.find(key);
+    if (it != funcDecls_.end())
+    {
+        ++numHits_;
+        return it->second;
+    }
+
+    /* Resolve overload and store result (only if no error was thrown) */
+    auto funcDecl = resolveProc();
+    funcDecls_[key] = funcDecl;
+
+    return funcDecl;
+}
+
+TypeDenoterPtr OverloadCache::GetIntrinsicReturnType(
+    const Intrinsic                     intrinsic,
+    const std::vector<ExprPtr>&         args,
+    const TypeDenoterPtr&               prefixTypeDenoter,
+    const ResolveIntrinsicProc&         resolveProc)
+{
+    ++numLookups_;
+
+    /* Make key from intrinsic and argument types */
+    std::string key;
+    AppendKeyInt(key, static_cast<std::size_t>(intrinsic));
+
+    if (!AppendKeyType(key, prefixTypeDenoter.get()))
+        return resolveProc();
+
+    for (const auto& arg : args)
+    {
+        if (!AppendKeyType(key, arg->GetTypeDenoter().get()))
+            return resolveProc();
+    }
+
+    /* Find previous result (return a copy, since the caller might modify the type denoter) */
+    auto it = intrinsicReturnTypes_.find(key);
+    if (it != intrinsicReturnTypes_.end())
+    {
+        ++numHits_;
+        return it->second->Copy();
+    }
+
+    /* Derive return type and store result (only if no error was thrown) */
+    auto typeDen = resolveProc();
+    if (!typeDen)
+        return typeDen;
+
+    intrinsicReturnTypes_[key] = typeDen;
+
+    return typeDen->Copy();
+}
+
+OverloadCache* OverloadCache::Active()
+{
+    return g_activeOverloadCache;
+}
+
+
+/*
+ * OverloadCacheScope class
+ */
+
+OverloadCacheScope::OverloadCacheScope(OverloadCache& overloadCache) :
+    prevOverloadCache_ { g_activeOverloadCache }
+{
+    g_activeOverloadCache = &overloadCache;
+}
+
+OverloadCacheScope::~OverloadCacheScope()
+{
+    g_activeOverloadCache = prevOverloadCache_;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
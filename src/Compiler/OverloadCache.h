@@ -0,0 +1,116 @@
+/*
+ * OverloadCache.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_OVERLOAD_CACHE_H
+#define XSC_OVERLOAD_CACHE_H
+
+
+#include "TypeDenoter.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Memo for the overload resolution of function calls and intrinsic calls within a single compilation.
+Results are keyed by the overloaded symbol and the canonical list of argument types.
+Type denoters that refer to declarations (e.g. structures) are keyed by their declaration,
+so this cache must not outlive the AST it was filled with. This class is not thread-safe.
+*/
+class OverloadCache
+{
+
+    public:
+
+        // Callback function to resolve a function overload on a cache miss.
+        using ResolveFunctionProc = std::function<FunctionDecl*()>;
+
+        // Callback function to derive an intrinsic return type on a cache miss.
+        using ResolveIntrinsicProc = std::function<TypeDenoterPtr()>;
+
+        OverloadCache() = default;
+
+        OverloadCache(const OverloadCache&) = delete;
+        OverloadCache& operator = (const OverloadCache&) = delete;
+
+        /*
+        Returns the function declaration for the overloaded function symbol with the specified argument types.
+        The symbol is identified by its first declaration and the number of overloads (which only grows while the symbol is analyzed).
+        */
+        FunctionDecl* FetchFunctionDecl(
+            const AST*                          firstDeclRef,
+            std::size_t                         numOverloads,
+            const std::vector<TypeDenoterPtr>&  argTypeDenoters,
+            const ResolveFunctionProc&          resolveProc
+        );
+
+        // Returns a copy of the return type denoter for the specified intrinsic with its arguments.
+        TypeDenoterPtr GetIntrinsicReturnType(
+            const Intrinsic                     intrinsic,
+            const std::vector<ExprPtr>&         args,
+            const TypeDenoterPtr&               prefixTypeDenoter,
+            const ResolveIntrinsicProc&         resolveProc
+        );
+
+        // Returns the number of lookups in this cache.
+        inline std::size_t NumLookups() const
+        {
+            return numLookups_;
+        }
+
+        // Returns the number of lookups that have been served by this cache.
+        inline std::size_t NumHits() const
+        {
+            return numHits_;
+        }
+
+        // Returns the overload cache of the current thread (see OverloadCacheScope), or null if no overload cache is active.
+        static OverloadCache* Active();
+
+    private:
+
+        std::unordered_map<std::string, FunctionDecl*>  funcDecls_;
+        std::unordered_map<std::string, TypeDenoterPtr> intrinsicReturnTypes_;
+
+        std::size_t                                     numLookups_ = 0;
+        std::size_t                                     numHits_    = 0;
+
+};
+
+// Activates the specified overload cache for the current thread during the lifetime of this scope.
+class OverloadCacheScope
+{
+
+    public:
+
+        OverloadCacheScope(OverloadCache& overloadCache);
+        ~OverloadCacheScope();
+
+        OverloadCacheScope(const OverloadCacheScope&) = delete;
+        OverloadCacheScope& operator = (const OverloadCacheScope&) = delete;
+
+    private:
+
+        OverloadCache* prevOverloadCache_ = nullptr;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,213 @@
+/*
+ * PerfectHashMap.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PERFECT_HASH_MAP_H
+#define XSC_PERFECT_HASH_MAP_H
+
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Immutable map template class with string keys, which is based on a perfect hash function (hash and displace).
+The hash function is generated once on construction, so that each key maps to its own slot.
+A lookup hashes the key once and compares it with only one entry. Keys that occur more than once are ignored (the first one is kept).
+*/
+template <typename T>
+class PerfectHashMap
+{
+
+    public:
+
+        using value_type        = std::pair<std::string, T>;
+        using const_iterator    = const value_type*;
+
+        PerfectHashMap() = default;
+
+        PerfectHashMap(const std::initializer_list<value_type>& entries) :
+            PerfectHashMap ( std::vector<value_type>(entries.begin(), entries.end()) )
+        {
+        }
+
+        explicit PerfectHashMap(std::vector<value_type>&& entries)
+        {
+            Build(std::move(entries));
+        }
+
+        // Returns an iterator to the entry with the specified key, or 'end()' if there is no such entry.
+        const_iterator find(const std::string& key) const
+        {
+            if (!slots_.empty())
+            {
+                const auto hash = Hash(key);
+                const auto seed = seeds_[static_cast<std::size_t>(hash >> 32) % seeds_.size()];
+
+                if (seed != 0)
+                {
+                    const auto index = slots_[Slot(hash, seed)];
+                    if (index < entries_.size() && entries_[index].first == key)
+                        return &(entries_[index]);
+                }
+            }
+            return end();
+        }
+
+        // Returns the number of elements with the specified key (either 0 or 1).
+        std::size_t count(const std::string& key) const
+        {
+            return (find(key) != end() ? 1 : 0);
+        }
+
+        // Returns the iterator to the first entry.
+        const_iterator begin() const
+        {
+            return entries_.data();
+        }
+
+        // Returns the iterator after the last entry.
+        const_iterator end() const
+        {
+            return entries_.data() + entries_.size();
+        }
+
+        // Returns the number of entries.
+        std::size_t size() const
+        {
+            return entries_.size();
+        }
+
+        // Returns true if this map is empty.
+        bool empty() const
+        {
+            return entries_.empty();
+        }
+
+    private:
+
+        // Returns the 64-bit FNV-1a hash of the specified key.
+        static std::uint64_t Hash(const std::string& key)
+        {
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+
+            for (auto chr : key)
+            {
+                hash ^= static_cast<unsigned char>(chr);
+                hash *= 0x100000001b3ull;
+            }
+
+            return hash;
+        }
+
+        // Returns the slot of the specified key hash displaced by the specified seed.
+        std::size_t Slot(std::uint64_t hash, std::uint32_t seed) const
+        {
+            /* Mix hash with seed (finalizer of SplitMix64) */
+            hash += static_cast<std::uint64_t>(seed) * 0x9e3779b97f4a7c15ull;
+            hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+            hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+            hash = (hash ^ (hash >> 31));
+            return static_cast<std::size_t>(hash % slots_.size());
+        }
+
+        void Build(std::vector<value_type>&& entries)
+        {
+            /* Remove duplicate keys (keep the first one) */
+            for (auto& entry : entries)
+            {
+                auto it = std::find_if(
+                    entries_.begin(), entries_.end(),
+                    [&entry](const value_type& e) { return (e.first == entry.first); }
+                );
+                if (it == entries_.end())
+                    entries_.push_back(std::move(entry));
+            }
+
+            if (entries_.empty())
+                return;
+
+            /* Distribute keys into buckets */
+            const auto numEntries = entries_.size();
+
+            std::vector<std::uint64_t> hashes(numEntries);
+            std::vector<std::vector<std::size_t>> buckets(std::max<std::size_t>(1, numEntries / 2));
+
+            for (std::size_t i = 0; i < numEntries; ++i)
+            {
+                hashes[i] = Hash(entries_[i].first);
+                buckets[static_cast<std::size_t>(hashes[i] >> 32) % buckets.size()].push_back(i);
+            }
+
+            /* Find displacement seed for each bucket, starting with the largest buckets */
+            std::vector<std::size_t> bucketOrder(buckets.size());
+            for (std::size_t i = 0; i < bucketOrder.size(); ++i)
+                bucketOrder[i] = i;
+
+            std::stable_sort(
+                bucketOrder.begin(), bucketOrder.end(),
+                [&buckets](std::size_t lhs, std::size_t rhs) { return (buckets[lhs].size() > buckets[rhs].size()); }
+            );
+
+            slots_.resize(numEntries + numEntries / 4 + 1, ~std::size_t(0));
+            seeds_.resize(buckets.size(), 0);
+
+            std::vector<std::size_t> bucketSlots;
+
+            for (auto bucketIndex : bucketOrder)
+            {
+                const auto& bucket = buckets[bucketIndex];
+                if (bucket.empty())
+                    break;
+
+                for (std::uint32_t seed = 1;; ++seed)
+                {
+                    /* Check if all keys of this bucket map to free and distinct slots */
+                    bucketSlots.clear();
+
+                    for (auto i : bucket)
+                    {
+                        const auto slot = Slot(hashes[i], seed);
+                        if (slots_[slot] != ~std::size_t(0) || std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end())
+                            break;
+                        bucketSlots.push_back(slot);
+                    }
+
+                    if (bucketSlots.size() == bucket.size())
+                    {
+                        for (std::size_t j = 0; j < bucket.size(); ++j)
+                            slots_[bucketSlots[j]] = bucket[j];
+                        seeds_[bucketIndex] = seed;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<value_type>     entries_;
+        std::vector<std::size_t>    slots_;     // Entry index for each slot (or ~0 for empty slots).
+        std::vector<std::uint32_t>  seeds_;     // Displacement seed for each bucket (or 0 for empty buckets).
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,60 @@
+/*
+ * UnixFileStatus.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryStream.h"
+#include <sys/stat.h>
+#include <dirent.h>
+
+
+namespace Xsc
+{
+
+
+bool QueryFileStatus(const std::string& filename, std::uint64_t& modificationTime, std::uint64_t& size)
+{
+    /* Only regular files can be included */
+    struct stat fileStat;
+    if (stat(filename.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        return false;
+
+    /* Use modification time with nanoseconds, to detect modifications within the same second */
+    #if defined __APPLE__
+    const auto& mtime = fileStat.st_mtimespec;
+    #else
+    const auto& mtime = fileStat.st_mtim;
+    #endif
+
+    modificationTime    = static_cast<std::uint64_t>(mtime.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(mtime.tv_nsec);
+    size                = static_cast<std::uint64_t>(fileStat.st_size);
+
+    return true;
+}
+
+bool ListDirectoryEntries(const std::string& path, std::vector<std::string>& names)
+{
+    auto dir = opendir(path.empty() ? "." : path.c_str());
+    if (!dir)
+        return false;
+
+    while (auto entry = readdir(dir))
+    {
+        const std::string name = entry->d_name;
+        if (name != "." && name != "..")
+            names.push_back(name);
+    }
+
+    closedir(dir);
+
+    return true;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,62 @@
+/*
+ * Win32FileStatus.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "MemoryStream.h"
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+
+namespace Xsc
+{
+
+
+bool QueryFileStatus(const std::string& filename, std::uint64_t& modificationTime, std::uint64_t& size)
+{
+    /* Query file attributes without opening the file (directories can not be included) */
+    WIN32_FILE_ATTRIBUTE_DATA fileAttribs;
+    if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &fileAttribs))
+        return false;
+
+    if ((fileAttribs.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0)
+        return false;
+
+    modificationTime    = (static_cast<std::uint64_t>(fileAttribs.ftLastWriteTime.dwHighDateTime) << 32) | fileAttribs.ftLastWriteTime.dwLowDateTime;
+    size                = (static_cast<std::uint64_t>(fileAttribs.nFileSizeHigh) << 32) | fileAttribs.nFileSizeLow;
+
+    return true;
+}
+
+bool ListDirectoryEntries(const std::string& path, std::vector<std::string>& names)
+{
+    const auto pattern = (path.empty() ? std::string(".") : path) + "\\*";
+
+    WIN32_FIND_DATAA findData;
+    auto findHandle = FindFirstFileA(pattern.c_str(), &findData);
+    if (findHandle == INVALID_HANDLE_VALUE)
+        return false;
+
+    do
+    {
+        const std::string name = findData.cFileName;
+        if (name != "." && name != "..")
+            names.push_back(name);
+    }
+    while (FindNextFileA(findHandle, &findData));
+
+    FindClose(findHandle);
+
+    return true;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,263 @@
+/*
+ * PrecompiledHeader.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/PrecompiledHeader.h>
+#include <Xsc/Xsc.h>
+#include "PrecompiledHeaderData.h"
+#include "PreProcessor.h"
+#include "GLSLPreProcessor.h"
+#include "BinaryStream.h"
+#include "SourceCode.h"
+#include "Helper.h"
+#include "Atom.h"
+#include <fstream>
+#include <sstream>
+#include <iterator>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal members
+ */
+
+// Identifies a precompiled header file; must be increased whenever the file format changes.
+static const char*          g_pchMagic          = "XSCPCH";
+static const std::uint32_t  g_pchFormatVersion  = 2;
+
+static void WritePrecompiledHeader(BinaryWriter& writer, const PrecompiledHeaderData& pch)
+{
+    writer.WriteString(pch.headerName);
+    writer.WriteUInt64(pch.headerSize);
+    writer.WriteUInt64(pch.headerHash);
+    writer.WriteInt(pch.shaderVersion);
+    writer.WriteBool(pch.writeLineMarks);
+    writer.WriteBool(pch.writeLineMarkFilenames);
+    writer.WriteUInt64(pch.macroStateHash);
+
+    writer.WriteList(
+        pch.dependencies,
+        [&writer](const PrecompiledHeaderData::Dependency& dependency)
+        {
+            writer.WriteString(dependency.filename);
+            writer.WriteBool(dependency.useSearchPaths);
+            writer.WriteUInt64(dependency.size);
+            writer.WriteUInt64(dependency.hash);
+        }
+    );
+
+    writer.WriteList(
+        pch.macros,
+        [&writer](const PrecompiledHeaderData::Macro& macro)
+        {
+            writer.WriteString(macro.ident);
+            writer.WriteList(macro.parameters, [&writer](const std::string& param) { writer.WriteString(param); });
+            writer.WriteList(
+                macro.tokens,
+                [&writer](const PrecompiledHeaderData::MacroToken& tkn)
+                {
+                    writer.WriteInt(tkn.type);
+                    writer.WriteString(tkn.spell);
+                }
+            );
+            writer.WriteBool(macro.varArgs);
+            writer.WriteBool(macro.stdMacro);
+            writer.WriteBool(macro.emptyParamList);
+        }
+    );
+
+    writer.WriteList(pch.onceIncluded, [&writer](const std::string& filename) { writer.WriteString(filename); });
+
+    writer.WriteList(
+        pch.includeGuards,
+        [&writer](const PrecompiledHeaderData::IncludeGuard& includeGuard)
+        {
+            writer.WriteString(includeGuard.filename);
+            writer.WriteString(includeGuard.ident);
+        }
+    );
+
+    writer.WriteString(pch.processedCode);
+}
+
+static void ReadPrecompiledHeader(BinaryReader& reader, PrecompiledHeaderData& pch)
+{
+    pch.headerName              = reader.ReadString();
+    pch.headerSize              = reader.ReadUInt64();
+    pch.headerHash              = reader.ReadUInt64();
+    pch.shaderVersion           = reader.ReadInt();
+    pch.writeLineMarks          = reader.ReadBool();
+    pch.writeLineMarkFilenames  = reader.ReadBool();
+    pch.macroStateHash          = reader.ReadUInt64();
+
+    reader.ReadList(
+        pch.dependencies,
+        [&reader](PrecompiledHeaderData::Dependency& dependency)
+        {
+            dependency.filename         = reader.ReadString();
+            dependency.useSearchPaths   = reader.ReadBool();
+            dependency.size             = reader.ReadUInt64();
+            dependency.hash             = reader.ReadUInt64();
+        }
+    );
+
+    reader.ReadList(
+        pch.macros,
+        [&reader](PrecompiledHeaderData::Macro& macro)
+        {
+            macro.ident = reader.ReadString();
+            reader.ReadList(macro.parameters, [&reader](std::string& param) { param = reader.ReadString(); });
+            reader.ReadList(
+                macro.tokens,
+                [&reader](PrecompiledHeaderData::MacroToken& tkn)
+                {
+                    tkn.type    = reader.ReadInt();
+                    tkn.spell   = reader.ReadString();
+                }
+            );
+            macro.varArgs           = reader.ReadBool();
+            macro.stdMacro          = reader.ReadBool();
+            macro.emptyParamList    = reader.ReadBool();
+        }
+    );
+
+    reader.ReadList(pch.onceIncluded, [&reader](std::string& filename) { filename = reader.ReadString(); });
+
+    reader.ReadList(
+        pch.includeGuards,
+        [&reader](PrecompiledHeaderData::IncludeGuard& includeGuard)
+        {
+            includeGuard.filename   = reader.ReadString();
+            includeGuard.ident      = reader.ReadString();
+        }
+    );
+
+    pch.processedCode = reader.ReadString();
+}
+
+
+/*
+ * PrecompiledHeader class
+ */
+
+PrecompiledHeader::PrecompiledHeader() :
+    data_ { new OpaqueData() }
+{
+}
+
+PrecompiledHeader::~PrecompiledHeader()
+{
+    delete data_;
+}
+
+bool PrecompiledHeader::Create(const ShaderInput& inputDesc, Log* log)
+{
+    data_->valid = false;
+
+    if (!inputDesc.sourceCode || inputDesc.filename.empty())
+        return false;
+
+    /* Read entire header file to validate it later */
+    const auto headerContent = std::string(std::istreambuf_iterator<char>(*inputDesc.sourceCode), std::istreambuf_iterator<char>());
+
+    auto& pch = data_->header;
+    {
+        pch.headerSize      = headerContent.size();
+        pch.headerHash      = HashFNV1a64(headerContent);
+        pch.shaderVersion   = static_cast<int>(inputDesc.shaderVersion);
+    }
+
+    /* Pre-process header file with the same line marks as for the compilation of a shader, and with its own atom table */
+    AtomTable atomTable;
+    AtomTableScope atomTableScope(atomTable);
+
+    IncludeHandler stdIncludeHandler;
+    auto includeHandler = (inputDesc.includeHandler != nullptr ? inputDesc.includeHandler : &stdIncludeHandler);
+
+    std::unique_ptr<PreProcessor> preProcessor;
+
+    if (IsLanguageHLSL(inputDesc.shaderVersion))
+        preProcessor = MakeUnique<PreProcessor>(*includeHandler, log);
+    else if (IsLanguageGLSL(inputDesc.shaderVersion))
+        preProcessor = MakeUnique<GLSLPreProcessor>(*includeHandler, log);
+    else
+        return false;
+
+    data_->valid = preProcessor->ProcessPrecompiledHeader(
+        std::make_shared<SourceCode>(headerContent.data(), headerContent.size()),
+        inputDesc.filename,
+        true,
+        true,
+        ((inputDesc.warnings & Warnings::PreProcessor) != 0),
+        inputDesc.predefinedMacros,
+        pch
+    );
+
+    return data_->valid;
+}
+
+bool PrecompiledHeader::Load(const std::string& filename)
+{
+    data_->valid = false;
+
+    std::ifstream file(filename, std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    const auto data = std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    /* Read file header */
+    BinaryReader reader(data);
+
+    if (reader.ReadString() != g_pchMagic || reader.ReadUInt() != g_pchFormatVersion)
+        return false;
+
+    /* Read pre-processor state */
+    ReadPrecompiledHeader(reader, data_->header);
+
+    data_->valid = reader.Finished();
+    return data_->valid;
+}
+
+bool PrecompiledHeader::Save(const std::string& filename) const
+{
+    if (!data_->valid)
+        return false;
+
+    BinaryWriter writer;
+    {
+        writer.WriteString(g_pchMagic);
+        writer.WriteUInt(g_pchFormatVersion);
+        WritePrecompiledHeader(writer, data_->header);
+    }
+
+    std::ofstream file(filename, std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    file.write(writer.Data().data(), static_cast<std::streamsize>(writer.Data().size()));
+    return file.good();
+}
+
+bool PrecompiledHeader::IsValid() const
+{
+    return data_->valid;
+}
+
+const std::string& PrecompiledHeader::GetHeaderName() const
+{
+    return data_->header.headerName;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,108 @@
+/*
+ * PrecompiledHeaderData.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_PRECOMPILED_HEADER_DATA_H
+#define XSC_PRECOMPILED_HEADER_DATA_H
+
+
+#include <Xsc/PrecompiledHeader.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+// Returns the 64-bit FNV-1a hash of the specified string.
+inline std::uint64_t HashFNV1a64(const std::string& s)
+{
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (auto chr : s)
+    {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+// Pre-processor state of a precompiled header (see PrecompiledHeader).
+struct PrecompiledHeaderData
+{
+    // File that was included by the header, to validate the precompiled header.
+    struct Dependency
+    {
+        std::string                 filename;
+        bool                        useSearchPaths  = false;
+        std::uint64_t               size            = 0;
+        std::uint64_t               hash            = 0;
+    };
+
+    struct MacroToken
+    {
+        MacroToken() = default;
+
+        inline MacroToken(int type, const std::string& spell) :
+            type  { type  },
+            spell { spell }
+        {
+        }
+
+        int                         type            = 0;    // Token type (see Token::Types)
+        std::string                 spell;
+    };
+
+    // Include guard of the header or a file it includes, so the file can be skipped after the precompiled header has been used.
+    struct IncludeGuard
+    {
+        std::string                 filename;
+        std::string                 ident;
+    };
+
+    // Macro definition after the header has been pre-processed.
+    struct Macro
+    {
+        std::string                 ident;
+        std::vector<std::string>    parameters;
+        std::vector<MacroToken>     tokens;
+        bool                        varArgs         = false;
+        bool                        stdMacro        = false;
+        bool                        emptyParamList  = false;
+    };
+
+    std::string                     headerName;                     // Filename, with which the header is included
+    std::uint64_t                   headerSize              = 0;
+    std::uint64_t                   headerHash              = 0;
+    int                             shaderVersion           = 0;    // Input shader version (see InputShaderVersion)
+    bool                            writeLineMarks          = true;
+    bool                            writeLineMarkFilenames  = true;
+    std::uint64_t                   macroStateHash          = 0;    // Hash of the macros before the header is pre-processed
+    std::vector<Dependency>         dependencies;
+    std::vector<Macro>              macros;
+    std::vector<std::string>        onceIncluded;
+    std::vector<IncludeGuard>       includeGuards;
+    std::string                     processedCode;                  // Pre-processed source code of the header
+};
+
+struct PrecompiledHeader::OpaqueData
+{
+    PrecompiledHeaderData   header;
+    bool                    valid   = false;
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -224,6 +224,7 @@ DECL_REPORT( UnexpectedEndOfTokenString,        "unexpected end of token string"
 DECL_REPORT( RemainingTokensInPragma,           "remaining unhandled tokens in '#pragma'-directive"                                                             );
 DECL_REPORT( EmptyPragma,                       "empty '#pragma'-directive"                                                                                     );
 DECL_REPORT( TooManyRecursiveIncludesOfFile,    "too many recursive includes of file[: \"{0}\"]"                                                                          );
+DECL_REPORT( PrecompiledHeaderOutdated,        "precompiled header is outdated and will be ignored[: \"{0}\"]"                                                  );
 
 /* ----- VisitorTracker ----- */
 
@@ -518,6 +519,7 @@ DECL_REPORT( GeneratingOutputCodeFailed,        "generating output code failed"
 DECL_REPORT( GLSLFrontendIsIncomplete,          "GLSL frontend is incomplete"                                                                                   );
 DECL_REPORT( InvalidILForDisassembling,         "invalid intermediate language for disassembling"                                                               );
 DECL_REPORT( NotBuildWithSPIRV,                 "compiler was not build with SPIR-V"                                                                            );
+DECL_REPORT( PermutationMacroWithoutVariants,   "permutation macro has no variants[: '{0}']"                                                                    );
 
 /* ----- Shell ----- */
 
@@ -534,6 +536,11 @@ DECL_REPORT( ValidationFailed,                  "validation failed"
 DECL_REPORT( CompileShader,                     "compile \"{0}\" to \"{1}\""                                                                                    );
 DECL_REPORT( CompilationSuccessful,             "compilation successful"                                                                                        );
 DECL_REPORT( CompilationFailed,                 "compilation failed"                                                                                            );
+DECL_REPORT( LoadedFromShaderCache,             "loaded from shader cache"                                                                                      );
+DECL_REPORT( PrecompileHeader,                 "precompile \"{0}\" to \"{1}\""                                                                                  );
+DECL_REPORT( FailedToLoadPrecompiledHeader,    "failed to load precompiled header: \"{0}\""                                                                     );
+DECL_REPORT( CompiledPermutations,              "compiled {0} permutation(s) into {1} unique shader(s)"                                                         );
+DECL_REPORT( PermutationOutput,                 "permutation [{0}] -> \"{1}\""                                                                                  );
 
 /* ----- Commands ----- */
 
@@ -574,6 +581,7 @@ DECL_REPORT( CmdHelpOptimize,                   "Enables/disables optimization;
 DECL_REPORT( CmdHelpExtension,                  "Enables/disables shader extension output; default={0}"                                                         );
 DECL_REPORT( CmdHelpEnumExtension,              "Enumerates all supported GLSL extensions"                                                                      );
 DECL_REPORT( CmdHelpValidate,                   "Enables/disables to only validate source code; default={0}"                                                    );
+DECL_REPORT( CmdHelpValidateAll,                "Enables/disables validation of functions unreachable from the entry point; default={0}"                        );
 DECL_REPORT( CmdHelpBinding,                    "Enables/disables explicit binding slots; default={0}"                                                          );
 DECL_REPORT( CmdHelpAutoBinding,                "Enables/disables automatic binding slot generation (implies -EB); default={0}"                                 );
 DECL_REPORT( CmdHelpAutoBindingStartSlot,       "Sets the start slot index for automatic binding slot generation; default=0"                                    );
@@ -582,6 +590,8 @@ DECL_REPORT( CmdHelpWrapper,                    "Enables/disables the preference
 DECL_REPORT( CmdHelpUnrollInitializer,          "Enables/disables unrolling of array initializers; default={0}"                                                 );
 DECL_REPORT( CmdHelpObfuscate,                  "Enables/disables code obfuscation; default={0}"                                                                );
 DECL_REPORT( CmdHelpRowMajorAlignment,          "Enables/disables row major packing alignment for matrices; default={0}"                                        );
+DECL_REPORT( CmdHelpLazyBodies,                 "Enables/disables parsing of only those function bodies reachable from the entry point; default={0}"            );
+DECL_REPORT( CmdHelpPrefetchIncludes,           "Enables/disables loading of included files on background threads during pre-processing; default={0}"           );
 DECL_REPORT( CmdHelpFormatting,                 "Enables/disables the specified formatting option; valid types:"                                                );
 DECL_REPORT( CmdHelpDetailsFormatting,          "blanks        => blank lines between declarations; default={1}\n"  \
                                                 "force-braces  => force braces for scopes; default={0}\n"           \
@@ -603,6 +613,10 @@ DECL_REPORT( CmdHelpSeparateShaders,            "Ensures compatibility to 'ARB_s
 DECL_REPORT( CmdHelpSeparateSamplers,           "Enables/disables generation of separate sampler state objects; default={0}"                                    );
 DECL_REPORT( CmdHelpDisassemble,                "Disassembles the SPIR-V module"                                                                                );
 DECL_REPORT( CmdHelpDisassembleExt,             "Disassembles the SPIR-V module with extended ID numbers"                                                       );
+DECL_REPORT( CmdHelpPermute,                    "Compiles the permutations of macro <IDENT> with each VALUE (or undefined and defined without VALUE)"             );
+DECL_REPORT( CmdHelpCache,                      "Loads unchanged shaders from the shader cache in DIR (use '-' to disable)"                                     );
+DECL_REPORT( CmdHelpPCHCreate,                 "Precompiles the next input file as header (included by its filename) to FILE, instead of compiling it"          );
+DECL_REPORT( CmdHelpPCHUse,                    "Uses the precompiled header in FILE for the inclusion of its header (use '-' to disable)"                       );
 DECL_REPORT( InvalidShaderTarget,               "invalid shader target[: '{0}']"                                                                                );
 DECL_REPORT( InvalidShaderVersionIn,            "invalid input shader version[: '{0}']"                                                                         );
 DECL_REPORT( InvalidShaderVersionOut,           "invalid output shader version[: '{0}']"                                                                        );
@@ -0,0 +1,461 @@
+/*
+ * ShaderCache.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/ShaderCache.h>
+#include "MemoryStream.h"
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <mutex>
+#include <map>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+
+#ifdef _WIN32
+#   include <direct.h>
+#else
+#   include <sys/stat.h>
+#endif
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal functions
+ */
+
+static const char* g_indexFilename = "xsc_cache.idx";
+
+// Number of index changes after which the index is written to disk (besides in the destructor).
+static const std::size_t g_indexWriteInterval = 256;
+
+// Returns the 64-bit FNV-1a hash of the specified string with the specified offset basis.
+static std::uint64_t HashFNV1a(const std::string& s, std::uint64_t offsetBasis)
+{
+    auto hash = offsetBasis;
+
+    for (auto chr : s)
+    {
+        hash ^= static_cast<unsigned char>(chr);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+// Returns the filename of the cache entry for the specified key (128-bit hash as hex string).
+static std::string EntryName(const std::string& key)
+{
+    std::stringstream s;
+    s << std::hex;
+
+    for (auto offsetBasis : { 0xcbf29ce484222325ull, 0x84222325cbf29ce4ull })
+    {
+        s.width(16);
+        s.fill('0');
+        s << HashFNV1a(key, offsetBasis);
+    }
+
+    return s.str();
+}
+
+// Returns true if the specified filename has the form of a cache entry name (see EntryName).
+static bool IsEntryName(const std::string& filename)
+{
+    return
+    (
+        filename.size() == 32 &&
+        std::all_of(
+            filename.begin(), filename.end(),
+            [](char chr)
+            {
+                return ((chr >= '0' && chr <= '9') || (chr >= 'a' && chr <= 'f'));
+            }
+        )
+    );
+}
+
+static void MakeDirectory(const std::string& path)
+{
+    #ifdef _WIN32
+    _mkdir(path.c_str());
+    #else
+    mkdir(path.c_str(), 0755);
+    #endif
+}
+
+
+/*
+ * OpaqueData structure
+ */
+
+struct ShaderCache::OpaqueData
+{
+    // Index entry of a single cache entry file.
+    struct Entry
+    {
+        std::size_t                         size    = 0;
+        std::list<std::string>::iterator    lruPos;         // Position in the LRU list
+    };
+
+    // Returns the full path of the specified file within the cache directory.
+    std::string FilePath(const std::string& filename) const;
+
+    void ReadIndex();
+    void WriteIndex();
+
+    /*
+    Synchronizes the index with the entry files in the cache directory, e.g. after a process was terminated before it wrote the index.
+    Unknown entry files are adopted as least recently used entries, and entries without a file are removed from the index.
+    */
+    void ReconcileIndex();
+
+    // Writes the index if enough changes have been made since it was written the last time.
+    void WriteIndexInterval();
+
+    // Inserts or updates the index entry, and marks it as the most recently used.
+    void UpdateEntry(const std::string& name, std::size_t size);
+
+    // Removes the specified entry from the index and from disk.
+    void RemoveEntry(std::map<std::string, Entry>::iterator it);
+
+    // Removes the least recently used entries until the total size is within the size limit.
+    void EvictEntries();
+
+    std::string                     directory;
+    std::size_t                     maxSize         = 0;
+
+    mutable std::mutex              mutex;
+
+    std::map<std::string, Entry>    entries;
+    std::list<std::string>          lruList;                // Entry names from least to most recently used
+    std::size_t                     totalSize       = 0;
+    std::size_t                     indexChanges    = 0;    // Number of index changes since it was written
+
+    ShaderCacheStatistics           statistics;
+};
+
+std::string ShaderCache::OpaqueData::FilePath(const std::string& filename) const
+{
+    if (directory.empty())
+        return filename;
+    if (directory.back() == '/' || directory.back() == '\\')
+        return directory + filename;
+    return directory + "/" + filename;
+}
+
+void ShaderCache::OpaqueData::ReadIndex()
+{
+    std::ifstream file(FilePath(g_indexFilename));
+
+    /* Read index entries line by line: "<NAME> <SIZE> <LAST-USE>" */
+    struct IndexEntry
+    {
+        std::string     name;
+        std::size_t     size;
+        std::uint64_t   lastUse;
+    };
+
+    std::vector<IndexEntry> indexEntries;
+    IndexEntry indexEntry;
+
+    while (file >> indexEntry.name >> indexEntry.size >> indexEntry.lastUse)
+        indexEntries.push_back(indexEntry);
+
+    /* Insert entries from least to most recently used */
+    std::stable_sort(
+        indexEntries.begin(), indexEntries.end(),
+        [](const IndexEntry& lhs, const IndexEntry& rhs)
+        {
+            return (lhs.lastUse < rhs.lastUse);
+        }
+    );
+
+    for (const auto& entry : indexEntries)
+        UpdateEntry(entry.name, entry.size);
+
+    indexChanges = 0;
+}
+
+void ShaderCache::OpaqueData::WriteIndex()
+{
+    std::ofstream file(FilePath(g_indexFilename));
+
+    /* Write entries from least to most recently used, so the position in the LRU list is the last use */
+    std::uint64_t lastUse = 0;
+
+    for (const auto& name : lruList)
+        file << name << ' ' << entries[name].size << ' ' << (++lastUse) << '\n';
+
+    indexChanges = 0;
+}
+
+void ShaderCache::OpaqueData::ReconcileIndex()
+{
+    std::vector<std::string> filenames;
+    if (!ListDirectoryEntries(directory, filenames))
+        return;
+
+    struct UnknownEntry
+    {
+        std::string     name;
+        std::size_t     size;
+        std::uint64_t   modificationTime;
+    };
+
+    std::vector<UnknownEntry> unknownEntries;
+    std::map<std::string, Entry> foundEntries;
+
+    for (const auto& name : filenames)
+    {
+        std::uint64_t modificationTime = 0, size = 0;
+        if (!IsEntryName(name) || !QueryFileStatus(FilePath(name), modificationTime, size))
+            continue;
+
+        auto it = entries.find(name);
+        if (it != entries.end())
+        {
+            /* Take over actual file size of known entry */
+            totalSize -= it->second.size;
+            totalSize += static_cast<std::size_t>(size);
+            if (it->second.size != static_cast<std::size_t>(size))
+            {
+                it->second.size = static_cast<std::size_t>(size);
+                ++indexChanges;
+            }
+            foundEntries.insert(*it);
+            entries.erase(it);
+        }
+        else
+            unknownEntries.push_back({ name, static_cast<std::size_t>(size), modificationTime });
+    }
+
+    /* Remove remaining entries from the index, whose files no longer exist */
+    for (const auto& it : entries)
+    {
+        totalSize -= it.second.size;
+        lruList.erase(it.second.lruPos);
+        ++indexChanges;
+    }
+
+    entries = std::move(foundEntries);
+
+    /* Adopt unknown entry files before all known entries, from the oldest to the newest file */
+    std::sort(
+        unknownEntries.begin(), unknownEntries.end(),
+        [](const UnknownEntry& lhs, const UnknownEntry& rhs)
+        {
+            return (lhs.modificationTime < rhs.modificationTime);
+        }
+    );
+
+    auto lruPos = lruList.begin();
+
+    for (const auto& unknownEntry : unknownEntries)
+    {
+        auto& entry = entries[unknownEntry.name];
+        entry.size      = unknownEntry.size;
+        entry.lruPos    = lruList.insert(lruPos, unknownEntry.name);
+        totalSize += unknownEntry.size;
+        ++indexChanges;
+    }
+}
+
+void ShaderCache::OpaqueData::WriteIndexInterval()
+{
+    if (indexChanges >= g_indexWriteInterval)
+        WriteIndex();
+}
+
+void ShaderCache::OpaqueData::UpdateEntry(const std::string& name, std::size_t size)
+{
+    auto it = entries.find(name);
+
+    if (it == entries.end())
+    {
+        /* Insert new entry as the most recently used */
+        it = entries.insert({ name, Entry() }).first;
+        it->second.lruPos = lruList.insert(lruList.end(), name);
+    }
+    else
+    {
+        /* Move entry to the end of the LRU list */
+        lruList.splice(lruList.end(), lruList, it->second.lruPos);
+    }
+
+    auto& entry = it->second;
+
+    totalSize -= entry.size;
+    totalSize += size;
+
+    entry.size = size;
+
+    ++indexChanges;
+}
+
+void ShaderCache::OpaqueData::RemoveEntry(std::map<std::string, Entry>::iterator it)
+{
+    std::remove(FilePath(it->first).c_str());
+    totalSize -= it->second.size;
+    lruList.erase(it->second.lruPos);
+    entries.erase(it);
+    ++indexChanges;
+}
+
+void ShaderCache::OpaqueData::EvictEntries()
+{
+    while (totalSize > maxSize && !lruList.empty())
+    {
+        /* Remove least recently used entry */
+        RemoveEntry(entries.find(lruList.front()));
+        ++statistics.evictions;
+    }
+}
+
+
+/*
+ * ShaderCache class
+ */
+
+ShaderCache::ShaderCache(const std::string& directory, std::size_t maxSize) :
+    data_ { new OpaqueData() }
+{
+    data_->directory    = directory;
+    data_->maxSize      = maxSize;
+
+    if (!directory.empty())
+        MakeDirectory(directory);
+
+    data_->ReadIndex();
+    data_->ReconcileIndex();
+    data_->EvictEntries();
+}
+
+ShaderCache::~ShaderCache()
+{
+    if (data_->indexChanges > 0)
+        data_->WriteIndex();
+    delete data_;
+}
+
+bool ShaderCache::Load(const std::string& key, std::string& data)
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+
+    /* Read entry file, which starts with the length of the key and the key itself */
+    const auto name = EntryName(key);
+
+    std::ifstream file(data_->FilePath(name), std::ios::binary);
+    if (file.good())
+    {
+        /* Determine remaining file size to validate the key length of a truncated or corrupted entry */
+        const auto fileStart = file.tellg();
+        file.seekg(0, std::ios::end);
+        const auto fileSize = file.tellg();
+        file.seekg(fileStart);
+
+        std::size_t keyLength = 0;
+        if (file >> keyLength && file.get() == '\n' && keyLength == key.size() &&
+            file.tellg() >= 0 && static_cast<std::uint64_t>(fileSize - file.tellg()) >= keyLength)
+        {
+            std::string entryKey(keyLength, '\0');
+            if (file.read(&entryKey[0], static_cast<std::streamsize>(keyLength)) && entryKey == key)
+            {
+                data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+                data_->UpdateEntry(name, std::to_string(keyLength).size() + 1 + keyLength + data.size());
+                ++data_->statistics.hits;
+                return true;
+            }
+        }
+    }
+
+    ++data_->statistics.misses;
+    return false;
+}
+
+void ShaderCache::Store(const std::string& key, const std::string& data)
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+
+    /* Write entry file with its key for verification */
+    const auto name = EntryName(key);
+    const auto header = std::to_string(key.size()) + "\n";
+
+    const auto path = data_->FilePath(name);
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.good())
+            return;
+
+        file << header << key << data;
+        file.close();
+
+        if (file.fail())
+        {
+            /* Remove incomplete entry file, and its previous index entry */
+            auto it = data_->entries.find(name);
+            if (it != data_->entries.end())
+                data_->RemoveEntry(it);
+            else
+                std::remove(path.c_str());
+            return;
+        }
+    }
+
+    data_->UpdateEntry(name, header.size() + key.size() + data.size());
+    ++data_->statistics.stores;
+
+    /* Keep cache within its size limit, and write index in batches */
+    data_->EvictEntries();
+    data_->WriteIndexInterval();
+}
+
+void ShaderCache::Clear()
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+
+    while (!data_->entries.empty())
+        data_->RemoveEntry(data_->entries.begin());
+
+    data_->WriteIndex();
+}
+
+ShaderCacheStatistics ShaderCache::GetStatistics() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->statistics;
+}
+
+void ShaderCache::ResetStatistics()
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    data_->statistics = ShaderCacheStatistics();
+}
+
+std::size_t ShaderCache::GetSize() const
+{
+    std::lock_guard<std::mutex> guard { data_->mutex };
+    return data_->totalSize;
+}
+
+const std::string& ShaderCache::GetDirectory() const
+{
+    return data_->directory;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,430 @@
+/*
+ * ShaderCacheEntry.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ShaderCacheEntry.h"
+#include "BinaryStream.h"
+#include <sstream>
+#include <cstdint>
+
+
+namespace Xsc
+{
+
+
+/*
+ * Internal members
+ */
+
+// Version of the shader cache entry format. Must be incremented whenever the format changes.
+static const std::uint32_t g_entryFormatVersion = 1;
+
+
+/*
+ * Reflection serialization
+ */
+
+static void WriteField(BinaryWriter& writer, const Reflection::Field& field)
+{
+    writer.WriteBool(field.referenced);
+    writer.WriteString(field.name);
+    writer.WriteEnum(field.type);
+    writer.WriteUInt(field.dimensions[0]);
+    writer.WriteUInt(field.dimensions[1]);
+    writer.WriteInt(field.typeRecordIndex);
+    writer.WriteUInt(field.size);
+    writer.WriteUInt(field.offset);
+    writer.WriteList(field.arrayElements, [&](unsigned int n) { writer.WriteUInt(n); });
+}
+
+static void ReadField(BinaryReader& reader, Reflection::Field& field)
+{
+    field.referenced        = reader.ReadBool();
+    field.name              = reader.ReadString();
+    field.type              = reader.ReadEnum<Reflection::FieldType>();
+    field.dimensions[0]     = reader.ReadUInt();
+    field.dimensions[1]     = reader.ReadUInt();
+    field.typeRecordIndex   = reader.ReadInt();
+    field.size              = reader.ReadUInt();
+    field.offset            = reader.ReadUInt();
+    reader.ReadList(field.arrayElements, [&](unsigned int& n) { n = reader.ReadUInt(); });
+}
+
+static void WriteAttribute(BinaryWriter& writer, const Reflection::Attribute& attrib)
+{
+    writer.WriteBool(attrib.referenced);
+    writer.WriteString(attrib.name);
+    writer.WriteInt(attrib.slot);
+}
+
+static void ReadAttribute(BinaryReader& reader, Reflection::Attribute& attrib)
+{
+    attrib.referenced   = reader.ReadBool();
+    attrib.name         = reader.ReadString();
+    attrib.slot         = reader.ReadInt();
+}
+
+static void WriteReflection(BinaryWriter& writer, const Reflection::ReflectionData& data)
+{
+    auto WriteFieldFunc     = [&](const Reflection::Field& field) { WriteField(writer, field); };
+    auto WriteAttributeFunc = [&](const Reflection::Attribute& attrib) { WriteAttribute(writer, attrib); };
+
+    writer.WriteList(data.macros, [&](const std::string& macro) { writer.WriteString(macro); });
+
+    writer.WriteList(
+        data.records,
+        [&](const Reflection::Record& record)
+        {
+            writer.WriteBool(record.referenced);
+            writer.WriteString(record.name);
+            writer.WriteInt(record.baseRecordIndex);
+            writer.WriteList(record.fields, WriteFieldFunc);
+            writer.WriteUInt(record.size);
+            writer.WriteUInt(record.padding);
+        }
+    );
+
+    writer.WriteList(data.inputAttributes, WriteAttributeFunc);
+    writer.WriteList(data.outputAttributes, WriteAttributeFunc);
+    writer.WriteList(data.uniforms, WriteAttributeFunc);
+
+    writer.WriteList(
+        data.resources,
+        [&](const Reflection::Resource& resource)
+        {
+            writer.WriteBool(resource.referenced);
+            writer.WriteEnum(resource.type);
+            writer.WriteString(resource.name);
+            writer.WriteInt(resource.slot);
+        }
+    );
+
+    writer.WriteList(
+        data.constantBuffers,
+        [&](const Reflection::ConstantBuffer& buffer)
+        {
+            writer.WriteBool(buffer.referenced);
+            writer.WriteEnum(buffer.type);
+            writer.WriteString(buffer.name);
+            writer.WriteInt(buffer.slot);
+            writer.WriteList(buffer.fields, WriteFieldFunc);
+            writer.WriteUInt(buffer.size);
+            writer.WriteUInt(buffer.padding);
+        }
+    );
+
+    writer.WriteList(
+        data.samplerStates,
+        [&](const Reflection::SamplerState& sampler)
+        {
+            writer.WriteEnum(sampler.type);
+            writer.WriteString(sampler.name);
+            writer.WriteInt(sampler.slot);
+            writer.WriteBool(sampler.referenced);
+        }
+    );
+
+    writer.WriteList(
+        data.staticSamplerStates,
+        [&](const Reflection::StaticSamplerState& sampler)
+        {
+            const auto& desc = sampler.desc;
+            writer.WriteEnum(sampler.type);
+            writer.WriteString(sampler.name);
+            writer.WriteEnum(desc.filter);
+            writer.WriteEnum(desc.addressU);
+            writer.WriteEnum(desc.addressV);
+            writer.WriteEnum(desc.addressW);
+            writer.WriteFloat(desc.mipLODBias);
+            writer.WriteUInt(desc.maxAnisotropy);
+            writer.WriteEnum(desc.comparisonFunc);
+            for (auto color : desc.borderColor)
+                writer.WriteFloat(color);
+            writer.WriteFloat(desc.minLOD);
+            writer.WriteFloat(desc.maxLOD);
+        }
+    );
+
+    writer.WriteInt(data.numThreads.x);
+    writer.WriteInt(data.numThreads.y);
+    writer.WriteInt(data.numThreads.z);
+}
+
+static void ReadReflection(BinaryReader& reader, Reflection::ReflectionData& data)
+{
+    auto ReadFieldFunc      = [&](Reflection::Field& field) { ReadField(reader, field); };
+    auto ReadAttributeFunc  = [&](Reflection::Attribute& attrib) { ReadAttribute(reader, attrib); };
+
+    reader.ReadList(data.macros, [&](std::string& macro) { macro = reader.ReadString(); });
+
+    reader.ReadList(
+        data.records,
+        [&](Reflection::Record& record)
+        {
+            record.referenced       = reader.ReadBool();
+            record.name             = reader.ReadString();
+            record.baseRecordIndex  = reader.ReadInt();
+            reader.ReadList(record.fields, ReadFieldFunc);
+            record.size             = reader.ReadUInt();
+            record.padding          = reader.ReadUInt();
+        }
+    );
+
+    reader.ReadList(data.inputAttributes, ReadAttributeFunc);
+    reader.ReadList(data.outputAttributes, ReadAttributeFunc);
+    reader.ReadList(data.uniforms, ReadAttributeFunc);
+
+    reader.ReadList(
+        data.resources,
+        [&](Reflection::Resource& resource)
+        {
+            resource.referenced = reader.ReadBool();
+            resource.type       = reader.ReadEnum<Reflection::ResourceType>();
+            resource.name       = reader.ReadString();
+            resource.slot       = reader.ReadInt();
+        }
+    );
+
+    reader.ReadList(
+        data.constantBuffers,
+        [&](Reflection::ConstantBuffer& buffer)
+        {
+            buffer.referenced   = reader.ReadBool();
+            buffer.type         = reader.ReadEnum<Reflection::ResourceType>();
+            buffer.name         = reader.ReadString();
+            buffer.slot         = reader.ReadInt();
+            reader.ReadList(buffer.fields, ReadFieldFunc);
+            buffer.size         = reader.ReadUInt();
+            buffer.padding      = reader.ReadUInt();
+        }
+    );
+
+    reader.ReadList(
+        data.samplerStates,
+        [&](Reflection::SamplerState& sampler)
+        {
+            sampler.type        = reader.ReadEnum<Reflection::ResourceType>();
+            sampler.name        = reader.ReadString();
+            sampler.slot        = reader.ReadInt();
+            sampler.referenced  = reader.ReadBool();
+        }
+    );
+
+    reader.ReadList(
+        data.staticSamplerStates,
+        [&](Reflection::StaticSamplerState& sampler)
+        {
+            auto& desc = sampler.desc;
+            sampler.type        = reader.ReadEnum<Reflection::ResourceType>();
+            sampler.name        = reader.ReadString();
+            desc.filter         = reader.ReadEnum<Reflection::Filter>();
+            desc.addressU       = reader.ReadEnum<Reflection::TextureAddressMode>();
+            desc.addressV       = reader.ReadEnum<Reflection::TextureAddressMode>();
+            desc.addressW       = reader.ReadEnum<Reflection::TextureAddressMode>();
+            desc.mipLODBias     = reader.ReadFloat();
+            desc.maxAnisotropy  = reader.ReadUInt();
+            desc.comparisonFunc = reader.ReadEnum<Reflection::ComparisonFunc>();
+            for (auto& color : desc.borderColor)
+                color = reader.ReadFloat();
+            desc.minLOD         = reader.ReadFloat();
+            desc.maxLOD         = reader.ReadFloat();
+        }
+    );
+
+    data.numThreads.x = reader.ReadInt();
+    data.numThreads.y = reader.ReadInt();
+    data.numThreads.z = reader.ReadInt();
+}
+
+
+/*
+ * ShaderCacheLog class
+ */
+
+ShaderCacheLog::ShaderCacheLog(Log* log, std::vector<Report>& reports) :
+    log_     { log     },
+    reports_ { reports }
+{
+}
+
+void ShaderCacheLog::SubmitReport(const Report& report)
+{
+    reports_.push_back(report);
+    if (log_)
+        log_->SubmitReport(report);
+}
+
+
+/*
+ * Global functions
+ */
+
+bool IsShaderCacheable(const ShaderOutput& outputDesc)
+{
+    /* Pre-processing only and AST output are not covered by the cache */
+    return (!outputDesc.options.preprocessOnly && !outputDesc.options.showAST);
+}
+
+std::string MakeShaderCacheKey(
+    const ShaderInput&  inputDesc,
+    const ShaderOutput& outputDesc,
+    const std::string&  processedCode,
+    bool                withReflection)
+{
+    std::stringstream s;
+
+    auto WriteValue = [&s](const char* name, const std::string& value)
+    {
+        s << name << '=' << value.size() << ':' << value << '\n';
+    };
+
+    auto WriteNumber = [&WriteValue](const char* name, long long value)
+    {
+        WriteValue(name, std::to_string(value));
+    };
+
+    /* Compiler version and build configuration */
+    WriteValue  ( "version",                    XSC_VERSION_STRING                                              );
+    WriteNumber ( "format",                     g_entryFormatVersion                                            );
+
+    #ifdef XSC_ENABLE_LANGUAGE_EXT
+    WriteNumber ( "languageExt",                1                                                               );
+    #endif
+
+    /* Input descriptor */
+    WriteNumber ( "in.shaderVersion",           static_cast<long long>(inputDesc.shaderVersion)                 );
+    WriteNumber ( "in.shaderTarget",            static_cast<long long>(inputDesc.shaderTarget)                  );
+    WriteValue  ( "in.entryPoint",              inputDesc.entryPoint                                            );
+    WriteValue  ( "in.secondaryEntryPoint",     inputDesc.secondaryEntryPoint                                   );
+    WriteNumber ( "in.warnings",                inputDesc.warnings                                              );
+    WriteNumber ( "in.extensions",              inputDesc.extensions                                            );
+
+    /* Output descriptor */
+    WriteNumber ( "out.shaderVersion",          static_cast<long long>(outputDesc.shaderVersion)                );
+
+    for (const auto& vertexSemantic : outputDesc.vertexSemantics)
+    {
+        WriteValue  ( "out.vertexSemantic",     vertexSemantic.semantic                                         );
+        WriteNumber ( "out.vertexLocation",     vertexSemantic.location                                         );
+    }
+
+    const auto& packing = outputDesc.uniformPacking;
+    WriteNumber ( "out.packing.enabled",        packing.enabled                                                 );
+    WriteNumber ( "out.packing.bindingSlot",    packing.bindingSlot                                             );
+    WriteValue  ( "out.packing.bufferName",     packing.bufferName                                              );
+
+    const auto& options = outputDesc.options;
+    WriteNumber ( "out.allowExtensions",        options.allowExtensions                                         );
+    WriteNumber ( "out.autoBinding",            options.autoBinding                                             );
+    WriteNumber ( "out.autoBindingStartSlot",   options.autoBindingStartSlot                                    );
+    WriteNumber ( "out.explicitBinding",        options.explicitBinding                                         );
+    WriteNumber ( "out.lazyFunctionBodies",     options.lazyFunctionBodies                                      );
+    WriteNumber ( "out.obfuscate",              options.obfuscate                                               );
+    WriteNumber ( "out.optimize",               options.optimize                                                );
+    WriteNumber ( "out.preferWrappers",         options.preferWrappers                                          );
+    WriteNumber ( "out.preserveComments",       options.preserveComments                                        );
+    WriteNumber ( "out.rowMajorAlignment",      options.rowMajorAlignment                                       );
+    WriteNumber ( "out.separateSamplers",       options.separateSamplers                                        );
+    WriteNumber ( "out.separateShaders",        options.separateShaders                                         );
+    WriteNumber ( "out.unrollArrayInitializers",options.unrollArrayInitializers                                 );
+    WriteNumber ( "out.validateAll",            options.validateAll                                             );
+    WriteNumber ( "out.validateOnly",           options.validateOnly                                            );
+    WriteNumber ( "out.writeGeneratorHeader",   options.writeGeneratorHeader                                    );
+
+    const auto& formatting = outputDesc.formatting;
+    WriteNumber ( "out.alwaysBracedScopes",     formatting.alwaysBracedScopes                                   );
+    WriteNumber ( "out.blanks",                 formatting.blanks                                               );
+    WriteNumber ( "out.compactWrappers",        formatting.compactWrappers                                      );
+    WriteValue  ( "out.indent",                 formatting.indent                                               );
+    WriteNumber ( "out.lineMarks",              formatting.lineMarks                                            );
+    WriteNumber ( "out.lineSeparation",         formatting.lineSeparation                                       );
+    WriteNumber ( "out.newLineOpenScope",       formatting.newLineOpenScope                                     );
+
+    const auto& nameMangling = outputDesc.nameMangling;
+    WriteValue  ( "out.inputPrefix",            nameMangling.inputPrefix                                        );
+    WriteValue  ( "out.outputPrefix",           nameMangling.outputPrefix                                       );
+    WriteValue  ( "out.reservedWordPrefix",     nameMangling.reservedWordPrefix                                 );
+    WriteValue  ( "out.temporaryPrefix",        nameMangling.temporaryPrefix                                    );
+    WriteValue  ( "out.namespacePrefix",        nameMangling.namespacePrefix                                    );
+    WriteNumber ( "out.useAlwaysSemantics",     nameMangling.useAlwaysSemantics                                 );
+    WriteNumber ( "out.renameBufferFields",     nameMangling.renameBufferFields                                 );
+
+    WriteNumber ( "reflection",                 withReflection                                                  );
+
+    /* Pre-processed source code */
+    WriteValue  ( "source",                     processedCode                                                   );
+
+    return s.str();
+}
+
+std::string WriteShaderCacheEntry(const ShaderCacheEntry& entry)
+{
+    BinaryWriter writer;
+
+    writer.WriteUInt(g_entryFormatVersion);
+    writer.WriteString(entry.outputCode);
+
+    writer.WriteBool(entry.hasReflection);
+    if (entry.hasReflection)
+        WriteReflection(writer, entry.reflectionData);
+
+    writer.WriteList(
+        entry.reports,
+        [&](const Report& report)
+        {
+            writer.WriteEnum(report.Type());
+            writer.WriteString(report.Context());
+            writer.WriteString(report.Message());
+            writer.WriteString(report.Line());
+            writer.WriteString(report.Marker());
+            writer.WriteList(report.GetHints(), [&](const std::string& hint) { writer.WriteString(hint); });
+        }
+    );
+
+    return writer.Data();
+}
+
+bool ReadShaderCacheEntry(const std::string& data, ShaderCacheEntry& entry)
+{
+    BinaryReader reader(data);
+
+    if (reader.ReadUInt() != g_entryFormatVersion)
+        return false;
+
+    entry.outputCode = reader.ReadString();
+
+    entry.hasReflection = reader.ReadBool();
+    if (entry.hasReflection)
+        ReadReflection(reader, entry.reflectionData);
+
+    auto numReports = reader.ReadUInt();
+    entry.reports.clear();
+
+    for (std::uint32_t i = 0; i < numReports && reader.Valid(); ++i)
+    {
+        auto type       = reader.ReadEnum<ReportTypes>();
+        auto context    = reader.ReadString();
+        auto message    = reader.ReadString();
+        auto line       = reader.ReadString();
+        auto marker     = reader.ReadString();
+
+        std::vector<std::string> hints;
+        reader.ReadList(hints, [&](std::string& hint) { hint = reader.ReadString(); });
+
+        Report report(type, message, line, marker, context);
+        report.TakeHints(std::move(hints));
+        entry.reports.push_back(std::move(report));
+    }
+
+    return reader.Finished();
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,72 @@
+/*
+ * ShaderCacheEntry.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_SHADER_CACHE_ENTRY_H
+#define XSC_SHADER_CACHE_ENTRY_H
+
+
+#include <Xsc/Xsc.h>
+#include <string>
+#include <vector>
+
+
+namespace Xsc
+{
+
+
+// Compilation result which is stored in a shader cache entry.
+struct ShaderCacheEntry
+{
+    std::string                 outputCode;
+    bool                        hasReflection   = false;
+    Reflection::ReflectionData  reflectionData;
+    std::vector<Report>         reports;
+};
+
+// Log which records all reports for a shader cache entry, and forwards them to another log.
+class ShaderCacheLog final : public Log
+{
+
+    public:
+
+        ShaderCacheLog(Log* log, std::vector<Report>& reports);
+
+        void SubmitReport(const Report& report) override;
+
+    private:
+
+        Log*                    log_        = nullptr;
+        std::vector<Report>&    reports_;
+
+};
+
+// Returns true if the compilation with the specified output descriptor can be served from a shader cache.
+bool IsShaderCacheable(const ShaderOutput& outputDesc);
+
+// Returns the shader cache key of the pre-processed source code and all input/output options that affect the compilation result.
+std::string MakeShaderCacheKey(
+    const ShaderInput&  inputDesc,
+    const ShaderOutput& outputDesc,
+    const std::string&  processedCode,
+    bool                withReflection
+);
+
+// Writes the specified entry into binary data for the shader cache.
+std::string WriteShaderCacheEntry(const ShaderCacheEntry& entry);
+
+// Reads the specified entry from binary data of the shader cache. Returns false if the data is invalid.
+bool ReadShaderCacheEntry(const std::string& data, ShaderCacheEntry& entry);
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
@@ -6,7 +6,9 @@
  */
 
 #include "SourceCode.h"
+#include "MemoryStream.h"
 #include <algorithm>
+#include <cstring>
 
 
 namespace Xsc
@@ -16,15 +18,35 @@ namespace Xsc
 SourceCode::SourceCode(const std::shared_ptr<std::istream>& stream) :
     stream_ { stream }
 {
+    /* Read memory streams directly from their buffer */
+    if (auto memoryStream = dynamic_cast<const MemoryInputStream*>(stream.get()))
+    {
+        if (memoryStream->good())
+        {
+            buffer_     = memoryStream->Data();
+            bufferSize_ = memoryStream->Size();
+            BuildLineOffsets();
+        }
+    }
+}
+
+SourceCode::SourceCode(const char* data, std::size_t size) :
+    buffer_     { data },
+    bufferSize_ { size }
+{
+    BuildLineOffsets();
 }
 
 bool SourceCode::IsValid() const
 {
-    return (stream_ != nullptr && stream_->good());
+    return (buffer_ != nullptr || (stream_ != nullptr && stream_->good()));
 }
 
 char SourceCode::Next()
 {
+    if (buffer_)
+        return NextFromBuffer();
+
     /* Check if reader is at end-of-line */
     while (pos_.Column() >= currentLine_.size())
     {
@@ -98,7 +120,7 @@ bool SourceCode::FetchLineMarker(const SourceArea& area, std::string& line, std:
     if (area.Length() > 0)
     {
         auto row = area.Pos().Row();
-        if (row == pos_.Row())
+        if (row == pos_.Row() && !buffer_)
             return BuildLineMarker(area, Line(), line, marker);
         else if (row > 0)
             return BuildLineMarker(area, GetLine(static_cast<std::size_t>(row - 1)), line, marker);
@@ -131,9 +153,62 @@ std::string SourceCode::Filename() const
 
 std::string SourceCode::GetLine(std::size_t lineIndex) const
 {
+    if (buffer_)
+    {
+        /* Extract line from memory buffer (each line ends with a new-line character like for stream sources) */
+        if (lineIndex + 1 < lineOffsets_.size())
+        {
+            auto begin  = lineOffsets_[lineIndex];
+            auto end    = lineOffsets_[lineIndex + 1];
+            if (end > bufferSize_)
+                return std::string(buffer_ + begin, bufferSize_ - begin) + '\n';
+            return std::string(buffer_ + begin, end - begin);
+        }
+        return "";
+    }
     return (lineIndex < lines_.size() ? lines_[lineIndex] : "");
 }
 
+void SourceCode::BuildLineOffsets()
+{
+    /* Store start offset of each line in a single pass */
+    lineOffsets_.clear();
+    lineOffsets_.push_back(0);
+
+    for (auto s = buffer_, end = buffer_ + bufferSize_; s != end;)
+    {
+        auto newLine = static_cast<const char*>(std::memchr(s, '\n', static_cast<std::size_t>(end - s)));
+        if (!newLine)
+            break;
+        s = newLine + 1;
+        lineOffsets_.push_back(static_cast<std::size_t>(s - buffer_));
+    }
+
+    /* Store end of last line, which always ends with a new-line character like for stream sources */
+    lineOffsets_.push_back(bufferSize_ + 1);
+}
+
+char SourceCode::NextFromBuffer()
+{
+    /* Check if reader is at end-of-line */
+    auto row = static_cast<std::size_t>(pos_.Row());
+    if (row == 0 || pos_.Column() >= lineOffsets_[row] - lineOffsets_[row - 1])
+    {
+        /* Check if end-of-file is reached */
+        if (row + 1 >= lineOffsets_.size())
+            return 0;
+
+        pos_.IncRow();
+        ++row;
+    }
+
+    /* Increment column and return current character (or the new-line character at the end of the last line) */
+    auto offset = lineOffsets_[row - 1] + pos_.Column();
+    pos_.IncColumn();
+
+    return (offset < bufferSize_ ? buffer_[offset] : '\n');
+}
+
 
 } // /namespace Xsc
 
@@ -13,6 +13,7 @@
 
 #include <istream>
 #include <string>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
@@ -21,7 +22,11 @@ namespace Xsc
 {
 
 
-// Source code stream class.
+/*
+Source code stream class.
+The source is either read line by line from a stream, or directly from a memory buffer (see MemoryInputStream).
+For a memory buffer, only the start offset of each line is stored for later reports.
+*/
 class SourceCode
 {
 
@@ -29,6 +34,10 @@ class SourceCode
 
         SourceCode(const std::shared_ptr<std::istream>& stream);
 
+        // Borrows the specified memory buffer, which must be valid for the lifetime of this source code.
+        SourceCode(const char* data, std::size_t size);
+        virtual ~SourceCode() = default;
+
         // Returns true if this is a valid source code stream.
         bool IsValid() const;
 
@@ -36,7 +45,7 @@ class SourceCode
         char Next();
 
         // Fetches the line with the marker string of the specified source position.
-        bool FetchLineMarker(const SourceArea& area, std::string& line, std::string& marker);
+        virtual bool FetchLineMarker(const SourceArea& area, std::string& line, std::string& marker);
 
         // Sets the new source origin for the current source position (see "Pos()").
         void NextSourceOrigin(const std::string& filename, int lineOffset);
@@ -53,7 +62,7 @@ class SourceCode
             return pos_;
         }
 
-        // Returns the current source line.
+        // Returns the current source line (only for stream sources).
         inline const std::string& Line() const
         {
             return currentLine_;
@@ -74,6 +83,18 @@ class SourceCode
         std::vector<std::string>        lines_;
         SourcePosition                  pos_;
 
+    private:
+
+        // Builds the line offsets of the memory buffer.
+        void BuildLineOffsets();
+
+        // Returns the next character from the memory buffer.
+        char NextFromBuffer();
+
+        const char*                     buffer_         = nullptr;
+        std::size_t                     bufferSize_     = 0;
+        std::vector<std::size_t>        lineOffsets_;               // Start offset of each line, and end offset (plus one) of the last line
+
 };
 
 using SourceCodePtr = std::shared_ptr<SourceCode>;
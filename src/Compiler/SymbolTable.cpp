@@ -9,6 +9,7 @@
 #include "Exception.h"
 #include "ReportHandler.h"
 #include "ReportIdents.h"
+#include "OverloadCache.h"
 #include <algorithm>
 #include <cctype>
 
@@ -237,20 +238,29 @@ FunctionDecl* ASTSymbolOverload::FetchFunctionDecl(const std::vector<TypeDenoter
     if (refs_.front()->Type() != AST::Types::FunctionDecl)
         RuntimeErr(R_IdentIsNotFunc(ident_));
 
-    /* Convert symbol references to function declaration pointers */
-    std::vector<FunctionDecl*> funcDeclList;
-    funcDeclList.reserve(refs_.size());
-
-    for (auto ref : refs_)
+    auto ResolveFunctionDecl = [&]() -> FunctionDecl*
     {
-        if (auto funcDecl = ref->As<FunctionDecl>())
-            funcDeclList.push_back(funcDecl);
-        else
-            RuntimeErr(R_AmbiguousSymbol(ident_));
-    }
+        /* Convert symbol references to function declaration pointers */
+        std::vector<FunctionDecl*> funcDeclList;
+        funcDeclList.reserve(refs_.size());
+
+        for (auto ref : refs_)
+        {
+            if (auto funcDecl = ref->As<FunctionDecl>())
+                funcDeclList.push_back(funcDecl);
+            else
+                RuntimeErr(R_AmbiguousSymbol(ident_));
+        }
 
-    /* Fetch function declaration from list */
-    return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters);
+        /* Fetch function declaration from list */
+        return FunctionDecl::FetchFunctionDeclFromList(funcDeclList, ident_, argTypeDenoters);
+    };
+
+    /* Fetch function declaration from the overload cache (if enabled) */
+    if (auto overloadCache = OverloadCache::Active())
+        return overloadCache->FetchFunctionDecl(refs_.front(), refs_.size(), argTypeDenoters, ResolveFunctionDecl);
+    else
+        return ResolveFunctionDecl();
 }
 
 
@@ -10,9 +10,7 @@
 
 
 #include "AST.h"
-#include <map>
 #include <string>
-#include <stack>
 #include <vector>
 #include <functional>
 
@@ -69,13 +67,14 @@ class SymbolTable
 
         SymbolTable()
         {
+            slots_.resize(16, emptySlot);
             OpenScope();
         }
 
         // Opens a new scope.
         void OpenScope()
         {
-            scopeStack_.push({});
+            scopeStack_.push_back(entries_.size());
             symTableAnonymous_.push_back({});
         }
 
@@ -84,35 +83,41 @@ class SymbolTable
         {
             if (!scopeStack_.empty())
             {
-                /* Remove all symbols from the table which are in the current scope */
-                for (const auto& ident : scopeStack_.top())
-                {
-                    auto it = symTable_.find(ident);
-                    if (it != symTable_.end())
-                    {
-                        /* Callback for released symbol */
-                        if (releaseProc)
-                            releaseProc(it->second.top().symbol);
-
-                        /* Remove symbol from the top most scope level */
-                        it->second.pop();
-                        if (it->second.empty())
-                        {
-                            /* Remove symbol entry completely if it's reference list is empty */
-                            symTable_.erase(it);
-                        }
-                    }
-                }
+                const auto scopeBegin = scopeStack_.back();
 
                 if (releaseProc)
                 {
+                    /* Release all symbols from the current scope (in the order they were registered) */
+                    for (auto i = scopeBegin; i < entries_.size(); ++i)
+                        releaseProc(entries_[i].symbol);
+
                     /* Release all symbols from the anonymous symbol table */
                     for (const auto& sym : symTableAnonymous_.back())
                         releaseProc(sym.symbol);
                 }
 
+                /* Remove all symbols from the table which are in the current scope (the entries of a scope are always at the end) */
+                while (entries_.size() > scopeBegin)
+                {
+                    const auto& entry = entries_.back();
+                    if (entry.shadowed != invalidIndex)
+                    {
+                        /* Restore symbol from the outer scope that was shadowed by this entry */
+                        slots_[entry.slot] = entry.shadowed;
+                        entries_[entry.shadowed].slot = entry.slot;
+                    }
+                    else
+                    {
+                        /* Remove identifier from the hash table */
+                        slots_[entry.slot] = removedSlot;
+                        --numIdents_;
+                        ++numRemovedSlots_;
+                    }
+                    entries_.pop_back();
+                }
+
                 /* Decrease scope level */
-                scopeStack_.pop();
+                scopeStack_.pop_back();
                 symTableAnonymous_.pop_back();
             }
         }
@@ -121,13 +126,13 @@ class SymbolTable
         Registers the specified symbol in the current scope (if the identifier is not empty).
         At least one scope must be open before symbols can be registered!
         */
-        bool Register(const std::string& ident, SymbolType symbol, const OnOverrideProc& overrideProc = nullptr, bool throwOnFailure = true)
+        bool Register(const Atom& ident, SymbolType symbol, const OnOverrideProc& overrideProc = nullptr, bool throwOnFailure = true)
         {
             /* Validate input parameters */
             if (scopeStack_.empty())
                 RuntimeErrNoActiveScope();
 
-            if (ident.empty())
+            if (ident.Empty())
             {
                 /* Register symbol in anonymous symbol table */
                 symTableAnonymous_.back().push_back({ symbol, ScopeLevel() });
@@ -135,10 +140,10 @@ class SymbolTable
             else
             {
                 /* Check if identifier was already registered in the current scope */
-                auto it = symTable_.find(ident);
-                if (it != symTable_.end() && !it->second.empty())
+                auto entryIndex = FindEntry(ident);
+                if (entryIndex != invalidIndex)
                 {
-                    auto& entry = it->second.top();
+                    auto& entry = entries_[entryIndex];
                     if (entry.symbol && entry.scopeLevel == ScopeLevel())
                     {
                         /* Call override procedure and pass previous symbol entry as reference */
@@ -149,33 +154,41 @@ class SymbolTable
                         else
                             return false;
                     }
-                }
 
-                /* Register new identifier */
-                symTable_[ident].push({ symbol, ScopeLevel() });
-                scopeStack_.top().push_back(ident);
+                    /* Register new identifier that shadows the previous symbol */
+                    const auto slot = entry.slot;
+                    slots_[slot] = entries_.size();
+                    entries_.push_back({ ident, symbol, ScopeLevel(), entryIndex, slot });
+                }
+                else
+                {
+                    /* Register new identifier in a free slot */
+                    const auto slot = AllocSlot(ident);
+                    slots_[slot] = entries_.size();
+                    entries_.push_back({ ident, symbol, ScopeLevel(), invalidIndex, slot });
+                }
             }
 
             return true;
         }
 
         // Returns the symbol with the specified identifer which is in the deepest scope, or null if there is no such symbol.
-        SymbolType Fetch(const std::string& ident) const
+        SymbolType Fetch(const Atom& ident) const
         {
-            auto it = symTable_.find(ident);
-            if (it != symTable_.end() && !it->second.empty())
-                return it->second.top().symbol;
+            auto entryIndex = FindEntry(ident);
+            if (entryIndex != invalidIndex)
+                return entries_[entryIndex].symbol;
             else
                 return GenericDefaultValue<SymbolType>::Get();
         }
 
         // Returns the symbol with the specified identifer which is in the current scope, or null if there is no such symbol.
-        SymbolType FetchFromCurrentScope(const std::string& ident) const
+        SymbolType FetchFromCurrentScope(const Atom& ident) const
         {
-            auto it = symTable_.find(ident);
-            if (it != symTable_.end() && !it->second.empty())
+            auto entryIndex = FindEntry(ident);
+            if (entryIndex != invalidIndex)
             {
-                const auto& sym = it->second.top();
+                const auto& sym = entries_[entryIndex];
                 if (sym.scopeLevel == ScopeLevel())
                     return sym.symbol;
             }
@@ -187,17 +200,22 @@ class SymbolTable
         {
             if (searchPredicate)
             {
-                /* Search symbol in identifiable symbol ist */
-                for (const auto& sym : symTable_)
+                /* Search symbol in identifiable symbol list (take the first identifier in alphabetical order, since the hash table is unordered) */
+                const Entry* found = nullptr;
+
+                for (auto entryIndex : slots_)
                 {
-                    if (!sym.second.empty())
+                    if (entryIndex < entries_.size())
                     {
-                        const auto& symRef = sym.second.top().symbol;
-                        if (searchPredicate(symRef))
-                            return symRef;
+                        const auto& entry = entries_[entryIndex];
+                        if ((found == nullptr || entry.ident.Str() < found->ident.Str()) && searchPredicate(entry.symbol))
+                            found = (&entry);
                     }
                 }
 
+                if (found != nullptr)
+                    return found->symbol;
+
                 /* Search symbol in anonymous symbol list */
                 if (!symTableAnonymous_.empty())
                 {
@@ -221,13 +239,18 @@ class SymbolTable
             const std::string* similar = nullptr;
             unsigned int dist = ~0;
 
-            for (const auto& symbol : symTable_)
+            for (auto entryIndex : slots_)
             {
-                auto d = StringDistance(ident, symbol.first);
-                if (d < dist)
+                if (entryIndex < entries_.size())
                 {
-                    similar = (&symbol.first);
-                    dist = d;
+                    /* Prefer the first identifier in alphabetical order for equal distances */
+                    const auto& symbolIdent = entries_[entryIndex].ident.Str();
+                    auto d = StringDistance(ident, symbolIdent);
+                    if (d < dist || (d == dist && similar != nullptr && symbolIdent < *similar))
+                    {
+                        similar = (&symbolIdent);
+                        dist = d;
+                    }
                 }
             }
 
@@ -253,27 +276,121 @@ class SymbolTable
 
     private:
 
+        static const std::size_t invalidIndex   = ~std::size_t(0);
+        static const std::size_t emptySlot      = invalidIndex;
+        static const std::size_t removedSlot    = invalidIndex - 1;
+
         struct Symbol
         {
             SymbolType  symbol;
             std::size_t scopeLevel;
         };
 
-        // Stores the scope stack for all identifiable symbols.
-        std::map<std::string, std::stack<Symbol>>   symTable_;
+        struct Entry
+        {
+            Atom        ident;
+            SymbolType  symbol;
+            std::size_t scopeLevel;
+            std::size_t shadowed;   // Index of the entry with the same identifier in an outer scope, or 'invalidIndex'.
+            std::size_t slot;       // Hash table slot of this entry (only valid while this entry is not shadowed).
+        };
 
-        // Stores the scope stack for all anonymous symbols.
-        std::vector<std::vector<Symbol>>            symTableAnonymous_;
+        // Returns the first slot to probe for the specified identifier.
+        std::size_t HashSlot(const Atom& ident) const
+        {
+            return ((std::hash<Atom>()(ident) * 0x9e3779b9u) & (slots_.size() - 1));
+        }
+
+        // Returns the index of the innermost entry with the specified identifier, or 'invalidIndex' if there is no such entry.
+        std::size_t FindEntry(const Atom& ident) const
+        {
+            const auto mask = slots_.size() - 1;
+
+            for (auto slot = HashSlot(ident);; slot = ((slot + 1) & mask))
+            {
+                const auto entryIndex = slots_[slot];
+                if (entryIndex == emptySlot)
+                    return invalidIndex;
+                if (entryIndex != removedSlot && entries_[entryIndex].ident == ident)
+                    return entryIndex;
+            }
+        }
+
+        // Returns a free slot for the specified (new) identifier, and grows the hash table if necessary.
+        std::size_t AllocSlot(const Atom& ident)
+        {
+            /* Keep the load factor (including removed slots) below 3/4 */
+            if ((numIdents_ + numRemovedSlots_ + 1) * 4 > slots_.size() * 3)
+                Rehash(numIdents_ * 2 >= slots_.size() ? slots_.size() * 2 : slots_.size());
+
+            const auto mask = slots_.size() - 1;
+
+            for (auto slot = HashSlot(ident);; slot = ((slot + 1) & mask))
+            {
+                if (slots_[slot] == emptySlot || slots_[slot] == removedSlot)
+                {
+                    if (slots_[slot] == removedSlot)
+                        --numRemovedSlots_;
+                    ++numIdents_;
+                    return slot;
+                }
+            }
+        }
+
+        // Rebuilds the hash table with the specified number of slots (must be a power of two) and drops all removed slots.
+        void Rehash(std::size_t numSlots)
+        {
+            std::vector<std::size_t> prevSlots(numSlots, emptySlot);
+            prevSlots.swap(slots_);
+
+            const auto mask = slots_.size() - 1;
+
+            for (auto entryIndex : prevSlots)
+            {
+                if (entryIndex < entries_.size())
+                {
+                    auto slot = HashSlot(entries_[entryIndex].ident);
+                    while (slots_[slot] != emptySlot)
+                        slot = ((slot + 1) & mask);
+                    slots_[slot] = entryIndex;
+                    entries_[entryIndex].slot = slot;
+                }
+            }
+
+            numRemovedSlots_ = 0;
+        }
 
         /*
-        Stores all identifiers for the current stack.
-        All these identifiers will be removed from "symTable_" when a scope will be closed.
+        Stores all identifiable symbols of all scopes, with the innermost scope at the end.
+        Entries that shadow a symbol of an outer scope are chained to that symbol,
+        so closing a scope only unwinds its entries from the end without looking up the identifiers again.
         */
-        std::stack<std::vector<std::string>>        scopeStack_;
+        std::vector<Entry>                          entries_;
+
+        // Open addressing hash table (linear probing) with the index of the innermost entry of each identifier.
+        std::vector<std::size_t>                    slots_;
+        std::size_t                                 numIdents_          = 0;
+        std::size_t                                 numRemovedSlots_    = 0;
+
+        // Stores the scope stack for all anonymous symbols.
+        std::vector<std::vector<Symbol>>            symTableAnonymous_;
+
+        // Stores the index of the first entry in "entries_" for each open scope.
+        std::vector<std::size_t>                    scopeStack_;
 
 };
 
 
+template <typename SymbolType>
+const std::size_t SymbolTable<SymbolType>::invalidIndex;
+
+template <typename SymbolType>
+const std::size_t SymbolTable<SymbolType>::emptySlot;
+
+template <typename SymbolType>
+const std::size_t SymbolTable<SymbolType>::removedSlot;
+
+
 // AST symbol table type.
 using ASTSymbolTable = SymbolTable<AST*>;
 
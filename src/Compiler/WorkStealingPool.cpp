@@ -0,0 +1,122 @@
+/*
+ * WorkStealingPool.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "WorkStealingPool.h"
+#include <thread>
+#include <exception>
+#include <algorithm>
+
+
+namespace Xsc
+{
+
+
+WorkStealingPool::WorkStealingPool(std::size_t numWorkers) :
+    numWorkers_ { numWorkers }
+{
+    if (numWorkers_ == 0)
+        numWorkers_ = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void WorkStealingPool::Run(std::size_t numTasks, const TaskFunction& task)
+{
+    if (numTasks == 0)
+        return;
+
+    const auto numWorkers = std::min(numWorkers_, numTasks);
+
+    /* Distribute contiguous ranges of tasks to the worker queues */
+    std::vector<TaskQueue> queues(numWorkers);
+
+    for (std::size_t i = 0; i < numWorkers; ++i)
+    {
+        const auto first    = numTasks * i / numWorkers;
+        const auto last     = numTasks * (i + 1) / numWorkers;
+
+        for (auto taskIndex = first; taskIndex < last; ++taskIndex)
+            queues[i].tasks.push_back(taskIndex);
+    }
+
+    /* Run tasks until all queues are empty, and keep the first exception */
+    std::mutex          exceptionMutex;
+    std::exception_ptr  exception;
+
+    auto RunWorker = [&](std::size_t workerIndex)
+    {
+        std::size_t taskIndex = 0;
+        while (NextTask(queues, workerIndex, taskIndex))
+        {
+            try
+            {
+                task(taskIndex, workerIndex);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> guard { exceptionMutex };
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+    };
+
+    /* Start worker threads, and let the calling thread be the first worker */
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+
+    for (std::size_t i = 1; i < numWorkers; ++i)
+        threads.emplace_back(RunWorker, i);
+
+    RunWorker(0);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool WorkStealingPool::NextTask(std::vector<TaskQueue>& queues, std::size_t workerIndex, std::size_t& taskIndex)
+{
+    /* Pop task from the back of the own queue */
+    {
+        auto& queue = queues[workerIndex];
+        std::lock_guard<std::mutex> guard { queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            taskIndex = queue.tasks.back();
+            queue.tasks.pop_back();
+            return true;
+        }
+    }
+
+    /* Steal task from the front of another queue */
+    for (std::size_t i = 1; i < queues.size(); ++i)
+    {
+        auto& queue = queues[(workerIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> guard { queue.mutex };
+        if (!queue.tasks.empty())
+        {
+            taskIndex = queue.tasks.front();
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+} // /namespace Xsc
+
+
+
+// ================================================================================
@@ -0,0 +1,77 @@
+/*
+ * WorkStealingPool.h
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef XSC_WORK_STEALING_POOL_H
+#define XSC_WORK_STEALING_POOL_H
+
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <cstddef>
+
+
+namespace Xsc
+{
+
+
+/*
+Work-stealing thread pool, which runs a fixed number of tasks on several worker threads.
+Each worker starts with a contiguous range of tasks in its own queue, pops tasks from the back of its own queue,
+and steals tasks from the front of the other queues when its own queue is empty.
+The calling thread takes part as the first worker (with worker index 0).
+*/
+class WorkStealingPool
+{
+
+    public:
+
+        // Task callback with the index of the task and the index of the worker which runs this task.
+        using TaskFunction = std::function<void(std::size_t taskIndex, std::size_t workerIndex)>;
+
+        // Creates a pool with the specified number of workers. If this is 0, the number of hardware threads is used.
+        WorkStealingPool(std::size_t numWorkers = 0);
+
+        /*
+        Runs all tasks in the range [0, numTasks) and returns when all tasks are done.
+        The number of workers is clamped to the number of tasks.
+        If a task throws an exception, the remaining tasks are still run and the first exception is re-thrown afterwards.
+        */
+        void Run(std::size_t numTasks, const TaskFunction& task);
+
+        // Returns the number of workers of this pool.
+        inline std::size_t GetNumWorkers() const
+        {
+            return numWorkers_;
+        }
+
+    private:
+
+        // Task queue of a single worker.
+        struct TaskQueue
+        {
+            std::mutex                  mutex;
+            std::deque<std::size_t>     tasks;
+        };
+
+        // Pops the next task from the back of the worker's own queue, or steals one from the front of another queue.
+        bool NextTask(std::vector<TaskQueue>& queues, std::size_t workerIndex, std::size_t& taskIndex);
+
+        std::size_t numWorkers_ = 1;
+
+};
+
+
+} // /namespace Xsc
+
+
+#endif
+
+
+
+// ================================================================================
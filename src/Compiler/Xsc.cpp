@@ -8,6 +8,9 @@
 #include <Xsc/Xsc.h>
 #include "Compiler.h"
 #include "ReportIdents.h"
+#include "WorkStealingPool.h"
+#include "Helper.h"
+#include "MemoryStream.h"
 #include <algorithm>
 
 #ifdef XSC_ENABLE_SPIRV
@@ -19,6 +22,11 @@ namespace Xsc
 {
 
 
+XSC_EXPORT std::shared_ptr<std::istream> MakeMemoryInputStream(const char* data, std::size_t size)
+{
+    return std::make_shared<MemoryInputStream>(data, size);
+}
+
 XSC_EXPORT bool CompileShader(
     const ShaderInput&          inputDesc,
     const ShaderOutput&         outputDesc,
@@ -39,39 +47,103 @@ XSC_EXPORT bool CompileShader(
 
     /* Show timings */
     if (outputDesc.options.showTimes && log)
+        Compiler::PrintStageTimings(log, timePoints);
+
+    return result;
+}
+
+XSC_EXPORT bool CompileShaderBatch(
+    const ShaderInput&                  inputDesc,
+    const std::vector<ShaderBatchJob>&  jobs,
+    Log*                                log,
+    std::vector<bool>*                  jobResults)
+{
+    /* Compile all jobs with a single compiler driver */
+    std::vector<Compiler::StageTimePoints> timePoints;
+
+    Compiler compiler(log);
+
+    auto result = compiler.CompileShaderBatch(
+        inputDesc,
+        jobs,
+        jobResults,
+        &timePoints
+    );
+
+    /* Show timings of each job */
+    if (log)
     {
-        using TimePoint = Compiler::TimePoint;
+        for (std::size_t i = 0; i < jobs.size() && i < timePoints.size(); ++i)
+        {
+            if (jobs[i].outputDesc.options.showTimes)
+                Compiler::PrintStageTimings(log, timePoints[i]);
+        }
+    }
 
-        auto PrintTiming = [log](const std::string& processName, const TimePoint startTime, const TimePoint endTime)
+    return result;
+}
+
+XSC_EXPORT bool CompileShaderPermutations(
+    const ShaderInput&                      inputDesc,
+    const ShaderOutput&                     outputDesc,
+    const std::vector<PermutationMacro>&    macroMatrix,
+    ShaderPermutationResult&                permutationResult,
+    Log*                                    log)
+{
+    /* Compile all permutations with a single compiler driver */
+    Compiler compiler(log);
+    return compiler.CompileShaderPermutations(inputDesc, outputDesc, macroMatrix, permutationResult);
+}
+
+XSC_EXPORT bool CompileShadersParallel(
+    const std::vector<ShaderCompileJob>&    jobs,
+    unsigned int                            numThreads,
+    std::vector<bool>*                      jobResults)
+{
+    /* Store results in characters, since a vector<bool> can not be written by multiple threads */
+    std::vector<char> results(jobs.size(), 0);
+
+    WorkStealingPool pool(numThreads);
+
+    /* Each worker thread uses its own compiler driver, which is created within that thread */
+    std::vector<std::unique_ptr<Compiler>> compilers(pool.GetNumWorkers());
+
+    pool.Run(
+        jobs.size(),
+        [&](std::size_t taskIndex, std::size_t workerIndex)
         {
-            long long duration = 0ll;
+            const auto& job = jobs[taskIndex];
 
-            if (endTime > startTime)
+            auto& compiler = compilers[workerIndex];
+            if (!compiler)
             {
-                duration =
-                (
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::duration<float>(endTime - startTime)
-                    ).count()
-                );
+                compiler = MakeUnique<Compiler>();
+                compiler->WarmUp();
             }
 
-            log->SubmitReport(
-                Report(
-                    ReportTypes::Info,
-                    "timing " + processName + std::to_string(duration) + " ms"
-                )
+            /* Compile shader of this job */
+            Compiler::StageTimePoints timePoints;
+
+            compiler->SetLog(job.log);
+
+            results[taskIndex] = compiler->CompileShader(
+                job.inputDesc,
+                job.outputDesc,
+                job.reflectionData,
+                &timePoints
             );
-        };
 
-        PrintTiming( "pre-processing:   ", timePoints.preprocessor, timePoints.parser     );
-        PrintTiming( "parsing:          ", timePoints.parser,       timePoints.analyzer   );
-        PrintTiming( "context analysis: ", timePoints.analyzer,     timePoints.optimizer  );
-        PrintTiming( "optimization:     ", timePoints.optimizer,    timePoints.generation );
-        PrintTiming( "code generation:  ", timePoints.generation,   timePoints.reflection );
-    }
+            /* Show timings */
+            if (job.outputDesc.options.showTimes && job.log)
+                Compiler::PrintStageTimings(job.log, timePoints);
+        }
+    );
 
-    return result;
+    /* Return results of all jobs */
+    if (jobResults)
+        jobResults->assign(results.begin(), results.end());
+
+    return std::all_of(results.begin(), results.end(), [](char result) { return result != 0; });
 }
 
 XSC_EXPORT void DisassembleShader(
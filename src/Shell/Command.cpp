@@ -475,7 +475,7 @@ void MacroCommand::Run(CommandLine& cmdLine, ShellState& state)
     else
         macro.ident = arg;
 
-    state.predefinedMacros.push_back(macro);
+    state.inputDesc.predefinedMacros.push_back(macro);
 }
 
 
@@ -1041,6 +1041,30 @@ void ValidateCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * ValidateAllCommand class
+ */
+
+std::vector<Command::Identifier> ValidateAllCommand::Idents() const
+{
+    return { { "--validate-all" } };
+}
+
+HelpDescriptor ValidateAllCommand::Help() const
+{
+    return
+    {
+        "--validate-all [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpValidateAll(CommandLine::GetBooleanFalse())
+    };
+}
+
+void ValidateAllCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.validateAll = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * BindingCommand class
  */
@@ -1230,6 +1254,54 @@ void RowMajorAlignmentCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * LazyBodiesCommand class
+ */
+
+std::vector<Command::Identifier> LazyBodiesCommand::Idents() const
+{
+    return { { "--lazy-bodies" } };
+}
+
+HelpDescriptor LazyBodiesCommand::Help() const
+{
+    return
+    {
+        "--lazy-bodies [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpLazyBodies(CommandLine::GetBooleanFalse())
+    };
+}
+
+void LazyBodiesCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.outputDesc.options.lazyFunctionBodies = cmdLine.AcceptBoolean(true);
+}
+
+
+/*
+ * PrefetchIncludesCommand class
+ */
+
+std::vector<Command::Identifier> PrefetchIncludesCommand::Idents() const
+{
+    return { { "--prefetch-includes" } };
+}
+
+HelpDescriptor PrefetchIncludesCommand::Help() const
+{
+    return
+    {
+        "--prefetch-includes [" + CommandLine::GetBooleanOption() + "]",
+        R_CmdHelpPrefetchIncludes(CommandLine::GetBooleanFalse())
+    };
+}
+
+void PrefetchIncludesCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.inputDesc.prefetchIncludes = cmdLine.AcceptBoolean(true);
+}
+
+
 /*
  * FormattingCommand class
  */
@@ -1476,6 +1548,131 @@ void DisassembleExtCommand::Run(CommandLine& cmdLine, ShellState& state)
 }
 
 
+/*
+ * CacheCommand class
+ */
+
+std::vector<Command::Identifier> CacheCommand::Idents() const
+{
+    return { { "--cache" } };
+}
+
+HelpDescriptor CacheCommand::Help() const
+{
+    return
+    {
+        "--cache DIR",
+        R_CmdHelpCache
+    };
+}
+
+void CacheCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    const auto directory = cmdLine.Accept();
+    state.cacheDirectory = (directory == "-" ? "" : directory);
+}
+
+
+/*
+ * PCHCreateCommand class
+ */
+
+std::vector<Command::Identifier> PCHCreateCommand::Idents() const
+{
+    return { { "--pch-create" } };
+}
+
+HelpDescriptor PCHCreateCommand::Help() const
+{
+    return
+    {
+        "--pch-create FILE",
+        R_CmdHelpPCHCreate
+    };
+}
+
+void PCHCreateCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    state.pchCreateFilename = cmdLine.Accept();
+}
+
+
+/*
+ * PCHUseCommand class
+ */
+
+std::vector<Command::Identifier> PCHUseCommand::Idents() const
+{
+    return { { "--pch-use" } };
+}
+
+HelpDescriptor PCHUseCommand::Help() const
+{
+    return
+    {
+        "--pch-use FILE",
+        R_CmdHelpPCHUse
+    };
+}
+
+void PCHUseCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    const auto filename = cmdLine.Accept();
+    state.pchFilename = (filename == "-" ? "" : filename);
+}
+
+
+/*
+ * PermuteCommand class
+ */
+
+std::vector<Command::Identifier> PermuteCommand::Idents() const
+{
+    return { { "--permute" } };
+}
+
+HelpDescriptor PermuteCommand::Help() const
+{
+    return
+    {
+        "--permute <IDENT>, --permute <IDENT>=VALUE1,VALUE2,...",
+        R_CmdHelpPermute
+    };
+}
+
+void PermuteCommand::Run(CommandLine& cmdLine, ShellState& state)
+{
+    auto arg = cmdLine.Accept();
+
+    PermutationMacro macro;
+
+    auto pos = arg.find('=');
+    if (pos != std::string::npos)
+    {
+        macro.ident = arg.substr(0, pos);
+
+        /* Split comma separated list of values */
+        for (auto start = pos + 1;;)
+        {
+            auto end = arg.find(',', start);
+            macro.values.push_back(arg.substr(start, end - start));
+            if (end == std::string::npos)
+                break;
+            start = end + 1;
+        }
+    }
+    else
+    {
+        /* Permute between undefined and defined macro */
+        macro.ident             = arg;
+        macro.values            = { "" };
+        macro.undefinedVariant  = true;
+    }
+
+    state.permutationMacros.push_back(macro);
+}
+
+
 #ifdef XSC_ENABLE_LANGUAGE_EXT
 
 /*
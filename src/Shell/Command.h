@@ -93,12 +93,15 @@ DECL_SHELL_COMMAND( OptimizeCommand              );
 DECL_SHELL_COMMAND( ExtensionCommand             );
 DECL_SHELL_COMMAND( EnumExtensionCommand         );
 DECL_SHELL_COMMAND( ValidateCommand              );
+DECL_SHELL_COMMAND( ValidateAllCommand           );
 DECL_SHELL_COMMAND( BindingCommand               );
 DECL_SHELL_COMMAND( CommentCommand               );
 DECL_SHELL_COMMAND( WrapperCommand               );
 DECL_SHELL_COMMAND( UnrollInitializerCommand     );
 DECL_SHELL_COMMAND( ObfuscateCommand             );
 DECL_SHELL_COMMAND( RowMajorAlignmentCommand     );
+DECL_SHELL_COMMAND( LazyBodiesCommand            );
+DECL_SHELL_COMMAND( PrefetchIncludesCommand      );
 DECL_SHELL_COMMAND( AutoBindingCommand           );
 DECL_SHELL_COMMAND( AutoBindingStartSlotCommand  );
 DECL_SHELL_COMMAND( FormattingCommand            );
@@ -109,6 +112,10 @@ DECL_SHELL_COMMAND( SeparateShadersCommand       );
 DECL_SHELL_COMMAND( SeparateSamplersCommand      );
 DECL_SHELL_COMMAND( DisassembleCommand           );
 DECL_SHELL_COMMAND( DisassembleExtCommand        );
+DECL_SHELL_COMMAND( CacheCommand                 );
+DECL_SHELL_COMMAND( PCHCreateCommand             );
+DECL_SHELL_COMMAND( PCHUseCommand                );
+DECL_SHELL_COMMAND( PermuteCommand               );
 
 #ifdef XSC_ENABLE_LANGUAGE_EXT
 
@@ -80,12 +80,15 @@ CommandFactory::CommandFactory()
         ExtensionCommand,
         EnumExtensionCommand,
         ValidateCommand,
+        ValidateAllCommand,
         BindingCommand,
         CommentCommand,
         WrapperCommand,
         UnrollInitializerCommand,
         ObfuscateCommand,
         RowMajorAlignmentCommand,
+        LazyBodiesCommand,
+        PrefetchIncludesCommand,
         AutoBindingCommand,
         AutoBindingStartSlotCommand,
         FormattingCommand,
@@ -95,7 +98,11 @@ CommandFactory::CommandFactory()
         SeparateShadersCommand,
         SeparateSamplersCommand,
         DisassembleCommand,
-        DisassembleExtCommand
+        DisassembleExtCommand,
+        CacheCommand,
+        PCHCreateCommand,
+        PCHUseCommand,
+        PermuteCommand
     >();
 }
 
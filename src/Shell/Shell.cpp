@@ -112,8 +112,16 @@ bool Shell::ExecuteCommandLine(CommandLine& cmdLine, bool enableBriefHelp)
             }
             else
             {
-                /* Compile specified shader file */
-                bool succeeded = Compile(cmdName);
+                /* Compile specified shader file, or precompile it as header file */
+                bool succeeded = false;
+
+                if (!state_.pchCreateFilename.empty())
+                {
+                    succeeded = PrecompileHeader(cmdName);
+                    state_.pchCreateFilename.clear();
+                }
+                else
+                    succeeded = Compile(cmdName);
 
                 if (succeeded)
                     state_.compileStatus.numSucceeded++;
@@ -191,6 +199,13 @@ static std::string GetPathPart(const std::string& s)
     return (pos == std::string::npos ? "" : s.substr(0, pos));
 }
 
+// Returns the filename without its path from the specified string.
+static std::string GetFilenamePart(const std::string& s)
+{
+    const auto pos = s.find_last_of("\\/");
+    return (pos == std::string::npos ? s : s.substr(pos + 1));
+}
+
 static std::string TargetToExtension(const ShaderTarget shaderTarget)
 {
     switch (shaderTarget)
@@ -227,26 +242,13 @@ bool Shell::Compile(const std::string& filename)
 
     try
     {
-        /* Add pre-defined macros at the top of the input stream */
-        auto inputStream = std::make_shared<std::stringstream>();
-
-        for (const auto& macro : state_.predefinedMacros)
-        {
-            *inputStream << "#define " << macro.ident;
-            if (!macro.value.empty())
-                *inputStream << ' ' << macro.value;
-            *inputStream << std::endl;
-        }
-
         /* Open input stream */
         state_.inputDesc.filename = filename;
 
-        std::ifstream inputFile(filename);
-        if (!inputFile.good())
+        auto inputStream = std::make_shared<std::ifstream>(filename);
+        if (!inputStream->good())
             throw std::runtime_error(R_FailedToReadFile(filename));
 
-        *inputStream << inputFile.rdbuf();
-
         std::stringstream outputStream;
 
         /* Initialize input and output descriptors */
@@ -261,6 +263,13 @@ bool Shell::Compile(const std::string& filename)
         includeHandler.GetSearchPaths() = state_.searchPaths;
         state_.inputDesc.includeHandler = &includeHandler;
 
+        auto cache = GetShaderCache();
+        state_.inputDesc.cache = cache;
+
+        state_.inputDesc.precompiledHeader = GetPrecompiledHeader();
+
+        const auto numCacheHits = (cache != nullptr ? cache->GetStatistics().hits : 0);
+
         /* Add file path to include paths */
         const auto inputPath = GetPathPart(filename);
         if (!inputPath.empty())
@@ -275,17 +284,35 @@ bool Shell::Compile(const std::string& filename)
                 output << R_CompileShader(filename, outputFilename) << std::endl;
         }
 
-        /* Compile shader file */
-        succeeded = CompileShader(
-            state_.inputDesc,
-            state_.outputDesc,
-            &log,
-            (state_.showReflection ? &reflectionData : nullptr)
-        );
+        /* Compile shader file (or all of its permutations) */
+        ShaderPermutationResult permutationResult;
+
+        if (state_.permutationMacros.empty())
+        {
+            succeeded = CompileShader(
+                state_.inputDesc,
+                state_.outputDesc,
+                &log,
+                (state_.showReflection ? &reflectionData : nullptr)
+            );
+        }
+        else
+        {
+            succeeded = CompileShaderPermutations(
+                state_.inputDesc,
+                state_.outputDesc,
+                state_.permutationMacros,
+                permutationResult,
+                &log
+            );
+        }
 
         /* Print all reports to the log output */
         log.PrintAll(state_.verbose);
 
+        if (state_.verbose && cache != nullptr && cache->GetStatistics().hits > numCacheHits)
+            output << R_LoadedFromShaderCache() << std::endl;
+
         if (succeeded)
         {
             ScopedColor color { ColorFlags::Green | ColorFlags::Intens };
@@ -295,15 +322,20 @@ bool Shell::Compile(const std::string& filename)
                 if (state_.verbose)
                     output << R_CompilationSuccessful() << std::endl;
 
-                /* Write result to output stream only on success */
-                std::ofstream outputFile(outputFilename);
-                if (outputFile.good())
-                    outputFile << outputStream.rdbuf();
-                else
-                    throw std::runtime_error(R_FailedToWriteFile(outputFilename));
+                if (state_.permutationMacros.empty())
+                {
+                    /* Write result to output stream only on success */
+                    std::ofstream outputFile(outputFilename);
+                    if (outputFile.good())
+                        outputFile << outputStream.rdbuf();
+                    else
+                        throw std::runtime_error(R_FailedToWriteFile(outputFilename));
 
-                /* Store output filename after successful compilation */
-                lastOutputFilename_ = outputFilename;
+                    /* Store output filename after successful compilation */
+                    lastOutputFilename_ = outputFilename;
+                }
+                else
+                    WritePermutations(outputFilename, permutationResult);
             }
             else if (state_.verbose)
                 output << R_ValidationSuccessful() << std::endl;
@@ -321,17 +353,178 @@ bool Shell::Compile(const std::string& filename)
 
         /* Show output statistics (if enabled) */
         if (state_.showReflection)
-            PrintReflection(output, reflectionData, !state_.showReflectionExt);
+        {
+            if (state_.permutationMacros.empty())
+                PrintReflection(output, reflectionData, !state_.showReflectionExt);
+            else
+            {
+                for (const auto& permutationOutput : permutationResult.outputs)
+                    PrintReflection(output, permutationOutput.reflectionData, !state_.showReflectionExt);
+            }
+        }
+    }
+    catch (const std::exception& err)
+    {
+        /* Print error message */
+        output << err.what() << std::endl;
+    }
+
+    return succeeded;
+}
+
+bool Shell::PrecompileHeader(const std::string& filename)
+{
+    bool succeeded = false;
+
+    const auto pchFilename = state_.pchCreateFilename;
+
+    try
+    {
+        /* Open header file, which is included by its filename without path */
+        auto inputStream = std::make_shared<std::ifstream>(filename);
+        if (!inputStream->good())
+            throw std::runtime_error(R_FailedToReadFile(filename));
+
+        ShaderInput inputDesc = state_.inputDesc;
+        {
+            inputDesc.filename          = GetFilenamePart(filename);
+            inputDesc.sourceCode        = inputStream;
+            inputDesc.cache             = nullptr;
+            inputDesc.precompiledHeader = nullptr;
+        }
+
+        StdLog          log;
+        IncludeHandler  includeHandler;
+
+        includeHandler.GetSearchPaths() = state_.searchPaths;
+        inputDesc.includeHandler = &includeHandler;
+
+        /* Add file path to include paths */
+        const auto inputPath = GetPathPart(filename);
+        if (!inputPath.empty())
+            includeHandler.GetSearchPaths().push_back(inputPath);
+
+        if (state_.verbose)
+            output << R_PrecompileHeader(filename, pchFilename) << std::endl;
+
+        /* Pre-process header file and save the precompiled header */
+        PrecompiledHeader pch;
+        succeeded = pch.Create(inputDesc, &log);
+
+        log.PrintAll(state_.verbose);
+
+        if (succeeded)
+        {
+            if (!pch.Save(pchFilename))
+                throw std::runtime_error(R_FailedToWriteFile(pchFilename));
+
+            /* Reload precompiled header with the next compilation */
+            if (precompiledHeaderFilename_ == pchFilename)
+                precompiledHeader_.reset();
+
+            if (state_.verbose)
+            {
+                ScopedColor color { ColorFlags::Green | ColorFlags::Intens };
+                output << R_CompilationSuccessful() << std::endl;
+            }
+        }
+        else
+        {
+            ScopedColor color { ColorFlags::Red | ColorFlags::Intens };
+            output << R_CompilationFailed() << std::endl;
+        }
     }
     catch (const std::exception& err)
     {
         /* Print error message */
         output << err.what() << std::endl;
+        succeeded = false;
     }
 
     return succeeded;
 }
 
+void Shell::WritePermutations(const std::string& outputFilename, const ShaderPermutationResult& permutationResult)
+{
+    /* Insert index of each output before the file extension, e.g. "Example.vert" -> "Example.0.vert" */
+    auto GetPermutationFilename = [&outputFilename](std::size_t outputIndex)
+    {
+        const auto pos = outputFilename.find_last_of('.');
+        const auto dirPos = outputFilename.find_last_of("\\/");
+        if (pos == std::string::npos || (dirPos != std::string::npos && pos < dirPos))
+            return outputFilename + "." + std::to_string(outputIndex);
+        return outputFilename.substr(0, pos) + "." + std::to_string(outputIndex) + outputFilename.substr(pos);
+    };
+
+    const auto& outputs = permutationResult.outputs;
+
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        const auto filename = GetPermutationFilename(i);
+
+        std::ofstream outputFile(filename);
+        if (outputFile.good())
+            outputFile << outputs[i].sourceCode;
+        else
+            throw std::runtime_error(R_FailedToWriteFile(filename));
+
+        /* Store first output filename after successful compilation */
+        if (i == 0)
+            lastOutputFilename_ = filename;
+    }
+
+    if (state_.verbose)
+    {
+        output << R_CompiledPermutations(permutationResult.permutations.size(), outputs.size()) << std::endl;
+
+        /* Show output file of each permutation */
+        for (const auto& permutation : permutationResult.permutations)
+        {
+            std::string macros;
+            for (const auto& macro : permutation.macros)
+            {
+                if (!macros.empty())
+                    macros += ' ';
+                macros += macro.first;
+                if (!macro.second.empty())
+                    macros += '=' + macro.second;
+            }
+            output << "  " << R_PermutationOutput(macros, GetPermutationFilename(permutation.outputIndex)) << std::endl;
+        }
+    }
+}
+
+ShaderCache* Shell::GetShaderCache()
+{
+    if (state_.cacheDirectory.empty())
+        return nullptr;
+
+    /* Open shader cache only once for each cache directory */
+    if (!shaderCache_ || shaderCache_->GetDirectory() != state_.cacheDirectory)
+        shaderCache_ = MakeUnique<ShaderCache>(state_.cacheDirectory);
+
+    return shaderCache_.get();
+}
+
+const PrecompiledHeader* Shell::GetPrecompiledHeader()
+{
+    if (state_.pchFilename.empty())
+        return nullptr;
+
+    /* Load precompiled header only once for each file */
+    if (!precompiledHeader_ || precompiledHeaderFilename_ != state_.pchFilename)
+    {
+        auto pch = MakeUnique<PrecompiledHeader>();
+        if (!pch->Load(state_.pchFilename))
+            throw std::runtime_error(R_FailedToLoadPrecompiledHeader(state_.pchFilename));
+
+        precompiledHeader_          = std::move(pch);
+        precompiledHeaderFilename_  = state_.pchFilename;
+    }
+
+    return precompiledHeader_.get();
+}
+
 
 } // /namespace Util
 
@@ -11,10 +11,13 @@
 
 #include <Xsc/IndentHandler.h>
 #include <Xsc/Reflection.h>
+#include <Xsc/ShaderCache.h>
+#include <Xsc/PrecompiledHeader.h>
 #include "ShellState.h"
 #include "CommandLine.h"
 #include <ostream>
 #include <stack>
+#include <memory>
 
 
 namespace Xsc
@@ -63,12 +66,29 @@ class Shell
 
         bool Compile(const std::string& filename);
 
-        ShellState              state_;
-        std::stack<ShellState>  stateStack_;
+        // Pre-processes the specified header file, and saves it as precompiled header.
+        bool PrecompileHeader(const std::string& filename);
 
-        std::string             lastOutputFilename_;
+        // Writes each unique output of the shader permutations into its own file, derived from the specified output filename.
+        void WritePermutations(const std::string& outputFilename, const ShaderPermutationResult& permutationResult);
 
-        static Shell*           instance_;
+        // Returns the shader cache for the current cache directory, or null if the cache is disabled.
+        ShaderCache* GetShaderCache();
+
+        // Returns the precompiled header for the current precompiled header file, or null if precompiled headers are disabled.
+        const PrecompiledHeader* GetPrecompiledHeader();
+
+        ShellState                          state_;
+        std::stack<ShellState>              stateStack_;
+
+        std::string                         lastOutputFilename_;
+
+        std::unique_ptr<ShaderCache>        shaderCache_;
+
+        std::unique_ptr<PrecompiledHeader>  precompiledHeader_;
+        std::string                         precompiledHeaderFilename_;
+
+        static Shell*                       instance_;
 
 };
 
@@ -28,15 +28,6 @@ struct CompileStatus
     std::size_t numFailed       = 0;
 };
 
-struct PredefinedMacro
-{
-    // Macro identifier
-    std::string ident;
-
-    // Optional macro body
-    std::string value;
-};
-
 struct ShellState
 {
     // Shader input descriptor.
@@ -48,12 +39,21 @@ struct ShellState
     // Output filename (hint).
     std::string                     outputFilename;
 
-    // Predefined macros for the preprocessor
-    std::vector<PredefinedMacro>    predefinedMacros;
+    // Macro matrix for the shader permutations. Only a single shader is compiled if this is empty.
+    std::vector<PermutationMacro>   permutationMacros;
 
     // Include search paths for the preprocessor.
     std::vector<std::string>        searchPaths;
 
+    // Directory of the shader cache. The cache is disabled if this is empty.
+    std::string                     cacheDirectory;
+
+    // Filename of the precompiled header, which is created from the next input file instead of compiling it.
+    std::string                     pchCreateFilename;
+
+    // Filename of the precompiled header, which is used for all compilations. Precompiled headers are disabled if this is empty.
+    std::string                     pchFilename;
+
     // Print line marks for compiler reports.
     bool                            verbose             = true;
 
@@ -6,6 +6,7 @@
  */
 
 #include <Xsc/Xsc.h>
+#include <Xsc/CompilerSession.h>
 #include <XscC/XscC.h>
 #include <string.h>
 #include <sstream>
@@ -116,16 +117,19 @@ static void InitializeIncludeHandler(struct XscIncludeHandler* s)
 
 static void InitializeShaderInput(struct XscShaderInput* s)
 {
-    s->filename             = NULL;
-    s->sourceCode           = NULL;
-    s->shaderVersion        = XscEInputHLSL5;
-    s->shaderTarget         = XscETargetUndefined;
-    s->entryPoint           = "main";
-    s->secondaryEntryPoint  = NULL;
-    s->warnings             = 0;
-    s->extensions           = 0;
+    s->filename              = NULL;
+    s->sourceCode            = NULL;
+    s->shaderVersion         = XscEInputHLSL5;
+    s->shaderTarget          = XscETargetUndefined;
+    s->entryPoint            = "main";
+    s->secondaryEntryPoint   = NULL;
+    s->warnings              = 0;
+    s->extensions            = 0;
 
     InitializeIncludeHandler(&(s->includeHandler));
+
+    s->predefinedMacros      = NULL;
+    s->predefinedMacrosCount = 0;
 }
 
 static void InitializeShaderOutput(struct XscShaderOutput* s)
@@ -151,7 +155,7 @@ XSC_EXPORT void XscInitialize(struct XscShaderInput* inputDesc, struct XscShader
 
 static int ValidateShaderInput(const struct XscShaderInput* s)
 {
-    return (s != NULL && s->sourceCode != NULL && s->entryPoint != NULL);
+    return (s != NULL && s->sourceCode != NULL && s->entryPoint != NULL && (s->predefinedMacrosCount == 0 || s->predefinedMacros != NULL));
 }
 
 static bool ValidateShaderOutput(const struct XscShaderOutput* s)
@@ -159,24 +163,34 @@ static bool ValidateShaderOutput(const struct XscShaderOutput* s)
     return (s != NULL && s->sourceCode != NULL && (s->vertexSemanticsCount == 0 || s->vertexSemantics != NULL));
 }
 
-static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct XscReflectionData* dst)
+static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct XscReflectionData* dst, struct CompilerContext& context)
 {
+    /* Clear context buffers from previous compilation */
+    context.macros.clear();
+    context.inputAttributes.clear();
+    context.outputAttributes.clear();
+    context.uniforms.clear();
+    context.resources.clear();
+    context.constantBuffers.clear();
+    context.samplerStates.clear();
+    context.staticSamplerStates.clear();
+
     /* Fill context buffers */
     for (const auto& s : src.macros)
-        g_compilerContext.macros.push_back(s.c_str());
+        context.macros.push_back(s.c_str());
 
     for (const auto& s : src.inputAttributes)
-        g_compilerContext.inputAttributes.push_back({ s.name.c_str(), s.slot });
+        context.inputAttributes.push_back({ s.name.c_str(), s.slot });
 
     for (const auto& s : src.outputAttributes)
-        g_compilerContext.outputAttributes.push_back({ s.name.c_str(), s.slot });
+        context.outputAttributes.push_back({ s.name.c_str(), s.slot });
 
     for (const auto& s : src.uniforms)
-        g_compilerContext.uniforms.push_back({ s.name.c_str(), s.slot });
+        context.uniforms.push_back({ s.name.c_str(), s.slot });
 
     for (const auto& s : src.resources)
     {
-        g_compilerContext.resources.push_back(
+        context.resources.push_back(
             {
                 static_cast<XscResourceType>(s.type),
                 s.name.c_str(),
@@ -187,7 +201,7 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
 
     for (const auto& s : src.constantBuffers)
     {
-        g_compilerContext.constantBuffers.push_back(
+        context.constantBuffers.push_back(
             {
                 static_cast<XscResourceType>(s.type),
                 s.name.c_str(),
@@ -199,11 +213,11 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     }
 
     for (const auto& s : src.samplerStates)
-        g_compilerContext.samplerStates.push_back({ static_cast<XscResourceType>(s.type), s.name.c_str(), s.slot });
+        context.samplerStates.push_back({ static_cast<XscResourceType>(s.type), s.name.c_str(), s.slot });
 
     for (const auto& s : src.staticSamplerStates)
     {
-        g_compilerContext.staticSamplerStates.push_back(
+        context.staticSamplerStates.push_back(
             {
                 static_cast<XscResourceType>(s.type),
                 s.name.c_str(),
@@ -229,29 +243,29 @@ static void CopyReflection(const Xsc::Reflection::ReflectionData& src, struct Xs
     }
 
     /* Set references to output buffers */
-    dst->macros                     = g_compilerContext.macros.data();
-    dst->macrosCount                = g_compilerContext.macros.size();
+    dst->macros                     = context.macros.data();
+    dst->macrosCount                = context.macros.size();
 
-    dst->inputAttributes            = g_compilerContext.inputAttributes.data();
-    dst->inputAttributesCount       = g_compilerContext.inputAttributes.size();
+    dst->inputAttributes            = context.inputAttributes.data();
+    dst->inputAttributesCount       = context.inputAttributes.size();
 
-    dst->outputAttributes           = g_compilerContext.outputAttributes.data();
-    dst->outputAttributesCount      = g_compilerContext.outputAttributes.size();
+    dst->outputAttributes           = context.outputAttributes.data();
+    dst->outputAttributesCount      = context.outputAttributes.size();
 
-    dst->uniforms                   = g_compilerContext.uniforms.data();
-    dst->uniformsCount              = g_compilerContext.uniforms.size();
+    dst->uniforms                   = context.uniforms.data();
+    dst->uniformsCount              = context.uniforms.size();
 
-    dst->resources                  = g_compilerContext.resources.data();
-    dst->resourcesCount             = g_compilerContext.resources.size();
+    dst->resources                  = context.resources.data();
+    dst->resourcesCount             = context.resources.size();
 
-    dst->constantBuffers            = g_compilerContext.constantBuffers.data();
-    dst->constantBufferCounts       = g_compilerContext.constantBuffers.size();
+    dst->constantBuffers            = context.constantBuffers.data();
+    dst->constantBufferCounts       = context.constantBuffers.size();
 
-    dst->samplerStates              = g_compilerContext.samplerStates.data();
-    dst->samplerStatesCount         = g_compilerContext.samplerStates.size();
+    dst->samplerStates              = context.samplerStates.data();
+    dst->samplerStatesCount         = context.samplerStates.size();
 
-    dst->staticSamplerStates        = g_compilerContext.staticSamplerStates.data();
-    dst->staticSamplerStatesCount   = g_compilerContext.staticSamplerStates.size();
+    dst->staticSamplerStates        = context.staticSamplerStates.data();
+    dst->staticSamplerStatesCount   = context.staticSamplerStates.size();
 
     /* Copy remaining data fields */
     dst->numThreads.x = src.numThreads.x;
@@ -296,7 +310,7 @@ std::unique_ptr<std::istream> IncludeHandlerC::Include(const std::string& filena
         *stream << ReadStringC(source);
     }
 
-    return std::move(stream);
+    return stream;
 }
 
 
@@ -353,14 +367,33 @@ void LogC::SubmitReport(const Xsc::Report& report)
 
 
 /*
- * Public functions
+ * Compiler session
  */
 
-XSC_EXPORT int XscCompileShader(
+struct XscCompilerSession
+{
+    Xsc::CompilerSession    session;
+    struct CompilerContext  context;
+};
+
+static void CopySearchPaths(const char** src, std::vector<std::string>& dst)
+{
+    dst.clear();
+    if (src != NULL)
+    {
+        for (; *src != NULL; ++src)
+            dst.push_back(*src);
+    }
+}
+
+// Compiles the shader with the C++ API, either with the specified compiler session or with the global compiler function.
+static int CompileShaderPrimary(
+    struct XscCompilerSession*      session,
     const struct XscShaderInput*    inputDesc,
     const struct XscShaderOutput*   outputDesc,
     const struct XscLog*            log,
-    struct XscReflectionData*       reflectionData)
+    struct XscReflectionData*       reflectionData,
+    struct CompilerContext&         context)
 {
     if (!ValidateShaderInput(inputDesc) || !ValidateShaderOutput(outputDesc))
         return 0;
@@ -370,27 +403,36 @@ XSC_EXPORT int XscCompileShader(
 
     IncludeHandlerC includeHandler(inputDesc->includeHandler);
 
-    auto inputStream = std::make_shared<std::stringstream>();
-    *inputStream << inputDesc->sourceCode;
+    /* Use default include handler of the compiler session, if no include callback is specified */
+    auto useSessionIncludeHandler = (session != NULL && inputDesc->includeHandler.handleIncludePfn == NULL);
+    if (useSessionIncludeHandler)
+        CopySearchPaths(inputDesc->includeHandler.searchPaths, session->session.GetIncludeHandler().GetSearchPaths());
 
     in.filename             = ReadStringC(inputDesc->filename);
-    in.sourceCode           = inputStream;
+    in.sourceCode           = Xsc::MakeMemoryInputStream(inputDesc->sourceCode, strlen(inputDesc->sourceCode));
     in.shaderVersion        = static_cast<Xsc::InputShaderVersion>(inputDesc->shaderVersion);
     in.shaderTarget         = static_cast<Xsc::ShaderTarget>(inputDesc->shaderTarget);
     in.entryPoint           = ReadStringC(inputDesc->entryPoint);
     in.secondaryEntryPoint  = ReadStringC(inputDesc->secondaryEntryPoint);
     in.warnings             = inputDesc->warnings;
-    in.includeHandler       = (&includeHandler);
+    in.includeHandler       = (useSessionIncludeHandler ? nullptr : &includeHandler);
     in.extensions           = inputDesc->extensions;
 
+    in.predefinedMacros.resize(inputDesc->predefinedMacrosCount);
+    for (size_t i = 0; i < inputDesc->predefinedMacrosCount; ++i)
+    {
+        in.predefinedMacros[i].ident = ReadStringC(inputDesc->predefinedMacros[i].ident);
+        in.predefinedMacros[i].value = ReadStringC(inputDesc->predefinedMacros[i].value);
+    }
+
     /* Copy output descriptor */
     Xsc::ShaderOutput out;
 
-    std::stringstream outputStream;
+    std::string outputCode;
 
-    out.filename        = ReadStringC(outputDesc->filename);
-    out.sourceCode      = (&outputStream);
-    out.shaderVersion   = static_cast<Xsc::OutputShaderVersion>(outputDesc->shaderVersion);
+    out.filename            = ReadStringC(outputDesc->filename);
+    out.sourceCodeWriter    = [&outputCode](const char* data, size_t size) { outputCode.append(data, size); };
+    out.shaderVersion       = static_cast<Xsc::OutputShaderVersion>(outputDesc->shaderVersion);
 
     out.vertexSemantics.resize(outputDesc->vertexSemanticsCount);
     for (size_t i = 0; i < outputDesc->vertexSemanticsCount; ++i)
@@ -451,12 +493,15 @@ XSC_EXPORT int XscCompileShader(
 
     try
     {
-        result = Xsc::CompileShader(
-            in,
-            out,
-            logPrimaryRef,
-            (reflectionData != NULL ? &(g_compilerContext.reflection) : NULL)
-        );
+        /* Reset reflection of previous compilation, since the compiler appends to it */
+        context.reflection = Xsc::Reflection::ReflectionData();
+
+        auto reflectionDataRef = (reflectionData != NULL ? &(context.reflection) : NULL);
+
+        if (session != NULL)
+            result = session->session.CompileShader(in, out, logPrimaryRef, reflectionDataRef);
+        else
+            result = Xsc::CompileShader(in, out, logPrimaryRef, reflectionDataRef);
     }
     catch (const std::exception& e)
     {
@@ -465,13 +510,13 @@ XSC_EXPORT int XscCompileShader(
 
     if (result)
     {
-        /* Copy output code */
-        g_compilerContext.outputCode = outputStream.str();
-        *outputDesc->sourceCode = g_compilerContext.outputCode.c_str();
+        /* Take over output code */
+        context.outputCode.swap(outputCode);
+        *outputDesc->sourceCode = context.outputCode.c_str();
 
         /* Copy reflection */
         if (reflectionData != NULL)
-            CopyReflection(g_compilerContext.reflection, reflectionData);
+            CopyReflection(context.reflection, reflectionData, context);
     }
 
     if (log == XSC_DEFAULT_LOG)
@@ -480,6 +525,56 @@ XSC_EXPORT int XscCompileShader(
     return (result ? 1 : 0);
 }
 
+
+/*
+ * Public functions
+ */
+
+XSC_EXPORT int XscCompileShader(
+    const struct XscShaderInput*    inputDesc,
+    const struct XscShaderOutput*   outputDesc,
+    const struct XscLog*            log,
+    struct XscReflectionData*       reflectionData)
+{
+    return CompileShaderPrimary(NULL, inputDesc, outputDesc, log, reflectionData, g_compilerContext);
+}
+
+XSC_EXPORT struct XscCompilerSession* XscCreateCompilerSession()
+{
+    try
+    {
+        return new XscCompilerSession();
+    }
+    catch (const std::exception& e)
+    {
+        fprintf(stderr, "%s", e.what());
+    }
+    return NULL;
+}
+
+XSC_EXPORT void XscReleaseCompilerSession(struct XscCompilerSession* session)
+{
+    delete session;
+}
+
+XSC_EXPORT int XscCompileShaderWithSession(
+    struct XscCompilerSession*      session,
+    const struct XscShaderInput*    inputDesc,
+    const struct XscShaderOutput*   outputDesc,
+    const struct XscLog*            log,
+    struct XscReflectionData*       reflectionData)
+{
+    if (session == NULL)
+        return 0;
+    return CompileShaderPrimary(session, inputDesc, outputDesc, log, reflectionData, session->context);
+}
+
+XSC_EXPORT void XscClearCompilerSessionIncludeCache(struct XscCompilerSession* session)
+{
+    if (session != NULL)
+        session->session.ClearIncludeCache();
+}
+
 XSC_EXPORT void XscFilterToString(const enum XscFilter t, char* str, size_t maxSize)
 {
     WriteStringC(Xsc::ToString(static_cast<Xsc::Reflection::Filter>(t)), str, maxSize);
@@ -0,0 +1,615 @@
+/*
+ * XscTest_Benchmark.cpp
+ * 
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/Xsc.h>
+#include <Xsc/CompilerSession.h>
+#include "HLSLParser.h"
+#include "HLSLIntrinsics.h"
+#include "ASTCloner.h"
+#include "ASTSerializer.h"
+#include "HLSLAnalyzer.h"
+#include "GLSLGenerator.h"
+#include "HLSLScanner.h"
+#include "HLSLKeywords.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+#include <atomic>
+#include <new>
+#include <map>
+#include <vector>
+#include <cctype>
+#include <cstddef>
+
+
+using namespace Xsc;
+
+using Clock = std::chrono::high_resolution_clock;
+
+
+// Number of heap allocations of the entire process.
+static std::atomic<std::size_t> g_numHeapAllocations { 0 };
+
+void* operator new (std::size_t size)
+{
+    ++g_numHeapAllocations;
+    if (auto ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete (void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[] (void* ptr) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete (void* ptr, std::size_t /*size*/) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete[] (void* ptr, std::size_t /*size*/) noexcept
+{
+    ::operator delete(ptr);
+}
+
+
+#define PRINT_FUNC                                                  \
+    std::cout << std::endl;                                         \
+    std::cout << "~~~~~ " << __FUNCTION__ << " ~~~~~" << std::endl; \
+    std::cout << std::endl
+
+// Returns the elapsed time (in milliseconds) since the specified time point.
+static double ElapsedMillis(const Clock::time_point& startTime)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - startTime).count();
+}
+
+// Returns the pre-processed code of the specified HLSL file.
+static std::string PreProcessFile(const std::string& filename)
+{
+    std::stringstream processedCode;
+
+    ShaderInput inputDesc;
+    {
+        inputDesc.filename      = filename;
+        inputDesc.sourceCode    = std::make_shared<std::ifstream>(filename);
+    }
+    ShaderOutput outputDesc;
+    {
+        outputDesc.sourceCode               = &processedCode;
+        outputDesc.options.preprocessOnly   = true;
+    }
+    StdLog log;
+    if (!CompileShader(inputDesc, outputDesc, &log))
+    {
+        log.PrintAll();
+        throw std::runtime_error("failed to pre-process file: " + filename);
+    }
+
+    return processedCode.str();
+}
+
+static ProgramPtr ParseHLSL(const std::string& processedCode)
+{
+    HLSLParser parser;
+    return parser.ParseSource(
+        std::make_shared<SourceCode>(std::make_shared<std::stringstream>(processedCode)),
+        NameMangling(),
+        InputShaderVersion::HLSL5
+    );
+}
+
+void BenchmarkASTClone(const std::string& filename, int iterations)
+{
+    PRINT_FUNC;
+
+    HLSLIntrinsicAdept intrinsicAdept;
+
+    const auto processedCode = PreProcessFile(filename);
+
+    /* Measure re-parsing of the pre-processed code */
+    auto startTime = Clock::now();
+
+    ProgramPtr program;
+    for (int i = 0; i < iterations; ++i)
+        program = ParseHLSL(processedCode);
+
+    if (!program)
+        throw std::runtime_error("failed to parse file: " + filename);
+
+    const auto parseTime = ElapsedMillis(startTime);
+
+    /* Measure deep copy of the syntax tree */
+    startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        ASTCloner().CloneProgram(*program);
+
+    const auto cloneTime = ElapsedMillis(startTime);
+
+    std::cout << "file:     " << filename << " (" << iterations << " iterations)" << std::endl;
+    std::cout << "parsing:  " << (parseTime / iterations) << " ms" << std::endl;
+    std::cout << "cloning:  " << (cloneTime / iterations) << " ms" << std::endl;
+    std::cout << "speedup:  " << (parseTime / cloneTime) << "x" << std::endl;
+}
+
+static ShaderTarget ParseShaderTarget(const std::string& s)
+{
+    if (s == "vert") return ShaderTarget::VertexShader;
+    if (s == "tesc") return ShaderTarget::TessellationControlShader;
+    if (s == "tese") return ShaderTarget::TessellationEvaluationShader;
+    if (s == "geom") return ShaderTarget::GeometryShader;
+    if (s == "frag") return ShaderTarget::FragmentShader;
+    if (s == "comp") return ShaderTarget::ComputeShader;
+    throw std::invalid_argument("invalid shader target: " + s);
+}
+
+// Returns a syntax tree stress test with structures, buffers, textures, loops, and a chain of function calls.
+static std::string ASTStressSource(int numFunctions)
+{
+    std::string s =
+        "struct Light { float3 position; float3 color; float radius; };\n"
+        "cbuffer Settings : register(b0) { float4x4 wvpMatrix; Light lights[4]; float time; };\n"
+        "Texture2D colorMap : register(t0);\n"
+        "SamplerState linearSampler : register(s0);\n";
+
+    for (int i = 0; i < numFunctions; ++i)
+    {
+        const auto n = std::to_string(i);
+        s += "float3 Shade" + n + "(float3 normal, float2 texCoord, int index)\n{\n";
+        s += "    Light light = lights[index % 4];\n";
+        s += "    float3 dir = normalize(light.position - normal * " + n + ".5);\n";
+        s += "    float3 color = colorMap.Sample(linearSampler, texCoord).rgb;\n";
+        s += "    for (int j = 0; j < 4; ++j)\n        color += light.color * max(0.0, dot(normal, dir)) / (1.0 + j);\n";
+        if (i > 0)
+            s += "    color = lerp(color, Shade" + std::to_string(i - 1) + "(normal, texCoord * 0.5, index + 1), 0.25);\n";
+        s += "    return (index > 2 ? color * light.radius : saturate(color));\n}\n";
+    }
+
+    s += "float4 PS(float4 pos : SV_Position, float3 normal : NORMAL, float2 texCoord : TEXCOORD0) : SV_Target\n{\n";
+    s += "    return float4(Shade" + std::to_string(numFunctions - 1) + "(normalize(normal), texCoord, 0) * time, 1.0);\n}\n";
+
+    return s;
+}
+
+// Returns the GLSL code generated from the specified decorated syntax tree (without generator header, which contains a time stamp).
+static std::string GenerateGLSL(Program& program, const ShaderInput& inputDesc)
+{
+    std::stringstream outputCode;
+
+    ShaderOutput outputDesc;
+    {
+        outputDesc.sourceCode                       = &outputCode;
+        outputDesc.options.writeGeneratorHeader     = false;
+    }
+
+    GLSLGenerator generator(nullptr);
+    if (!generator.GenerateCode(program, inputDesc, outputDesc))
+        throw std::runtime_error("failed to generate GLSL code: " + inputDesc.filename);
+
+    return outputCode.str();
+}
+
+void BenchmarkASTSerialization(
+    const std::string&  name,
+    const std::string&  processedCode,
+    int                 iterations,
+    const ShaderTarget  target,
+    const std::string&  entryPoint)
+{
+    PRINT_FUNC;
+
+    HLSLIntrinsicAdept intrinsicAdept;
+
+    ShaderInput inputDesc;
+    {
+        inputDesc.filename      = name;
+        inputDesc.entryPoint    = entryPoint;
+        inputDesc.shaderTarget  = target;
+    }
+    ShaderOutput outputDesc;
+
+    /* Measure re-parsing and analysis of the pre-processed code, i.e. what a serialized syntax tree replaces */
+    auto startTime = Clock::now();
+
+    ProgramPtr program;
+    for (int i = 0; i < iterations; ++i)
+    {
+        program = ParseHLSL(processedCode);
+        if (!program || !HLSLAnalyzer().DecorateAST(*program, inputDesc, outputDesc))
+            throw std::runtime_error("failed to parse and analyze shader: " + name);
+    }
+
+    const auto parseTime = ElapsedMillis(startTime);
+
+    /* Measure saving of the decorated syntax tree, including all cross references of the analyzer */
+    ASTSerializer serializer;
+
+    startTime = Clock::now();
+
+    std::string data;
+    for (int i = 0; i < iterations; ++i)
+        data = serializer.Save(*program);
+
+    const auto saveTime = ElapsedMillis(startTime);
+    const auto numNodes = serializer.NumNodes();
+
+    /* Measure loading of the syntax tree */
+    startTime = Clock::now();
+
+    ProgramPtr loadedProgram;
+    for (int i = 0; i < iterations; ++i)
+        loadedProgram = serializer.Load(data);
+
+    const auto loadTime = ElapsedMillis(startTime);
+
+    /* Saving the loaded syntax tree must result in the same binary data */
+    if (!loadedProgram || serializer.Save(*loadedProgram) != data)
+        throw std::runtime_error("AST serialization mismatch: " + name);
+
+    /* Code generation from the loaded syntax tree must result in the same output as from the original syntax tree */
+    if (GenerateGLSL(*loadedProgram, inputDesc) != GenerateGLSL(*program, inputDesc))
+        throw std::runtime_error("GLSL output mismatch of loaded syntax tree: " + name);
+
+    std::cout << "source:   " << name << " (" << iterations << " iterations, " << numNodes << " nodes, " << data.size() << " bytes)" << std::endl;
+    std::cout << "parsing:  " << (parseTime / iterations) << " ms (including analysis)" << std::endl;
+    std::cout << "saving:   " << (saveTime / iterations) << " ms" << std::endl;
+    std::cout << "loading:  " << (loadTime / iterations) << " ms" << std::endl;
+    std::cout << "speedup:  " << (parseTime / loadTime) << "x" << std::endl;
+}
+
+void BenchmarkCompilerSession(const std::string& filename, int iterations, const ShaderTarget target, const std::string& entryPoint)
+{
+    PRINT_FUNC;
+
+    auto CompileFile = [&](CompilerSession* session)
+    {
+        std::stringstream outputCode;
+
+        ShaderInput inputDesc;
+        {
+            inputDesc.filename      = filename;
+            inputDesc.sourceCode    = std::make_shared<std::ifstream>(filename);
+            inputDesc.shaderTarget  = target;
+            inputDesc.entryPoint    = entryPoint;
+        }
+        ShaderOutput outputDesc;
+        {
+            outputDesc.sourceCode   = &outputCode;
+        }
+
+        auto result = (session ? session->CompileShader(inputDesc, outputDesc) : CompileShader(inputDesc, outputDesc));
+        if (!result)
+            throw std::runtime_error("failed to compile file: " + filename);
+    };
+
+    /* Measure compilation with a new compiler for each iteration */
+    auto startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(nullptr);
+
+    const auto singleTime = ElapsedMillis(startTime);
+
+    /* Measure compilation with a persistent compiler session */
+    startTime = Clock::now();
+
+    CompilerSession session;
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(&session);
+
+    const auto sessionTime = ElapsedMillis(startTime);
+
+    std::cout << "file:     " << filename << " (" << iterations << " iterations)" << std::endl;
+    std::cout << "single:   " << (singleTime / iterations) << " ms" << std::endl;
+    std::cout << "session:  " << (sessionTime / iterations) << " ms" << std::endl;
+    std::cout << "ratio:    " << (singleTime / sessionTime) << "x" << std::endl;
+}
+
+void BenchmarkShaderCache(const std::string& filename, int iterations, const ShaderTarget target, const std::string& entryPoint)
+{
+    PRINT_FUNC;
+
+    const std::string cacheDir = "XscTest_Benchmark.cache";
+
+    ShaderCache cache(cacheDir);
+    cache.Clear();
+
+    auto CompileFile = [&](ShaderCache* cache)
+    {
+        std::stringstream outputCode;
+
+        ShaderInput inputDesc;
+        {
+            inputDesc.filename      = filename;
+            inputDesc.sourceCode    = std::make_shared<std::ifstream>(filename);
+            inputDesc.shaderTarget  = target;
+            inputDesc.entryPoint    = entryPoint;
+            inputDesc.cache         = cache;
+        }
+        ShaderOutput outputDesc;
+        {
+            outputDesc.sourceCode   = &outputCode;
+        }
+
+        if (!CompileShader(inputDesc, outputDesc))
+            throw std::runtime_error("failed to compile file: " + filename);
+    };
+
+    /* Measure compilation without shader cache */
+    auto startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(nullptr);
+
+    const auto uncachedTime = ElapsedMillis(startTime);
+
+    /* Measure compilation with shader cache (only the first iteration is a cache miss) */
+    startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(&cache);
+
+    const auto cachedTime = ElapsedMillis(startTime);
+
+    const auto stats = cache.GetStatistics();
+
+    std::cout << "file:     " << filename << " (" << iterations << " iterations)" << std::endl;
+    std::cout << "uncached: " << (uncachedTime / iterations) << " ms" << std::endl;
+    std::cout << "cached:   " << (cachedTime / iterations) << " ms (" << stats.hits << " hits, " << stats.misses << " misses)" << std::endl;
+    std::cout << "speedup:  " << (uncachedTime / cachedTime) << "x" << std::endl;
+
+    cache.Clear();
+}
+
+void BenchmarkArenaAllocation(const std::string& filename, int iterations, const ShaderTarget target, const std::string& entryPoint)
+{
+    PRINT_FUNC;
+
+    auto CompileFile = [&](bool arenaAllocation)
+    {
+        std::stringstream outputCode;
+
+        ShaderInput inputDesc;
+        {
+            inputDesc.filename      = filename;
+            inputDesc.sourceCode    = std::make_shared<std::ifstream>(filename);
+            inputDesc.shaderTarget  = target;
+            inputDesc.entryPoint    = entryPoint;
+        }
+        ShaderOutput outputDesc;
+        {
+            outputDesc.sourceCode               = &outputCode;
+            outputDesc.options.arenaAllocation  = arenaAllocation;
+        }
+
+        if (!CompileShader(inputDesc, outputDesc))
+            throw std::runtime_error("failed to compile file: " + filename);
+    };
+
+    /* Measure compilation with separate heap allocations for each AST node */
+    auto numAllocs = g_numHeapAllocations.load();
+    auto startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(false);
+
+    const auto heapTime     = ElapsedMillis(startTime);
+    const auto heapAllocs   = g_numHeapAllocations.load() - numAllocs;
+
+    /* Measure compilation with a memory arena for all AST nodes */
+    numAllocs = g_numHeapAllocations.load();
+    startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        CompileFile(true);
+
+    const auto arenaTime    = ElapsedMillis(startTime);
+    const auto arenaAllocs  = g_numHeapAllocations.load() - numAllocs;
+
+    std::cout << "file:     " << filename << " (" << iterations << " iterations)" << std::endl;
+    std::cout << "heap:     " << (heapTime / iterations) << " ms (" << (heapAllocs / iterations) << " allocations)" << std::endl;
+    std::cout << "arena:    " << (arenaTime / iterations) << " ms (" << (arenaAllocs / iterations) << " allocations)" << std::endl;
+    std::cout << "speedup:  " << (heapTime / arenaTime) << "x" << std::endl;
+}
+
+void BenchmarkScanner(const std::string& filename, int iterations)
+{
+    PRINT_FUNC;
+
+    const auto processedCode = PreProcessFile(filename);
+
+    /* Collect all identifiers and keywords of the source file */
+    std::vector<std::string> idents;
+
+    HLSLScanner scanner(false);
+    scanner.ScanSource(std::make_shared<SourceCode>(processedCode.data(), processedCode.size()));
+
+    for (auto tkn = scanner.Next(); tkn->Type() != Token::Types::EndOfStream; tkn = scanner.Next())
+    {
+        const auto& spell = tkn->Spell();
+        if (!spell.empty() && (std::isalpha(static_cast<unsigned char>(spell.front())) || spell.front() == '_'))
+            idents.push_back(spell);
+    }
+
+    if (idents.empty())
+        throw std::runtime_error("no identifiers found in file: " + filename);
+
+    /* Measure keyword lookups with the previous ordered map */
+    const std::map<std::string, Token::Types> keywordMap { HLSLKeywords().begin(), HLSLKeywords().end() };
+
+    std::size_t numKeywords = 0;
+    auto startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (const auto& ident : idents)
+        {
+            if (keywordMap.find(ident) != keywordMap.end())
+                ++numKeywords;
+        }
+    }
+
+    const auto mapTime = ElapsedMillis(startTime);
+
+    /* Measure keyword lookups with the perfect hash map */
+    startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (const auto& ident : idents)
+        {
+            if (HLSLKeywords().find(ident) != HLSLKeywords().end())
+                ++numKeywords;
+        }
+    }
+
+    const auto hashTime = ElapsedMillis(startTime);
+
+    /* Measure scanning of the entire source file */
+    startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        HLSLScanner fileScanner(false);
+        fileScanner.ScanSource(std::make_shared<SourceCode>(processedCode.data(), processedCode.size()));
+        while (fileScanner.Next()->Type() != Token::Types::EndOfStream)
+            ;
+    }
+
+    const auto scanTime = ElapsedMillis(startTime);
+
+    auto IdentsPerSec = [&](double millis)
+    {
+        return static_cast<std::size_t>(static_cast<double>(idents.size() * iterations) / std::max(millis, 0.001) * 1000.0);
+    };
+
+    std::cout << "file:     " << filename << " (" << iterations << " iterations, " << idents.size() << " identifiers, " << (numKeywords / (iterations * 2)) << " keywords)" << std::endl;
+    std::cout << "map:      " << IdentsPerSec(mapTime) << " identifiers/sec (keyword lookup)" << std::endl;
+    std::cout << "hash:     " << IdentsPerSec(hashTime) << " identifiers/sec (keyword lookup)" << std::endl;
+    std::cout << "speedup:  " << (mapTime / hashTime) << "x" << std::endl;
+    std::cout << "scanner:  " << IdentsPerSec(scanTime) << " identifiers/sec (entire file)" << std::endl;
+}
+
+// Returns a macro stress test with 6 levels of nested function-like macros, token concatenation, stringizing, and variadic arguments.
+static std::string MacroStressSource(int numUsages)
+{
+    std::string s =
+        "#define ADD(a, b) ((a) + (b))\n"
+        "#define MUL(a, b) ((a) * (b))\n"
+        "#define CAT(a, b) a ## b\n"
+        "#define STR(x) #x\n"
+        "#define VEC(...) float4(__VA_ARGS__)\n"
+        "#define L1(x, y) ADD(MUL(x, y), CAT(x, _1))\n"
+        "#define L2(x, y) L1(ADD(x, y), L1(y, x))\n"
+        "#define L3(x, y) L2(L1(x, y), MUL(y, x))\n"
+        "#define L4(x, y) L3(x, L2(y, x))\n"
+        "#define L5(x, y) L4(L1(x, y), y)\n"
+        "#define L6(x, y) VEC(L5(x, y), L1(y, x), STR(x), CAT(y, _6))\n";
+
+    for (int i = 0; i < numUsages; ++i)
+    {
+        const auto n = std::to_string(i);
+        s += "float4 CAT(v, " + n + ") = L6(CAT(a, " + n + "), ADD(b, " + n + "));\n";
+    }
+
+    return s;
+}
+
+void BenchmarkMacroExpansion(int iterations)
+{
+    PRINT_FUNC;
+
+    const int numUsages = 100;
+    const auto sourceCode = MacroStressSource(numUsages);
+
+    auto PreProcessSource = [&]() -> std::size_t
+    {
+        std::stringstream processedCode;
+
+        ShaderInput inputDesc;
+        {
+            inputDesc.sourceCode = std::make_shared<std::stringstream>(sourceCode);
+        }
+        ShaderOutput outputDesc;
+        {
+            outputDesc.sourceCode               = &processedCode;
+            outputDesc.options.preprocessOnly   = true;
+        }
+
+        if (!CompileShader(inputDesc, outputDesc))
+            throw std::runtime_error("failed to pre-process macro stress test");
+
+        return processedCode.str().size();
+    };
+
+    /* Measure pre-processing of the macro stress test */
+    std::size_t outputSize = 0;
+
+    auto numAllocs = g_numHeapAllocations.load();
+    auto startTime = Clock::now();
+
+    for (int i = 0; i < iterations; ++i)
+        outputSize = PreProcessSource();
+
+    const auto expandTime   = ElapsedMillis(startTime);
+    const auto expandAllocs = g_numHeapAllocations.load() - numAllocs;
+
+    std::cout << "source:   " << numUsages << " macro usages, 6 nesting levels (" << iterations << " iterations, " << outputSize << " bytes output)" << std::endl;
+    std::cout << "time:     " << (expandTime / iterations) << " ms" << std::endl;
+    std::cout << "allocs:   " << (expandAllocs / iterations) << " allocations" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    std::cout << "XscTest_Benchmark" << std::endl;
+
+    /* Arguments: [FILE [ITERATIONS [TARGET ENTRY]]] */
+    const std::string   filename    = (argc > 1 ? argv[1] : "TessellationTest1.hlsl");
+    const int           iterations  = (argc > 2 ? std::max(1, std::atoi(argv[2])) : 100);
+    const std::string   target      = (argc > 3 ? argv[3] : "vert");
+    const std::string   entryPoint  = (argc > 4 ? argv[4] : "VS");
+
+    try
+    {
+        BenchmarkASTClone(filename, iterations);
+        BenchmarkASTSerialization(filename, PreProcessFile(filename), iterations, ParseShaderTarget(target), entryPoint);
+        BenchmarkASTSerialization("<AST stress test>", ASTStressSource(150), std::max(1, iterations / 10), ShaderTarget::FragmentShader, "PS");
+        BenchmarkCompilerSession(filename, iterations, ParseShaderTarget(target), entryPoint);
+        BenchmarkShaderCache(filename, iterations, ParseShaderTarget(target), entryPoint);
+        BenchmarkArenaAllocation(filename, iterations, ParseShaderTarget(target), entryPoint);
+        BenchmarkScanner(filename, iterations);
+        BenchmarkMacroExpansion(iterations);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -100,6 +100,185 @@ void TestCompile()
         puts("*** COMPILATION FAILED ***");
 }
 
+void TestCompileWithSession()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "PS";
+    in.shaderTarget = XscETargetFragmentShader;
+    in.sourceCode   =
+    (
+        "float4 PS(float4 color : COLOR) : SV_Target {\n"
+        "    return color * 0.5;\n"
+        "}\n"
+    );
+
+    out.filename    = "test.PS.frag";
+    out.sourceCode  = &outputCode;
+
+    // Compile shader several times with the same session
+    struct XscCompilerSession* session = XscCreateCompilerSession();
+
+    int i, successful = 0;
+    for (i = 0; i < 3; ++i)
+    {
+        if (XscCompileShaderWithSession(session, &in, &out, XSC_DEFAULT_LOG, NULL))
+            ++successful;
+    }
+
+    if (successful == 3)
+    {
+        puts("*** COMPILATION SUCCESSFUL ***\n");
+        if (outputCode != NULL)
+            puts(outputCode);
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+
+    // Output code is only valid as long as the session is alive
+    XscReleaseCompilerSession(session);
+}
+
+int TestRepeatedReflection()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code
+    in.filename     = "test.hlsl";
+    in.entryPoint   = "VS";
+    in.shaderTarget = XscETargetVertexShader;
+    in.sourceCode   =
+    (
+        "cbuffer Matrices {\n"
+        "    float4x4 wvpMatrix;\n"
+        "};\n"
+        "SamplerState linearSampler {\n"
+        "    Filter = MIN_MAG_MIP_LINEAR;\n"
+        "};\n"
+        "Texture2D<float3> tex : register(t2);\n"
+        "float4 VS(float3 pos : POSITION) : SV_Position {\n"
+        "    tex; // force generation of 'tex' resource in reflection\n"
+        "    return mul(wvpMatrix, float4(pos, 1));\n"
+        "}\n"
+    );
+
+    out.filename    = "test.VS.vert";
+    out.sourceCode  = &outputCode;
+
+    // Compile shader several times with and without session, reflection must not accumulate
+    struct XscCompilerSession* session = XscCreateCompilerSession();
+
+    struct XscReflectionData reflect, firstReflect;
+    memset(&firstReflect, 0, sizeof(firstReflect));
+
+    int i, successful = 0;
+    for (i = 0; i < 6; ++i)
+    {
+        memset(&reflect, 0, sizeof(reflect));
+
+        int result = 0;
+        if (i < 3)
+            result = XscCompileShaderWithSession(session, &in, &out, XSC_DEFAULT_LOG, &reflect);
+        else
+            result = XscCompileShader(&in, &out, XSC_DEFAULT_LOG, &reflect);
+
+        if (!result)
+            continue;
+
+        if (i == 0)
+            firstReflect = reflect;
+
+        if ( reflect.resourcesCount       == firstReflect.resourcesCount       &&
+             reflect.constantBufferCounts == firstReflect.constantBufferCounts &&
+             reflect.samplerStatesCount   == firstReflect.samplerStatesCount )
+        {
+            ++successful;
+        }
+        else
+        {
+            printf(
+                "reflection mismatch in compilation %d: %d resources, %d constant buffers, %d sampler states\n",
+                i + 1, (int)reflect.resourcesCount, (int)reflect.constantBufferCounts, (int)reflect.samplerStatesCount
+            );
+        }
+    }
+
+    XscReleaseCompilerSession(session);
+
+    if (successful == 6)
+    {
+        puts("*** REFLECTION SUCCESSFUL ***");
+        return 1;
+    }
+
+    puts("*** REFLECTION FAILED ***");
+    return 0;
+}
+
+void TestCompileWithMacros()
+{
+    PRINT_FUNC;
+
+    // Initialize structures
+    struct XscShaderInput in;
+    struct XscShaderOutput out;
+    XscInitialize(&in, &out);
+
+    const char* outputCode = NULL;
+
+    // Specify shader code and pre-defined macros
+    struct XscPredefinedMacro macros[2] =
+    {
+        { "SCALE", "2.0" },
+        { "USE_COLOR", NULL },
+    };
+
+    in.filename                 = "test.hlsl";
+    in.entryPoint               = "PS";
+    in.shaderTarget             = XscETargetFragmentShader;
+    in.predefinedMacros         = macros;
+    in.predefinedMacrosCount    = 2;
+    in.sourceCode               =
+    (
+        "float4 PS(float4 color : COLOR) : SV_Target {\n"
+        "#ifdef USE_COLOR\n"
+        "    return color * SCALE;\n"
+        "#else\n"
+        "    return SCALE;\n"
+        "#endif\n"
+        "}\n"
+    );
+
+    out.filename    = "test.PS.frag";
+    out.sourceCode  = &outputCode;
+
+    // Compile shader
+    if (XscCompileShader(&in, &out, XSC_DEFAULT_LOG, NULL))
+    {
+        puts("*** COMPILATION SUCCESSFUL ***\n");
+        if (outputCode != NULL)
+            puts(outputCode);
+    }
+    else
+        puts("*** COMPILATION FAILED ***");
+}
+
 int main()
 {
     puts("XscTest1");
@@ -107,6 +286,11 @@ int main()
     TestGLSLExtensions();
     TestShaderTarget();
     TestCompile();
+    TestCompileWithSession();
+    TestCompileWithMacros();
+
+    if (!TestRepeatedReflection())
+        return 1;
 
     return 0;
 }
@@ -0,0 +1,276 @@
+/*
+ * XscTest_Parallel.cpp
+ *
+ * This file is part of the XShaderCompiler project (Copyright (c) 2014-2018 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <Xsc/Xsc.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+
+
+using namespace Xsc;
+
+
+// Log which keeps all reports as plain text.
+class TextLog : public Log
+{
+
+    public:
+
+        void SubmitReport(const Report& report) override
+        {
+            text += report.Context();
+            text += report.Message();
+            text += '\n';
+        }
+
+        std::string text;
+
+};
+
+// Compile job of the test corpus (command line of a presetting).
+struct TestCase
+{
+    std::string         filename;
+    ShaderTarget        shaderTarget        = ShaderTarget::Undefined;
+    std::string         entryPoint;
+    std::string         secondaryEntryPoint;
+    OutputShaderVersion shaderVersion       = OutputShaderVersion::GLSL;
+    bool                optimize            = false;
+    bool                preprocessOnly      = false;
+};
+
+// Result of a single compile job.
+struct TestResult
+{
+    bool        result = false;
+    std::string output;
+    std::string log;
+    std::string reflection;
+};
+
+static ShaderTarget ParseShaderTarget(const std::string& s)
+{
+    if (s == "vert") return ShaderTarget::VertexShader;
+    if (s == "tesc") return ShaderTarget::TessellationControlShader;
+    if (s == "tese") return ShaderTarget::TessellationEvaluationShader;
+    if (s == "geom") return ShaderTarget::GeometryShader;
+    if (s == "frag") return ShaderTarget::FragmentShader;
+    if (s == "comp") return ShaderTarget::ComputeShader;
+    throw std::invalid_argument("invalid shader target: " + s);
+}
+
+static OutputShaderVersion ParseOutputShaderVersion(const std::string& s)
+{
+    static const std::map<std::string, OutputShaderVersion> versions
+    {
+        { "GLSL",    OutputShaderVersion::GLSL    },
+        { "GLSL120", OutputShaderVersion::GLSL120 },
+        { "GLSL130", OutputShaderVersion::GLSL130 },
+        { "GLSL140", OutputShaderVersion::GLSL140 },
+        { "GLSL150", OutputShaderVersion::GLSL150 },
+        { "GLSL330", OutputShaderVersion::GLSL330 },
+        { "GLSL450", OutputShaderVersion::GLSL450 },
+        { "ESSL",    OutputShaderVersion::ESSL    },
+        { "VKSL",    OutputShaderVersion::VKSL    },
+    };
+    auto it = versions.find(s);
+    if (it == versions.end())
+        throw std::invalid_argument("invalid output shader version: " + s);
+    return it->second;
+}
+
+// Reads all test cases from the presetting file (only a subset of the shell arguments is supported).
+static std::vector<TestCase> ReadTestCases(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if (!file.good())
+        throw std::runtime_error("failed to read file: " + filename);
+
+    std::vector<TestCase> testCases;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        /* Skip comments, titles, and empty lines */
+        if (line.empty() || line[0] == '#' || line[0] == '[')
+            continue;
+
+        std::istringstream args(line);
+        std::vector<std::string> argList;
+        for (std::string arg; args >> arg;)
+            argList.push_back(arg);
+
+        TestCase testCase;
+
+        for (std::size_t i = 0; i < argList.size(); ++i)
+        {
+            const auto& arg = argList[i];
+            auto NextArg = [&]() -> const std::string&
+            {
+                if (i + 1 >= argList.size())
+                    throw std::invalid_argument("missing value after argument: " + arg);
+                return argList[++i];
+            };
+
+            if (arg == "-T")
+                testCase.shaderTarget = ParseShaderTarget(NextArg());
+            else if (arg == "-E")
+                testCase.entryPoint = NextArg();
+            else if (arg == "-E2")
+                testCase.secondaryEntryPoint = NextArg();
+            else if (arg == "-Vout")
+                testCase.shaderVersion = ParseOutputShaderVersion(NextArg());
+            else if (arg == "-O")
+                testCase.optimize = true;
+            else if (arg == "-PP")
+                testCase.preprocessOnly = true;
+            else if (arg == "-o" || arg == "-Vin" || arg == "-Pin" || arg == "-Pout" || arg == "--explicit-bind" || arg == "--comments" || arg == "-EB")
+                NextArg();
+            else if (arg[0] != '-')
+                testCase.filename = arg;
+        }
+
+        /* Skip presettings with missing files */
+        if (!testCase.filename.empty() && std::ifstream(testCase.filename).good())
+            testCases.push_back(testCase);
+    }
+
+    return testCases;
+}
+
+// Compiles all test cases on the specified number of threads (0 for serial compilation), optionally with a shared include handler.
+static std::vector<TestResult> CompileTestCases(const std::vector<TestCase>& testCases, unsigned int numThreads, IncludeHandler* includeHandler = nullptr)
+{
+    const auto numJobs = testCases.size();
+
+    std::vector<std::stringstream>          outputs(numJobs);
+    std::vector<TextLog>                    logs(numJobs);
+    std::vector<Reflection::ReflectionData> reflections(numJobs);
+    std::vector<ShaderCompileJob>           jobs(numJobs);
+
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        const auto& testCase = testCases[i];
+        auto& job = jobs[i];
+
+        job.inputDesc.filename              = testCase.filename;
+        job.inputDesc.sourceCode            = std::make_shared<std::ifstream>(testCase.filename);
+        job.inputDesc.shaderTarget          = testCase.shaderTarget;
+        job.inputDesc.entryPoint            = testCase.entryPoint;
+        job.inputDesc.secondaryEntryPoint   = testCase.secondaryEntryPoint;
+        job.inputDesc.includeHandler        = includeHandler;
+
+        job.outputDesc.sourceCode               = &outputs[i];
+        job.outputDesc.shaderVersion            = testCase.shaderVersion;
+        job.outputDesc.options.optimize         = testCase.optimize;
+        job.outputDesc.options.preprocessOnly   = testCase.preprocessOnly;
+
+        /* Omit generator header, which contains the current time */
+        job.outputDesc.options.writeGeneratorHeader = false;
+
+        job.log             = &logs[i];
+        job.reflectionData  = &reflections[i];
+    }
+
+    /* Compile all jobs either serially or in parallel */
+    std::vector<bool> jobResults(numJobs, false);
+
+    if (numThreads > 0)
+        CompileShadersParallel(jobs, numThreads, &jobResults);
+    else
+    {
+        for (std::size_t i = 0; i < numJobs; ++i)
+            jobResults[i] = CompileShader(jobs[i].inputDesc, jobs[i].outputDesc, jobs[i].log, jobs[i].reflectionData);
+    }
+
+    /* Gather results */
+    std::vector<TestResult> results(numJobs);
+
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        std::stringstream reflection;
+        PrintReflection(reflection, reflections[i]);
+
+        results[i].result       = jobResults[i];
+        results[i].output       = outputs[i].str();
+        results[i].log          = logs[i].text;
+        results[i].reflection   = reflection.str();
+    }
+
+    return results;
+}
+
+int main(int argc, char* argv[])
+{
+    std::cout << "XscTest_Parallel" << std::endl;
+
+    /* Arguments: [THREADS [ROUNDS [PRESETTING]]] */
+    const unsigned int  numThreads  = (argc > 1 ? static_cast<unsigned int>(std::max(1, std::atoi(argv[1]))) : 4u);
+    const int           numRounds   = (argc > 2 ? std::max(1, std::atoi(argv[2])) : 4);
+    const std::string   presetting  = (argc > 3 ? argv[3] : "presetting.txt");
+
+    try
+    {
+        const auto testCases = ReadTestCases(presetting);
+
+        /* Compile all test cases serially as reference */
+        const auto serialResults = CompileTestCases(testCases, 0);
+
+        std::cout << "compiled " << testCases.size() << " test cases serially" << std::endl;
+
+        /* Compile all test cases in parallel several times, and compare against the serial results */
+        int numMismatches = 0;
+
+        CachingIncludeHandler includeHandler;
+
+        for (int round = 0; round < numRounds; ++round)
+        {
+            /* Share the caching include handler between all threads in every other round */
+            const auto parallelResults = CompileTestCases(testCases, numThreads, (round % 2 == 1 ? &includeHandler : nullptr));
+
+            for (std::size_t i = 0; i < testCases.size(); ++i)
+            {
+                const auto& lhs = serialResults[i];
+                const auto& rhs = parallelResults[i];
+
+                if (lhs.result != rhs.result || lhs.output != rhs.output || lhs.log != rhs.log || lhs.reflection != rhs.reflection)
+                {
+                    std::cerr << "mismatch in round " << (round + 1) << ": " << testCases[i].filename << " (" << testCases[i].entryPoint << ")" << std::endl;
+                    ++numMismatches;
+                }
+            }
+
+            std::cout << "round " << (round + 1) << " on " << numThreads << " threads done" << std::endl;
+        }
+
+        if (numMismatches > 0)
+        {
+            std::cerr << numMismatches << " mismatch(es) between serial and parallel compilation" << std::endl;
+            return 1;
+        }
+
+        std::cout << "parallel results match serial results" << std::endl;
+        std::cout << "include cache: " << includeHandler.NumCacheHits() << " hits, " << includeHandler.NumCacheMisses() << " misses" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================